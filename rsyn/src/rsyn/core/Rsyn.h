@@ -24,6 +24,8 @@
 #include <vector>
 #include <bitset>
 #include <memory>
+#include <mutex>
+#include <atomic>
 #include <string>
 #include <sstream>
 #include <limits>
@@ -33,11 +35,15 @@
 #include <stdexcept>
 
 #include <rsyn/core/infra/List.h>
+#include <rsyn/core/infra/ChunkedStorage.h>
+#include <rsyn/core/infra/NameTable.h>
+#include <rsyn/core/infra/VisitationMarker.h>
 #include <rsyn/core/infra/RangeBasedLoop.h>
 #include <rsyn/core/infra/Exception.h>
 
 #include <rsyn/util/Proxy.h>
 #include <rsyn/util/TristateFlag.h>
+#include <rsyn/util/MemoryReport.h>
 
 #define RSYN_KERNEL
 #define RSYN_LIST_CHUNCK_SIZE 1000
@@ -83,6 +89,7 @@ class AttributeInitializer;
 template<typename DefaultValueType> class AttributeInitializerWithDefaultValue;
 
 class Observer;
+struct NetlistChanges;
 
 template<class Object, class Reference, unsigned int CHUNK_SIZE> class GenericListCollection;
 template<class Reference, unsigned int CHUNK_SIZE> class GenericReferenceListCollection;
@@ -229,6 +236,8 @@ enum EventType {
 	EVENT_POST_CELL_REMAP,
 	EVENT_POST_PIN_CONNECT,
 	EVENT_PRE_PIN_DISCONNECT,
+	EVENT_POST_DESIGN_LOAD,
+	EVENT_POST_TRANSACTION_COMMIT,
 
 	NUM_EVENTS
 }; // end enum
@@ -336,6 +345,9 @@ public:
 #include "rsyn/core/obj/decl/LibraryModule.h"
 #include "rsyn/core/obj/decl/Design.h"
 
+// Transactions
+#include "rsyn/core/infra/NetlistChanges.h"
+
 // Object's Data
 #include "rsyn/core/obj/data/Object.h"
 #include "rsyn/core/obj/data/Net.h"
@@ -353,6 +365,7 @@ public:
 
 // Infra
 #include "rsyn/core/infra/Attribute.h"
+#include "rsyn/core/infra/AttributeFork.h"
 #include "rsyn/core/infra/Observer.h"
 
 // Object's Implementations
@@ -16,7 +16,7 @@
 #ifndef RSYN_ATTRIBUTE_H
 #define RSYN_ATTRIBUTE_H
 
-#include <deque>
+#include <rsyn/core/infra/ChunkedStorage.h>
 
 namespace Rsyn {
 
@@ -72,6 +72,12 @@ public:
 
 template<typename _Object, typename _ObjectReference, typename _ObjectExtension>
 class AttributeBase {
+template<typename RsynObject, typename RsynObjectExtension> friend class AttributeFork;
+public:
+
+	//! @brief Number of objects per data chunk.
+	static const unsigned int CHUNK_SIZE = List<_Object>::CHUNK_SIZE;
+
 private:
 	// [TODO] Make design and list const.
 	
@@ -79,10 +85,13 @@ private:
 	List<_Object> *clsListPtr;
 	_ObjectExtension clsDefaultValue;
 	
-	typename List<_Object>::CreateElementCallbackHandler clsHandlerOnCreate;
+	typename List<_Object>::GrowthCallbackHandler clsHandlerOnGrowth;
 	typename List<_Object>::DestructorCallbackHandler clsListDestructorCallbackHandler;
 	
-	std::deque<_ObjectExtension> clsData;
+	// Data is stored in chunks matching the ones of the object list so that
+	// the extension of a chunk of objects is contiguous in memory.
+	typedef ChunkedStorage<_ObjectExtension, CHUNK_SIZE> Storage;
+	Storage clsData;
 	
 	void accommodate(const Index index) {
 		if (index >= clsData.size()) {
@@ -93,8 +102,9 @@ private:
 protected:
 	
 	void setupCallbacks() {
-		clsHandlerOnCreate = clsListPtr->addCreateCallback([&](const int index) {
-			accommodate(clsListPtr->largestId());
+		// Storage only needs to follow the list when it starts a new chunk.
+		clsHandlerOnGrowth = clsListPtr->addGrowthCallback([&](const int capacity) {
+			accommodate(capacity - 1);
 		}); // end method
 		
 		clsListDestructorCallbackHandler = clsListPtr->addDestructorEventCallback([&]() {
@@ -107,7 +117,7 @@ protected:
 		clsDesign = design;
 		clsListPtr = &list;
 		clsDefaultValue = defaultValue;
-		accommodate(clsListPtr->largestId());
+		accommodate(std::max(clsListPtr->largestId(), clsListPtr->getUsedCapacity() - 1));
 		setupCallbacks();
 	} // end method		
 	
@@ -148,18 +158,35 @@ public:
 		} // end if
 		
 		if (clsListPtr) {
-			clsListPtr->deleteCreateCallback(clsHandlerOnCreate);
+			clsListPtr->deleteGrowthCallback(clsHandlerOnGrowth);
 			clsListPtr->deleteDestructorCallback(clsListDestructorCallbackHandler);
 			clsListPtr = nullptr;
 		} // end if
 
 		clsData.clear();
-		clsData.shrink_to_fit();
 	} // end method	
 
 	inline _ObjectExtension &operator[](_ObjectReference obj) { return clsData[clsDesign.getId(obj)]; }
 	inline const _ObjectExtension &operator[](_ObjectReference obj) const { return clsData[clsDesign.getId(obj)]; }
 
+	//! @brief Returns the number of data chunks. The i-th chunk stores the
+	//!        data of the objects in the i-th chunk of the object list.
+	int getNumChunks() const { return clsData.getNumChunks(); }
+
+	//! @brief Returns the data of the objects in a chunk as a contiguous span.
+	//!        The span is indexed by object id minus span.getFirstIndex() and
+	//!        also includes entries of removed objects.
+	ChunkSpan<_ObjectExtension> getChunk(const int chunk) { return clsData.getChunk(chunk); }
+	ChunkSpan<const _ObjectExtension> getChunk(const int chunk) const { return clsData.getChunk(chunk); }
+
+	//! @brief Returns the number of bytes allocated by this attribute. Memory
+	//!        owned by the objects stored in the attribute is not included.
+	std::size_t getMemoryUsage() const { return clsData.getMemoryUsage(); }
+
+	//! @brief Returns all data chunks.
+	std::vector<ChunkSpan<_ObjectExtension>> allChunks() { return clsData.allChunks(); }
+	std::vector<ChunkSpan<const _ObjectExtension>> allChunks() const { return clsData.allChunks(); }
+
 }; // end class	
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,172 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_ATTRIBUTE_FORK_H
+#define RSYN_ATTRIBUTE_FORK_H
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+namespace Rsyn {
+
+//! @brief A copy-on-write view of an attribute. The fork shares the data
+//!        of the parent attribute until it is written, at which point the
+//!        entry is copied into a chunk owned by the fork. Changes are only
+//!        visible in the fork until commit() is called.
+//! @details Forks are meant to evaluate independent trials (e.g. different
+//!          placements or sizing of a region) in parallel and keep the best
+//!          one. Memory overhead is proportional to the number of chunks
+//!          modified by the trial.
+//! @note    Different forks can be used concurrently in different threads as
+//!          long as the parent attribute is not modified meanwhile. Only one
+//!          fork should be committed at a time.
+//! @note    Non-const access is considered a write, so prefer read() when the
+//!          data is not going to be modified.
+//! @note    commit() copies raw data back to the parent and does not notify
+//!          anyone. Forks of service state should be wrapped by the service,
+//!          which then commits through its own update methods (e.g.
+//!          PlacementFork).
+//! @note    Only attribute layers and the cell placement (PlacementFork) can
+//!          be forked. There is no fork of the Design (netlist changes in a
+//!          trial must go through a Sandbox) nor of the timing state, which
+//!          is updated by the timer itself (see SandboxTimer and
+//!          SandboxTrials to time trials in parallel).
+template<typename RsynObject, typename RsynObjectExtension>
+class AttributeFork {
+public:
+
+	AttributeFork() {}
+
+	AttributeFork(Attribute<RsynObject, RsynObjectExtension> parent) :
+		clsParent(parent) {}
+
+	//! @brief Returns the value of an object in this fork without copying it.
+	const RsynObjectExtension &read(RsynObject obj) const;
+
+	const RsynObjectExtension &operator[](RsynObject obj) const { return read(obj); }
+
+	//! @brief Returns the value of an object in this fork for writing. The
+	//!        value is copied from the parent on first write.
+	RsynObjectExtension &operator[](RsynObject obj);
+
+	//! @brief Writes the modified chunks back to the parent attribute and
+	//!        releases them. The fork remains valid and now shares all chunks
+	//!        with the parent again.
+	//! @warning The parent is written directly, bypassing any bookkeeping done
+	//!          by the owner of the attribute.
+	void commit();
+
+	//! @brief Discards all changes made in this fork.
+	void discard() { clsChunks.clear(); clsNumModifiedChunks = 0; }
+
+	//! @brief Returns the number of chunks allocated (modified) by this fork.
+	int getNumModifiedChunks() const { return clsNumModifiedChunks; }
+
+	//! @brief Returns the parent attribute.
+	Attribute<RsynObject, RsynObjectExtension> getParent() const { return clsParent; }
+
+private:
+
+	// A chunk written by the fork. Entries are copied from the parent on their
+	// first write, so entries of objects created in the parent after the
+	// chunk was allocated are still read from the parent.
+	struct Chunk {
+		std::unique_ptr<RsynObjectExtension[]> elements;
+		std::vector<bool> written;
+	}; // end struct
+
+	Attribute<RsynObject, RsynObjectExtension> clsParent;
+	std::vector<Chunk> clsChunks;
+	int clsNumModifiedChunks = 0;
+
+	static const unsigned int CHUNK_SIZE =
+			AttributeImplementation<RsynObject, RsynObjectExtension>::CHUNK_SIZE;
+
+	Index getId(RsynObject obj) const { return clsParent->clsDesign.getId(obj); }
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+template<typename RsynObject, typename RsynObjectExtension>
+inline
+const RsynObjectExtension &
+AttributeFork<RsynObject, RsynObjectExtension>::read(RsynObject obj) const {
+	const Index id = getId(obj);
+	const Index chunk = id / CHUNK_SIZE;
+	const Index offset = id % CHUNK_SIZE;
+	if (chunk < clsChunks.size() && clsChunks[chunk].elements && clsChunks[chunk].written[offset]) {
+		return clsChunks[chunk].elements[offset];
+	} else {
+		const auto &parent = *clsParent;
+		if (id >= parent.clsData.size()) {
+			throw Exception("Object is not stored in the parent attribute.");
+		} // end if
+		return parent.clsData[id];
+	} // end else
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename RsynObject, typename RsynObjectExtension>
+inline
+RsynObjectExtension &
+AttributeFork<RsynObject, RsynObjectExtension>::operator[](RsynObject obj) {
+	const Index id = getId(obj);
+	const Index chunk = id / CHUNK_SIZE;
+	const Index offset = id % CHUNK_SIZE;
+	if (chunk >= clsChunks.size())
+		clsChunks.resize(chunk + 1);
+
+	Chunk &forked = clsChunks[chunk];
+	if (!forked.elements) {
+		forked.elements.reset(new RsynObjectExtension[CHUNK_SIZE]);
+		forked.written.assign(CHUNK_SIZE, false);
+		clsNumModifiedChunks++;
+	} // end if
+
+	if (!forked.written[offset]) {
+		const auto &parent = *clsParent;
+		if (id >= parent.clsData.size()) {
+			throw Exception("Object is not stored in the parent attribute.");
+		} // end if
+		forked.elements[offset] = parent.clsData[id];
+		forked.written[offset] = true;
+	} // end if
+	return forked.elements[offset];
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename RsynObject, typename RsynObjectExtension>
+inline
+void
+AttributeFork<RsynObject, RsynObjectExtension>::commit() {
+	for (Index chunk = 0; chunk < clsChunks.size(); chunk++) {
+		const Chunk &forked = clsChunks[chunk];
+		if (!forked.elements)
+			continue;
+		const ChunkSpan<RsynObjectExtension> span = clsParent->getChunk(chunk);
+		for (Index offset = 0; offset < CHUNK_SIZE; offset++) {
+			if (forked.written[offset])
+				span[offset] = forked.elements[offset];
+		} // end for
+	} // end for
+	discard();
+} // end method
+
+} // end namespace
+
+#endif /* RSYN_ATTRIBUTE_FORK_H */
@@ -0,0 +1,224 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_CHUNKED_STORAGE_H
+#define RSYN_CHUNKED_STORAGE_H
+
+#include <vector>
+#include <algorithm>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+namespace Rsyn {
+
+//! @brief A contiguous view of the elements stored in a chunk.
+template<typename T>
+class ChunkSpan {
+public:
+	ChunkSpan() : clsBegin(nullptr), clsEnd(nullptr), clsFirstIndex(0) {}
+	ChunkSpan(T *begin, T *end, const std::size_t firstIndex) :
+		clsBegin(begin), clsEnd(end), clsFirstIndex(firstIndex) {}
+
+	T *begin() const { return clsBegin; }
+	T *end() const { return clsEnd; }
+	T *data() const { return clsBegin; }
+	T &operator[](const std::size_t i) const { return clsBegin[i]; }
+
+	std::size_t size() const { return clsEnd - clsBegin; }
+	bool empty() const { return clsBegin == clsEnd; }
+
+	//! @brief Returns the index (id) of the first element in this chunk.
+	std::size_t getFirstIndex() const { return clsFirstIndex; }
+
+private:
+	T *clsBegin;
+	T *clsEnd;
+	std::size_t clsFirstIndex;
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+//! @brief Stores elements in fixed size chunks of contiguous and cache line
+//!        aligned memory. Used by attributes so that their chunks line up with
+//!        the chunks of the List storing the objects they extend.
+//! @note  Growing the storage never moves existing elements, so references
+//!        remain valid as in std::deque.
+template<typename T, unsigned int CHUNK_SIZE>
+class ChunkedStorage {
+public:
+
+	static const std::size_t ALIGNMENT = 64;
+
+	ChunkedStorage() : clsSize(0) {}
+	ChunkedStorage(const ChunkedStorage<T, CHUNK_SIZE> &other) : clsSize(0) { operator=(other); }
+	~ChunkedStorage() { clear(); }
+
+	ChunkedStorage<T, CHUNK_SIZE> &operator=(const ChunkedStorage<T, CHUNK_SIZE> &other);
+
+	//! @brief Grows the storage so that it holds at least size elements. New
+	//!        elements are initialized with value. Never shrinks.
+	void resize(const std::size_t size, const T &value);
+
+	//! @brief Destroys all elements and releases memory.
+	void clear();
+
+	std::size_t size() const { return clsSize; }
+	bool empty() const { return clsSize == 0; }
+
+	//! @brief Returns the number of bytes allocated by this storage.
+	std::size_t getMemoryUsage() const {
+		return clsMemory.size() * (CHUNK_SIZE * sizeof(T) + ALIGNMENT) +
+				clsChunks.capacity() * sizeof(T *) +
+				clsMemory.capacity() * sizeof(void *);
+	} // end method
+
+	T &operator[](const std::size_t index) {
+		return clsChunks[index / CHUNK_SIZE][index % CHUNK_SIZE];
+	} // end method
+
+	const T &operator[](const std::size_t index) const {
+		return clsChunks[index / CHUNK_SIZE][index % CHUNK_SIZE];
+	} // end method
+
+	//! @brief Returns the number of chunks.
+	int getNumChunks() const { return (int) clsChunks.size(); }
+
+	//! @brief Returns the elements of a chunk. The last chunk is clamped to
+	//!        the storage size.
+	ChunkSpan<T> getChunk(const int chunk) {
+		const std::size_t first = chunk * (std::size_t) CHUNK_SIZE;
+		const std::size_t last = std::min(first + CHUNK_SIZE, clsSize);
+		return ChunkSpan<T>(clsChunks[chunk], clsChunks[chunk] + (last - first), first);
+	} // end method
+
+	ChunkSpan<const T> getChunk(const int chunk) const {
+		const std::size_t first = chunk * (std::size_t) CHUNK_SIZE;
+		const std::size_t last = std::min(first + CHUNK_SIZE, clsSize);
+		return ChunkSpan<const T>(clsChunks[chunk], clsChunks[chunk] + (last - first), first);
+	} // end method
+
+	//! @brief Returns all chunks. Useful to stream over (or split among
+	//!        threads) all elements.
+	std::vector<ChunkSpan<T>> allChunks() {
+		std::vector<ChunkSpan<T>> chunks;
+		chunks.reserve(clsChunks.size());
+		for (int i = 0; i < getNumChunks(); i++)
+			chunks.push_back(getChunk(i));
+		return chunks;
+	} // end method
+
+	std::vector<ChunkSpan<const T>> allChunks() const {
+		std::vector<ChunkSpan<const T>> chunks;
+		chunks.reserve(clsChunks.size());
+		for (int i = 0; i < getNumChunks(); i++)
+			chunks.push_back(getChunk(i));
+		return chunks;
+	} // end method
+
+private:
+
+	std::vector<T *> clsChunks; // aligned pointers
+	std::vector<void *> clsMemory; // pointers returned by the allocator
+	std::size_t clsSize;
+
+	T *allocateChunk();
+	void addChunk(const T &value);
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+template<typename T, unsigned int CHUNK_SIZE>
+inline T *ChunkedStorage<T, CHUNK_SIZE>::allocateChunk() {
+	void *memory = ::operator new(CHUNK_SIZE * sizeof(T) + ALIGNMENT);
+	const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory);
+	const std::uintptr_t aligned = (address + ALIGNMENT - 1) & ~(std::uintptr_t) (ALIGNMENT - 1);
+	T *elements = reinterpret_cast<T *>(aligned);
+
+	clsMemory.push_back(memory);
+	clsChunks.push_back(elements);
+	return elements;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename T, unsigned int CHUNK_SIZE>
+inline void ChunkedStorage<T, CHUNK_SIZE>::addChunk(const T &value) {
+	// Elements are constructed for the whole chunk so that it can be destroyed
+	// uniformly.
+	T *elements = allocateChunk();
+	for (unsigned int i = 0; i < CHUNK_SIZE; i++) {
+		new (&elements[i]) T(value);
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename T, unsigned int CHUNK_SIZE>
+inline void ChunkedStorage<T, CHUNK_SIZE>::resize(const std::size_t size, const T &value) {
+	if (size <= clsSize)
+		return;
+
+	// Initialize the unused tail of the last chunk.
+	if (!clsChunks.empty()) {
+		const std::size_t last = std::min(size, clsChunks.size() * CHUNK_SIZE);
+		for (std::size_t i = clsSize; i < last; i++)
+			operator[](i) = value;
+	} // end if
+
+	while (clsChunks.size() * CHUNK_SIZE < size)
+		addChunk(value);
+
+	clsSize = size;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename T, unsigned int CHUNK_SIZE>
+inline void ChunkedStorage<T, CHUNK_SIZE>::clear() {
+	for (std::size_t c = 0; c < clsChunks.size(); c++) {
+		T *elements = clsChunks[c];
+		for (unsigned int i = 0; i < CHUNK_SIZE; i++) {
+			elements[i].~T();
+		} // end for
+		::operator delete(clsMemory[c]);
+	} // end for
+	clsChunks.clear();
+	clsMemory.clear();
+	clsSize = 0;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename T, unsigned int CHUNK_SIZE>
+inline ChunkedStorage<T, CHUNK_SIZE> &
+ChunkedStorage<T, CHUNK_SIZE>::operator=(const ChunkedStorage<T, CHUNK_SIZE> &other) {
+	if (this == &other)
+		return *this;
+
+	clear();
+	for (std::size_t c = 0; c < other.clsChunks.size(); c++) {
+		T *elements = allocateChunk();
+		for (unsigned int i = 0; i < CHUNK_SIZE; i++) {
+			new (&elements[i]) T(other.clsChunks[c][i]);
+		} // end for
+	} // end for
+	clsSize = other.clsSize;
+	return *this;
+} // end method
+
+} // end namespace
+
+#endif /* RSYN_CHUNKED_STORAGE_H */
@@ -17,6 +17,7 @@
 #define RSYN_LIST_H
 
 #include <cmath>
+#include <algorithm>
 #include <deque>
 #include <list>
 #include <vector>
@@ -77,6 +78,12 @@ public:
 template<typename T, unsigned int DEFAULT_CHUNK_SIZE> 
 struct Chunk {		
 	Element<T> elements[DEFAULT_CHUNK_SIZE];
+
+	// Number of non-deleted elements in this chunk. Used to skip empty chunks
+	// during iteration.
+	int numElements;
+
+	Chunk() : numElements(0) {}
 }; // end struct
 
 //--------------------------------------------------------------------------
@@ -106,10 +113,14 @@ public:
 	typedef std::function<void(const int index)> CreateElementCallback;
 	typedef std::function<void(const int index)> RemoveElementCallback;
 	typedef std::function<void()> DestructorCallback;
+	typedef std::function<void(const int capacity)> GrowthCallback;
 	
 	typedef std::list<CreateElementCallback>::iterator CreateElementCallbackHandler;
 	typedef std::list<RemoveElementCallback>::iterator RemoveElementCallbackHandler;
 	typedef std::list<DestructorCallback>::iterator DestructorCallbackHandler;
+	typedef std::list<GrowthCallback>::iterator GrowthCallbackHandler;
+
+	static const unsigned int CHUNK_SIZE = DEFAULT_CHUNK_SIZE;
 	
 private:	
 	// Iterator validity (std::deque)
@@ -122,10 +133,14 @@ private:
 	// were referring to before.
 	
 	std::deque<Chunk<T, DEFAULT_CHUNK_SIZE>> chunks;
-	std::list<int> available;
+
+	// Ids of removed elements, which are recycled in LIFO order.
+	std::vector<int> available;
+
 	std::list<CreateElementCallback> callbackOnCreate;
 	std::list<RemoveElementCallback> callbackOnRemove;
 	std::list<DestructorCallback> callbackOnDestructor;
+	std::list<GrowthCallback> callbackOnGrowth;
 
 	int numElements;
 	int lastInsertedElementId;
@@ -145,6 +160,7 @@ private:
 			// Clean-up the recycled element.
 			*e = T();
 			lastInsertedElementId = recycle;
+			chunks[recycle/DEFAULT_CHUNK_SIZE].numElements++;
 		} else {
 			if (currentChunkFreeSpace == 0) {
 			   // Move to the next chunk or creates a new chunk to store the new 
@@ -156,6 +172,10 @@ private:
 			   } // end if
 
 			   currentChunkFreeSpace = DEFAULT_CHUNK_SIZE;
+
+			   for (GrowthCallback &callback : callbackOnGrowth) {
+				   callback((currentChunk + 1) * DEFAULT_CHUNK_SIZE);
+			   } // end for
 		   } // end else
 			
 			auto &c = chunks[currentChunk];
@@ -164,6 +184,7 @@ private:
 				currentChunkFreeSpace;
 			
 			currentChunkFreeSpace--;
+			c.numElements++;
 		} // end else
 
 		e->deleted = false;
@@ -195,7 +216,7 @@ public:
 		- currentChunkFreeSpace; }
 
 	int recycleId() const {
-		return available.empty()? -1 : available.front();
+		return available.empty()? -1 : available.back();
 	} // end method
 	
 	int capacity() const {
@@ -208,6 +229,27 @@ public:
 		return capacity;
 	} // end method
 
+	//! @brief Returns the number of chunks holding elements. Elements in
+	//!        different chunks can be processed independently (e.g. in
+	//!        parallel).
+	int getNumChunks() const { return currentChunk + 1; }
+
+	//! @brief Returns the number of ids covered by the chunks in use. It only
+	//!        increases when the list starts a new chunk (see 
+	//!        addGrowthCallback()).
+	int getUsedCapacity() const { return getNumChunks() * DEFAULT_CHUNK_SIZE; }
+
+	//! @brief Returns the number of bytes used by this list.
+	std::size_t getMemoryUsage() const {
+		return chunks.size() * sizeof(Chunk<T, DEFAULT_CHUNK_SIZE>) + 
+				available.capacity() * sizeof(int);
+	} // end method
+
+	//! @brief Returns the number of non-deleted elements in a chunk.
+	int getNumElementsInChunk(const int chunk) const {
+		return chunks[chunk].numElements;
+	} // end method
+
 	void reserve(const int n) {
 		const int numChunks = (int) std::ceil(n / double(DEFAULT_CHUNK_SIZE));
 		if (numChunks > chunks.size()) {
@@ -232,6 +274,21 @@ public:
 		return e;
 	} // end method
 
+	//! @brief Creates n elements at once and appends their ids to ids. Removed
+	//!        ids are recycled first. Growth callbacks are called once per new
+	//!        chunk.
+	void create(const int n, std::vector<int> &ids) {
+		reserve(largestId() + std::max(0, n - (int) available.size()));
+		ids.reserve(ids.size() + n);
+		for (int i = 0; i < n; i++) {
+			create_internal();
+			ids.push_back(lastId());
+			for (CreateElementCallback &callback : callbackOnCreate) {
+				callback(lastId());
+			} // end for
+		} // end for
+	} // end method
+
 	Element<T> *get(const int index) {
 		return &chunks[index/DEFAULT_CHUNK_SIZE].elements[index%DEFAULT_CHUNK_SIZE];
 	} // end method
@@ -243,6 +300,7 @@ public:
 	void remove(const int index) {
 		Element<T> *e = get(index);
 		e->deleted = true;
+		chunks[index/DEFAULT_CHUNK_SIZE].numElements--;
                 
 		available.push_back(index);
 		numElements--;
@@ -251,7 +309,41 @@ public:
 			callback(index);
 		} // end for
 	} // end method
+
+	//! @brief Removes all elements but keeps the chunks allocated so that they
+	//!        are reused by the next insertions. Ids restart from zero. Remove
+	//!        callbacks are not called and growth callbacks are called again as
+	//!        chunks are reused.
+	void clear() {
+		for (int i = 0; i <= currentChunk; i++) {
+			Chunk<T, DEFAULT_CHUNK_SIZE> &chunk = chunks[i];
+			for (Element<T> &e : chunk.elements) {
+				e = Element<T>();
+			} // end for
+			chunk.numElements = 0;
+		} // end for
+
+		available.clear();
+		numElements = 0;
+		lastInsertedElementId = -1;
+		currentChunk = -1;
+		currentChunkFreeSpace = 0;
+	} // end method
 	
+	//! @brief Registers a callback called whenever a new chunk starts to be
+	//!        used. The callback receives the new capacity, that is, all
+	//!        element ids are smaller than it until the next call. This is
+	//!        cheaper than a create callback when only storage needs to follow
+	//!        the list (e.g. attributes).
+	GrowthCallbackHandler addGrowthCallback(GrowthCallback callback) {
+		callbackOnGrowth.push_back(callback);
+		return --callbackOnGrowth.end();
+	} // end method
+
+	void deleteGrowthCallback(GrowthCallbackHandler handler) {
+		callbackOnGrowth.erase(handler);
+	} // end method
+
 	DestructorCallbackHandler addDestructorEventCallback(DestructorCallback callback) {
 		callbackOnDestructor.push_back(callback);
 		return --callbackOnDestructor.end();
@@ -286,6 +378,7 @@ public:
 		Element<T> *e;
 		int currChunk;
 		int currElementInChunk;
+		int endChunk;
 		int size;
 		bool stop;
 		
@@ -295,9 +388,14 @@ public:
 			
 				if (currElementInChunk == DEFAULT_CHUNK_SIZE) {
 					currElementInChunk = 0;
-					currChunk++;
+
+					// Skip chunks with no elements.
+					do {
+						currChunk++;
+					} while (currChunk < endChunk && 
+							!l->chunks[currChunk].numElements);
 					
-					if (currChunk == l->chunks.size()) {
+					if (currChunk >= endChunk) {
 						stop = true;
 						break;
 					} // end if
@@ -314,16 +412,29 @@ public:
 		} // end method
 		
 	public:		
-		Iterator() : l(NULL), e(NULL), currChunk(0), currElementInChunk(0) {};
-		Iterator( List *l ) : l(l), currChunk(0), currElementInChunk(0) {
-			if (!l->isEmpty()) {
-				e = l->get(0);
-				if (e->deleted) {
-					// Skip deleted elements at the beginning of the list.
-					e = nextElement();
-				} // end if
+		Iterator() : l(NULL), e(NULL), currChunk(0), currElementInChunk(0), endChunk(0) {};
+		Iterator( List *l ) : Iterator(l, 0, l->chunks.size()) {}
+
+		//! @brief Iterates over the elements stored in chunks [firstChunk, 
+		//!        lastChunk).
+		Iterator( List *l, const int firstChunk, const int lastChunk ) :
+				l(l), 
+				currChunk(firstChunk), 
+				currElementInChunk(0), 
+				endChunk(std::min(lastChunk, (int) l->chunks.size())) {
+			if (currChunk < endChunk) {
+				e = &(l->chunks[currChunk].elements[0]);
 				stop = false;
+				if (!l->chunks[currChunk].numElements) {
+					// Skip the whole chunk.
+					currElementInChunk = DEFAULT_CHUNK_SIZE - 1;
+					e = nextElement();
+				} else if (e->deleted) {
+					// Skip deleted elements at the beginning of the chunk.
+					e = nextElement();
+				} // end else
 			} else {
+				e = nullptr;
 				stop = true;
 			} // end else
 		} // end constructor
@@ -344,6 +455,10 @@ public:
 	Iterator begin() {
 		return Iterator( this );
 	}
+
+	Iterator begin(const int firstChunk, const int lastChunk) {
+		return Iterator( this, firstChunk, lastChunk );
+	}
 	
 	Iterator end() {
 		Iterator end;
@@ -387,7 +502,9 @@ public:
 	} // end constructor
 	
 	Element<T> *get(const int index) { return l->get(index); }
+	int getNumChunks() const { return l->getNumChunks(); }
 	Iterator begin() { return l->begin(); }
+	Iterator begin(const int firstChunk, const int lastChunk) { return l->begin(firstChunk, lastChunk); }
 	Iterator end() { return l->end(); }
 }; // end class
 
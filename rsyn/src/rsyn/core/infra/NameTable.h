@@ -0,0 +1,177 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_NAME_TABLE_H
+#define RSYN_NAME_TABLE_H
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <cstdint>
+
+#include <boost/utility/string_ref.hpp>
+
+#include "rsyn/util/Hash.h"
+
+namespace Rsyn {
+
+//! @brief Stores the names of objects indexed by their ids and allows finding
+//!        objects by name.
+//! @details Each name is stored only once. The hash index stores only ids
+//!          (4 bytes per bucket) and compares the query against the stored
+//!          names, so lookups can be done by a string reference (e.g. a
+//!          substring) without building a std::string. Names are never moved,
+//!          so references returned by operator[] remain valid.
+//! @note    If two objects get the same name, lookups return the latest one.
+template<typename T>
+class NameTable {
+public:
+
+	NameTable() : clsNumIndexed(0) {}
+
+	//! @brief Reserves space for n names.
+	void reserve(const int n);
+
+	//! @brief Stores the name of the object with a given id.
+	void add(const int id, const std::string &name, T object);
+
+	//! @brief Returns the name of the object with a given id.
+	const std::string &operator[](const int id) const { return clsNames[id]; }
+
+	//! @brief Returns the object with a given name or a null object if not
+	//!        found.
+	T find(const boost::string_ref name) const;
+
+	//! @brief Returns the number of stored names.
+	int size() const { return clsNumIndexed; }
+
+	//! @brief Returns the number of bytes used by this table.
+	std::size_t getMemoryUsage() const;
+
+private:
+
+	static const int EMPTY = -1;
+
+	std::deque<std::string> clsNames; // indexed by object id
+	std::vector<T> clsObjects; // indexed by object id
+	std::vector<int> clsBuckets; // open addressing (linear probing)
+	int clsNumIndexed;
+
+	static std::uint64_t hash(const boost::string_ref name);
+
+	int findBucket(const boost::string_ref name) const;
+	void rehash(const int numBuckets);
+}; // end class
+
+template<typename T>
+const int NameTable<T>::EMPTY;
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+inline std::uint64_t NameTable<T>::hash(const boost::string_ref name) {
+	return Hash::fnv1a(name.data(), name.size());
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+inline int NameTable<T>::findBucket(const boost::string_ref name) const {
+	const std::size_t mask = clsBuckets.size() - 1;
+	std::size_t bucket = hash(name) & mask;
+	while (true) {
+		const int id = clsBuckets[bucket];
+		if (id == EMPTY || name == boost::string_ref(clsNames[id]))
+			return (int) bucket;
+		bucket = (bucket + 1) & mask;
+	} // end while
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+inline void NameTable<T>::rehash(const int numBuckets) {
+	int size = 16;
+	while (size < numBuckets)
+		size <<= 1;
+	if (size <= clsBuckets.size())
+		return;
+
+	std::vector<int> buckets;
+	buckets.swap(clsBuckets);
+	clsBuckets.assign(size, EMPTY);
+	for (const int id : buckets) {
+		if (id != EMPTY)
+			clsBuckets[findBucket(clsNames[id])] = id;
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+inline void NameTable<T>::reserve(const int n) {
+	clsObjects.reserve(n);
+	rehash(2 * n);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+inline void NameTable<T>::add(const int id, const std::string &name, T object) {
+	if (clsNames.size() <= id) {
+		clsNames.resize(id + 1);
+		clsObjects.resize(id + 1, nullptr);
+	} // end if
+	clsNames[id] = name;
+	clsObjects[id] = object;
+
+	// Keep load factor below 1/2.
+	if (2 * (clsNumIndexed + 1) > clsBuckets.size())
+		rehash(2 * (clsNumIndexed + 1));
+
+	int &bucket = clsBuckets[findBucket(name)];
+	if (bucket == EMPTY)
+		clsNumIndexed++;
+	bucket = id;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+inline T NameTable<T>::find(const boost::string_ref name) const {
+	if (clsBuckets.empty())
+		return nullptr;
+	const int id = clsBuckets[findBucket(name)];
+	return id == EMPTY? nullptr : clsObjects[id];
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+inline std::size_t NameTable<T>::getMemoryUsage() const {
+	std::size_t bytes = clsNames.size() * sizeof(std::string) +
+			clsObjects.capacity() * sizeof(T) +
+			clsBuckets.capacity() * sizeof(int);
+	for (const std::string &name : clsNames) {
+		// Short strings are stored inside the object.
+		if (name.capacity() > 15)
+			bytes += name.capacity() + 1;
+	} // end for
+	return bytes;
+} // end method
+
+} // end namespace
+
+#endif /* RSYN_NAME_TABLE_H */
@@ -0,0 +1,58 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_NETLIST_CHANGES_H
+#define RSYN_NETLIST_CHANGES_H
+
+#include <vector>
+#include <utility>
+
+namespace Rsyn {
+
+//! @brief The changes done to the netlist during a transaction (see
+//!        Design::beginTransaction()). Each object appears only once.
+struct NetlistChanges {
+	//! @brief Instances created during the transaction.
+	std::vector<Instance> createdInstances;
+
+	//! @brief Nets created during the transaction.
+	std::vector<Net> createdNets;
+
+	//! @brief Cells remapped during the transaction along with the library
+	//!        cell they had before the transaction. Cells created during the
+	//!        transaction or mapped back to their original library cell are
+	//!        not reported.
+	std::vector<std::pair<Cell, LibraryCell>> remappedCells;
+
+	//! @brief Pins connected and/or disconnected during the transaction. Note
+	//!        that some of these pins may be disconnected at commit time.
+	std::vector<Pin> reconnectedPins;
+
+	bool empty() const {
+		return createdInstances.empty() && createdNets.empty() &&
+				remappedCells.empty() && reconnectedPins.empty();
+	} // end method
+
+	void clear() {
+		createdInstances.clear();
+		createdNets.clear();
+		remappedCells.clear();
+		reconnectedPins.clear();
+	} // end method
+}; // end struct
+
+} // end namespace
+
+#endif /* RSYN_NETLIST_CHANGES_H */
@@ -24,6 +24,11 @@ private:
 
 	Design observedDesign;
 
+	// Indicates that the observer implements onPostTransactionCommit() and
+	// hence should not be notified about individual changes inside a
+	// transaction.
+	bool observesTransactions = false;
+
 public:
 	
 	// Note: The observer will not be registered to receive notifications for
@@ -54,6 +59,18 @@ public:
 	virtual void
 	onPrePinDisconnect(Rsyn::Pin pin) {}
 
+	//! @brief Called once after the netlist is built in bulk load mode, in
+	//!        which no other notification is sent.
+	virtual void
+	onPostDesignLoad() {}
+
+	//! @brief Called once when the outermost transaction is committed with all
+	//!        the changes made during the transaction. Observers implementing
+	//!        this callback are not notified about individual changes inside
+	//!        a transaction. See Design::beginTransaction().
+	virtual void
+	onPostTransactionCommit(const Rsyn::NetlistChanges &changes) {}
+
 	virtual
 	~Observer() {
 		if (observedDesign)
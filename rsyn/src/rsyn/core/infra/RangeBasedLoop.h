@@ -141,6 +141,10 @@ public:
 
 	RangeIterator begin() { return RangeIterator(collection); }
 	RangeIterator end() { return RangeIterator(); /*dummy, not used */}
+
+	// Access to the underlying collection (e.g. to partition it, see 
+	// Parallel.h).
+	Collection &getCollection() { return collection; }
 }; // end class	
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -157,6 +161,24 @@ public:
     typename Collection::const_reverse_iterator end()   const { return collection.rend(); }
 }; // end class
 
+////////////////////////////////////////////////////////////////////////////////
+// Traverse the elements between two iterators (e.g. a view of a vector).
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename Iterator>
+class IteratorRange {
+private:
+	Iterator first;
+	Iterator last;
+public:
+	IteratorRange() {}
+	IteratorRange(Iterator first, Iterator last) : first(first), last(last) {}
+	Iterator begin() const { return first; }
+	Iterator end() const { return last; }
+	std::size_t size() const { return std::distance(first, last); }
+	bool empty() const { return first == last; }
+}; // end class
+
 ////////////////////////////////////////////////////////////////////////////////
 // Returns an specific element of a tuple collection.
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,121 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_VISITATION_MARKER_H
+#define RSYN_VISITATION_MARKER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace Rsyn {
+
+//! @brief Marks objects (by id) as visited during a traversal.
+//! @details Each traversal owns its marker, so traversals can run concurrently
+//!          in different threads and can also be nested. Markers are epoch
+//!          based: starting a new traversal costs O(1) as the storage is
+//!          recycled from a per-thread pool instead of being cleared.
+//! @note    A marker must not be shared among threads.
+class VisitationMarker {
+public:
+
+	//! @brief Acquires a marker from the pool of the calling thread. All
+	//!        objects start unvisited.
+	VisitationMarker() : clsStorage(acquire()) {}
+
+	//! @brief Returns the marker storage to the pool of the calling thread.
+	~VisitationMarker() { release(clsStorage); }
+
+	VisitationMarker(const VisitationMarker &) = delete;
+	VisitationMarker &operator=(const VisitationMarker &) = delete;
+
+	//! @brief Marks an object as visited. Returns true if the object was not
+	//!        visited before.
+	bool visit(const int id) {
+		assert(id >= 0);
+		std::vector<std::uint32_t> &epochs = clsStorage->epochs;
+		if (static_cast<std::size_t>(id) >= epochs.size())
+			epochs.resize(id + 1 + (id >> 1), 0);
+		if (epochs[id] == clsStorage->epoch)
+			return false;
+		epochs[id] = clsStorage->epoch;
+		return true;
+	} // end method
+
+	//! @brief Returns true if the object was visited.
+	bool isVisited(const int id) const {
+		assert(id >= 0);
+		const std::vector<std::uint32_t> &epochs = clsStorage->epochs;
+		return static_cast<std::size_t>(id) < epochs.size() &&
+				epochs[id] == clsStorage->epoch;
+	} // end method
+
+	//! @brief Marks all objects as unvisited.
+	void clear() { nextEpoch(clsStorage); }
+
+private:
+
+	struct Storage {
+		std::vector<std::uint32_t> epochs;
+		std::uint32_t epoch;
+		Storage() : epoch(0) {}
+	}; // end struct
+
+	struct Pool {
+		std::vector<Storage *> available;
+		~Pool() {
+			for (Storage *storage : available)
+				delete storage;
+		} // end destructor
+	}; // end struct
+
+	Storage *clsStorage;
+
+	static Pool &getPool() {
+		static thread_local Pool pool;
+		return pool;
+	} // end method
+
+	static void nextEpoch(Storage *storage) {
+		if (++storage->epoch == 0) {
+			// Wrapped around, so stale marks need to be cleaned.
+			storage->epochs.assign(storage->epochs.size(), 0);
+			storage->epoch = 1;
+		} // end if
+	} // end method
+
+	static Storage *acquire() {
+		Pool &pool = getPool();
+		Storage *storage;
+		if (pool.available.empty()) {
+			storage = new Storage;
+		} else {
+			storage = pool.available.back();
+			pool.available.pop_back();
+		} // end else
+		nextEpoch(storage);
+		return storage;
+	} // end method
+
+	static void release(Storage *storage) {
+		getPool().available.push_back(storage);
+	} // end method
+
+}; // end class
+
+} // end namespace
+
+#endif /* RSYN_VISITATION_MARKER_H */
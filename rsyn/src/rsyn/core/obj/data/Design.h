@@ -27,14 +27,13 @@ struct DesignData {
 	List<LibraryPinData> libraryPins;
 	List<LibraryArcData> libraryArcs;
 
-	std::vector<std::string> instanceNames;
-	std::vector<std::string> netNames;
+	// Object names indexed by object id. Also used to find objects by name.
+	NameTable<Instance> instanceNames;
+	NameTable<Net> netNames;
 	
 	int anonymousInstanceId;
 	int anonymousNetId;
 	
-	std::unordered_map<std::string, Instance> instanceMapping;
-	std::unordered_map<std::string, Net> netMapping;
 	std::unordered_map<std::string, LibraryCell> libraryCellMapping;
 	
 	std::array<LibraryCell, NUM_PIN_DIRECTIONS> portLibraryCells;
@@ -49,8 +48,24 @@ struct DesignData {
 	bool dirty;	
 	bool initialized;
 	
-	// Used for some netlist traversing (e.g. update topological ordering)...
-	int sign;	
+	// Indicates that the netlist is being built from scratch. See
+	// Design::beginBulkLoad().
+	bool bulkLoad;
+	
+	// Incremented whenever instances are created or the topological indexes
+	// change. Used to invalidate the topological orders cached in modules.
+	int topologyVersion;
+	
+	// Incremented whenever nets are created or pins are (dis)connected. Only
+	// the net order, which depends on the net arcs, is invalidated by these
+	// changes.
+	int connectivityVersion;
+	
+	// Number of nested transactions currently open and the changes made
+	// during them, which are delivered to observers when the outermost
+	// transaction is committed. See Design::beginTransaction().
+	int transactionDepth;
+	NetlistChanges pendingChanges;
 	
 	////////////////////////////////////////////////////////////////////////////
 	// Observerss
@@ -65,10 +80,13 @@ struct DesignData {
 	DesignData() :
 		initialized(false),
 		dirty(false),
+		bulkLoad(false),
 		anonymousInstanceId(0),
 		anonymousNetId(0),
 		instanceCount({0, 0, 0}),
-		sign(0) {
+		topologyVersion(0),
+		connectivityVersion(0),
+		transactionDepth(0) {
 	} // end constructor
 }; // end class
 
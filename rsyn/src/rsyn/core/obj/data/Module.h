@@ -31,11 +31,29 @@ struct ModuleData {
 	List<Port> ports;
 	std::set<Port> portsByDirection[Rsyn::NUM_PIN_DIRECTIONS]; // TODO: unify these too
 	
-	// Used for some netlist traversing...
-	int sign;	
+	// Cached topological orders. They are rebuilt on demand when the design
+	// topology version differs from the one they were built for. Nets are
+	// bucketed by logical depth: nets at depth i are stored in the range
+	// [netLevels[i], netLevels[i+1]) sorted by topological index.
+	std::vector<Net> netsInTopologicalOrder;
+	std::vector<int> netLevels;
+	std::vector<Pin> pinsInTopologicalOrder;
+	std::vector<Instance> instancesInTopologicalOrder;
+	
+	// The orders may be rebuilt when accessed, so the rebuild is guarded by a 
+	// mutex to allow concurrent readers (e.g. sandboxes evaluated in
+	// parallel).
+	std::atomic<int> netsInTopologicalOrderVersion;
+	std::atomic<int> netsInTopologicalOrderConnectivityVersion;
+	std::atomic<int> pinsInTopologicalOrderVersion;
+	std::atomic<int> instancesInTopologicalOrderVersion;
+	std::mutex topologicalOrderMutex;
 	
 	ModuleData() :
-		sign(0) {}
+		netsInTopologicalOrderVersion(-1),
+		netsInTopologicalOrderConnectivityVersion(-1),
+		pinsInTopologicalOrderVersion(-1),
+		instancesInTopologicalOrderVersion(-1) {}
 	
 }; // end struct
 
@@ -44,12 +44,8 @@ struct NetData : ObjectData {
 	
 	std::array<int, NUM_PIN_DIRECTIONS> numPinsOfType;
 	
-	// Helper used for netlist traversals.
-	int sign;
-	
 	NetData() : 
 		mid(-1),
-		sign(-1),
 		driver(nullptr), 
 		numPinsOfType({0, 0, 0, 0}), 
 		parent(nullptr) {
@@ -25,8 +25,6 @@ struct PinData : ObjectData {
 	                          // pins.
 	// <#
 	
-	int sign;
-	
 	Instance instance;
 	Net net;
 	std::vector<Arc> arcs[NUM_TRAVERSE_TYPES];
@@ -37,7 +35,6 @@ struct PinData : ObjectData {
 		direction(UNKNOWN_DIRECTION),
 		type(UNKNOWN_INSTANCE_TYPE),
 		boundary(false),
-		sign(0),
 		instance(nullptr), 
 		net(nullptr), 
 		
@@ -29,8 +29,11 @@ friend class Sandbox;
 friend class SandboxNet;
 friend class SandboxInstance;
 
+friend class PhysicalDesign;
+
 template<typename _Object, typename _ObjectReference, typename _ObjectExtension> friend class AttributeBase;
 template<typename _Object, typename _ObjectExtension> friend class AttributeImplementation;
+template<typename RsynObject, typename RsynObjectExtension> friend class AttributeFork;
 
 private:
 
@@ -78,13 +81,13 @@ private:
 	//! @brief Generates an unique name for a new net.
 	std::string generateUniqueNetName(const std::string &prefix);
 
-	//! @brief Generates the next sign to be used in some traversal algorithms
-	//!        as topological sorting.
-	int generateNextSign();
+	//! @brief Returns a counter that changes whenever instances are created or
+	//!        the topological indexes change.
+	int getTopologyVersion() const;
 
-	//! @brief Gets the current sign to be used in some traversal algorithms as
-	//!        topological sorting.
-	int getSign() const;
+	//! @brief Returns a counter that changes whenever nets are created or pins
+	//!        are connected or disconnected.
+	int getConnectivityVersion() const;
 	
 	////////////////////////////////////////////////////////////////////////////
 	// Unique Identifiers for Rsyn Objects
@@ -120,6 +123,22 @@ private:
 
 	//! @brief Gets the internal id of a library arc.
 	Index getId(LibraryArc larc) const;
+
+public:
+
+	//! @brief Marks an object (net, instance, pin or arc) as visited in a
+	//!        traversal. Returns true if the object was not visited before.
+	//! @note  Ids remain internal, the marker only sees them through here.
+	template<typename Object>
+	bool visit(VisitationMarker &marker, Object object) const {
+		return marker.visit(getId(object));
+	} // end method
+
+	//! @brief Returns true if an object was visited in a traversal.
+	template<typename Object>
+	bool isVisited(const VisitationMarker &marker, Object object) const {
+		return marker.isVisited(getId(object));
+	} // end method
 	
 	////////////////////////////////////////////////////////////////////////////
 	// Library
@@ -186,6 +205,65 @@ private:
 	//!        a pin (e.g. pin gets connected).
 	void updateTopologicalIndex(Pin pin);
 	
+	//! @brief Computes from scratch the topological ordering of all pins using
+	//!        a single linear-time traversal.
+	void updateTopologicalIndexes();
+
+	//! @brief Computes the topological ordering of the pins left unordered by
+	//!        updateTopologicalIndexes() due to combinational loops.
+	void updateTopologicalIndexesWithLoops(const std::vector<Pin> &pins);
+
+	////////////////////////////////////////////////////////////////////////////
+	// Bulk Load
+	////////////////////////////////////////////////////////////////////////////
+public:
+
+	//! @brief Enters bulk load mode to speed-up building a netlist from
+	//!        scratch (e.g. by readers). Capacity is reserved for the given
+	//!        number of objects (if known), observers are not notified about
+	//!        individual changes and the topological ordering is only computed
+	//!        when the bulk load ends.
+	void beginBulkLoad(const int numInstances = 0, const int numNets = 0,
+			const int numPins = 0);
+
+	//! @brief Leaves bulk load mode, computes the topological ordering of all
+	//!        pins and notifies observers via Observer::onPostDesignLoad().
+	void endBulkLoad();
+
+	//! @brief Returns true if the design is in bulk load mode.
+	bool isBulkLoading() const;
+
+	////////////////////////////////////////////////////////////////////////////
+	// Transactions
+	////////////////////////////////////////////////////////////////////////////
+private:
+
+	//! @brief Removes redundant changes (e.g. a pin reconnected several times)
+	//!        so that each object is reported only once.
+	void coalesceChanges(NetlistChanges &changes) const;
+
+public:
+
+	//! @brief Starts a transaction. Until the transaction is committed,
+	//!        observers are not notified about individual changes. Instead,
+	//!        changes are queued and delivered once at commit. Transactions
+	//!        can be nested, only the outermost commit delivers the changes.
+	//! @note  Observers that do not implement
+	//!        Observer::onPostTransactionCommit() still receive pre-change
+	//!        notifications (e.g. pin disconnection) immediately as they need
+	//!        to see the netlist before the change.
+	void beginTransaction();
+
+	//! @brief Commits the current transaction. If this is the outermost
+	//!        transaction, notifies observers about the coalesced changes via
+	//!        Observer::onPostTransactionCommit(). Observers that do not
+	//!        implement it are notified once per changed object through the
+	//!        regular callbacks.
+	void commit();
+
+	//! @brief Returns true if a transaction is open.
+	bool isInTransaction() const;
+	
 	////////////////////////////////////////////////////////////////////////////
 	// Events
 	////////////////////////////////////////////////////////////////////////////	
@@ -263,6 +341,14 @@ public:
 
 	//! @brief Gets the tag information associate to a library cell.
 	LibraryCellTag getTag(Rsyn::LibraryCell libraryCell);
+
+	////////////////////////////////////////////////////////////////////////////
+	// Memory
+	////////////////////////////////////////////////////////////////////////////
+
+	//! @brief Adds the memory used by the netlist to a report. Requires a
+	//!        traversal of all objects.
+	void reportMemoryUsage(MemoryReport &report);
 	
 	////////////////////////////////////////////////////////////////////////////
 	// Range-Based Loops
@@ -288,10 +374,30 @@ public:
 	GenericListCollection(const List<Object, CHUNK_SIZE> &pins)
 			: list(pins), it(list.begin()) {}
 
+	GenericListCollection(const List<Object, CHUNK_SIZE> &pins, 
+			const int firstChunk, const int lastChunk)
+			: list(pins), it(list.begin(firstChunk, lastChunk)) {}
+
 	bool filter() { return false; }
 	bool stop() { return it.stopFlag(); }
 	void next() { ++it; }
 	Reference current() { return &((*it).getPointer()->value); } // TODO: awful
+
+	//! @brief Returns the number of chunks of the underlying list.
+	int getNumChunks() { return list.getNumChunks(); }
+
+	//! @brief Returns a collection with the objects stored in chunks
+	//!        [firstChunk, lastChunk). Different chunks can be traversed
+	//!        concurrently.
+	GenericListCollection getChunks(const int firstChunk, const int lastChunk) {
+		return GenericListCollection(list, firstChunk, lastChunk);
+	} // end method
+
+private:
+
+	GenericListCollection(ConstList<Object, CHUNK_SIZE> list,
+			const int firstChunk, const int lastChunk)
+			: list(list), it(this->list.begin(firstChunk, lastChunk)) {}
 }; // end class	
 
 // -------------------------------------------------------------------------
@@ -306,10 +412,30 @@ public:
 	GenericReferenceListCollection(const List<Reference, CHUNK_SIZE> &pins)
 			: list(pins), it(list.begin()) {}
 
+	GenericReferenceListCollection(const List<Reference, CHUNK_SIZE> &pins,
+			const int firstChunk, const int lastChunk)
+			: list(pins), it(list.begin(firstChunk, lastChunk)) {}
+
 	bool filter() { return false; }
 	bool stop() { return it.stopFlag(); }
 	void next() { ++it; }
 	Reference current() { return (*it).getPointer()->value; } // TODO: awful
+
+	//! @brief Returns the number of chunks of the underlying list.
+	int getNumChunks() { return list.getNumChunks(); }
+
+	//! @brief Returns a collection with the objects stored in chunks
+	//!        [firstChunk, lastChunk). Different chunks can be traversed
+	//!        concurrently.
+	GenericReferenceListCollection getChunks(const int firstChunk, const int lastChunk) {
+		return GenericReferenceListCollection(list, firstChunk, lastChunk);
+	} // end method
+
+private:
+
+	GenericReferenceListCollection(ConstList<Reference, CHUNK_SIZE> list,
+			const int firstChunk, const int lastChunk)
+			: list(list), it(this->list.begin(firstChunk, lastChunk)) {}
 }; // end class	
 
 // -------------------------------------------------------------------------
@@ -15,6 +15,14 @@
  
 namespace Rsyn {
 
+//! @brief A view of a cached topological order.
+template<typename T>
+using TopologicalOrder = IteratorRange<typename std::vector<T>::const_iterator>;
+
+//! @brief A view of a cached topological order traversed backwards.
+template<typename T>
+using ReverseTopologicalOrder = IteratorRange<typename std::vector<T>::const_reverse_iterator>;
+
 //! @brief A proxy class representing a netlist module.
 class Module : public Instance {
 	
@@ -26,13 +34,11 @@ friend class Instance;
 private:
 	Module(InstanceData * data) : Instance(data) {}
 
-	//! @brief Generates the next sign to be used in some traversal algorithms
-	//!        as topological sorting.
-	int generateNextSign();
-
-	//! @brief Gets the current sign to be used in some traversal algorithms as
-	//!        topological sorting.
-	int getSign() const;
+	//! @brief Rebuilds the cached topological orders if the design topology
+	//!        changed since they were built.
+	void updateNetsInTopologicalOrder();
+	void updatePinsInTopologicalOrder();
+	void updateInstancesInTopologicalOrder();
 
 	//! @brief This method is inherited from Instance. Hide to avoid confusion
 	//!        with internal pins. See allInterfacePins() and allInternalPins().
@@ -149,33 +155,53 @@ public:
 
 	//! @brief Returns an iterable collection of all pins instantiated in this
 	//!        module in topological order (from inputs to outputs).
-	std::vector<TupleElement<1, TopologicalIndex, Pin>>
+	//! @note  The order is cached and only rebuilt after the netlist changes.
+	//!        The returned view is invalidated by netlist changes.
+	TopologicalOrder<Pin>
 	allPinsInTopologicalOrder();
 
 	//! @brief Returns an iterable collection of all pins instantiated in this
 	//!        module in reverse topological order (from outputs to inputs).
-	std::vector<TupleElement<1, TopologicalIndex, Pin>>
+	//! @note  The returned view is invalidated by netlist changes.
+	ReverseTopologicalOrder<Pin>
 	allPinsInReverseTopologicalOrder();
 
 	//! @brief Returns an iterable collection of all nets instantiated in this
-	//!        module in topological order (from inputs to outputs).
+	//!        module in topological order (from inputs to outputs). Nets are
+	//!        sorted by logical depth and then by topological index.
 	//! @note  See Net::getTopologicalIndex() description to check how
 	//!        the topological index of nets is defined.
-	std::vector<TupleElement<1, TopologicalIndex, Net>>
+	//! @note  The order is cached and only rebuilt after the netlist changes.
+	//!        The returned view is invalidated by netlist changes.
+	TopologicalOrder<Net>
 	allNetsInTopologicalOrder();	
 
 	//! @brief Returns an iterable collection of all nets instantiated in this
 	//!        module in reverse topological order (from outputs to inputs).
 	//! @note  See Net::getTopologicalIndex() description to check how
 	//!        the topological index of nets is defined.
-	std::vector<TupleElement<1, TopologicalIndex, Net>>
+	//! @note  The returned view is invalidated by netlist changes.
+	ReverseTopologicalOrder<Net>
 	allNetsInReverseTopologicalOrder();	
 
+	//! @brief Returns the number of logical depths (levels) of the nets.
+	int getNumNetLogicalDepths();
+
+	//! @brief Returns the nets at a given logical depth sorted by topological
+	//!        index. The logical depth of a net is zero if its drivers have no
+	//!        incoming arcs, otherwise it is one plus the largest depth of the
+	//!        nets driving those arcs. Nets at the same depth do not depend on
+	//!        each other.
+	//! @note  The returned view is invalidated by netlist changes.
+	TopologicalOrder<Net>
+	allNetsAtLogicalDepth(const int depth);
+
 	//! @brief Returns an iterable collection of all instances instantiated in
 	//!        this module in topological order (from inputs to outputs).
 	//! @note  See Instance::getTopologicalIndex() description to check how
 	//!        the topological index of instances is defined.
-	std::vector<TupleElement<1, TopologicalIndex, Instance>>
+	//! @note  The returned view is invalidated by netlist changes.
+	TopologicalOrder<Instance>
 	allInstancesInTopologicalOrder();	
 
 	//! @brief Returns a vector with the nets in the fanout cone of a pin. The
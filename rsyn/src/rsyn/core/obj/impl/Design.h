@@ -84,16 +84,16 @@ Design::generateUniqueNetName(const std::string &prefix) {
 
 inline
 int 
-Design::generateNextSign() { 
-	return ++data->sign; /*must be pre-increment*/ 
+Design::getTopologyVersion() const { 
+	return data->topologyVersion; 
 } // end method
 
 // -----------------------------------------------------------------------------
 
 inline
 int 
-Design::getSign() const { 
-	return data->sign; 
+Design::getConnectivityVersion() const { 
+	return data->connectivityVersion; 
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -101,8 +101,7 @@ Design::getSign() const {
 inline 
 Instance 
 Design::findInstanceByName(const std::string &name) const {
-	auto it = data->instanceMapping.find(name);
-	return it != data->instanceMapping.end()? it->second : nullptr;
+	return data->instanceNames.find(name);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -158,8 +157,7 @@ Design::findLibraryCellByName(const std::string &name) const {
 inline
 Net 
 Design::findNetByName(const std::string &name) const {
-	auto it = data->netMapping.find(name);
-	return it != data->netMapping.end()? it->second : nullptr;
+	return data->netNames.find(name);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -184,9 +182,12 @@ Design::findPinByName(const std::string &name, const std::string::value_type sep
 	if (split == std::string::npos)
 		return nullptr;
 
-	const std::string cellName = name.substr(0, split);
-	const std::string pinName = name.substr(split + 1, std::string::npos);
-	return findPinByName(cellName, pinName);
+	// Avoid copying the cell name.
+	const boost::string_ref cellName = boost::string_ref(name).substr(0, split);
+	const Instance instance = data->instanceNames.find(cellName);
+	if (!instance || instance.getType() != Rsyn::CELL)
+		return nullptr;
+	return instance.asCell().getPinByName(name.substr(split + 1, std::string::npos));
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -343,12 +344,7 @@ Design::createCell(const Module parent, const LibraryCell libraryCell, const std
 	} // end for
 			
 	// Stores cell name.
-	if (data->instanceNames.size() <= instance->id) {
-		data->instanceNames.resize(instance->id+1);
-	} // end if
-
-	data->instanceNames[instance->id] = cellName;
-	data->instanceMapping[cellName] = Instance(instance);
+	data->instanceNames.add(instance->id, cellName, Instance(instance));
 
 	// Records this cell in it's parent module.
 	parent->moduleData->instances.add(cell);
@@ -359,10 +355,17 @@ Design::createCell(const Module parent, const LibraryCell libraryCell, const std
 	
 	// Mark as dirty.
 	data->dirty = true;
+	data->topologyVersion++;
 	
 	// Notify observers.
-	for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE])
-		f->onPostInstanceCreate(cell);
+	if (!data->bulkLoad) {
+		if (data->transactionDepth > 0) {
+			data->pendingChanges.createdInstances.push_back(cell);
+		} else {
+			for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE])
+				f->onPostInstanceCreate(cell);
+		} // end else
+	} // end if
 	
 	// Return
 	return cell;
@@ -427,12 +430,7 @@ Design::createPort(Module parent, const Direction direction, const std::string &
 	} // ens switch
 	
 	// Stores port (instance) name.
-	if (data->instanceNames.size() <= port->id) {
-		data->instanceNames.resize(port->id+1);
-	} // end if
-
-	data->instanceNames[port->id] = portName;
-	data->instanceMapping[portName] = Instance(port);
+	data->instanceNames.add(port->id, portName, Instance(port));
 
 	// Records this cell in it's parent module.
 	parent->moduleData->instances.add(port);
@@ -444,11 +442,18 @@ Design::createPort(Module parent, const Direction direction, const std::string &
 	data->instanceCount[Rsyn::PORT]++;	
 	
 	// Mark as dirty.
-	data->dirty = true;	
+	data->dirty = true;
+	data->topologyVersion++;	
 	
 	// Notify observers.
-	for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE])
-		f->onPostInstanceCreate(port);
+	if (!data->bulkLoad) {
+		if (data->transactionDepth > 0) {
+			data->pendingChanges.createdInstances.push_back(port);
+		} else {
+			for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE])
+				f->onPostInstanceCreate(port);
+		} // end else
+	} // end if
 
 	// Return
 	return port;
@@ -470,22 +475,24 @@ Design::createModule(const LibraryModule lmoudle, const std::string &name) {
 	instance->moduleData->design = *this;
 				
 	// Stores instance name.
-	if (data->instanceNames.size() <= instance->id) {
-		data->instanceNames.resize(instance->id+1);
-	} // end if
-
-	data->instanceNames[instance->id] = name;
-	data->instanceMapping[name] = Instance(instance);
+	data->instanceNames.add(instance->id, name, Instance(instance));
 	
 	// Trace the number of instances.
 	data->instanceCount[Rsyn::MODULE]++;		
 	
 	// Mark as dirty.
 	data->dirty = true;
+	data->topologyVersion++;
 	
 	// Notify observers.
-	for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE])
-		f->onPostInstanceCreate(instance);
+	if (!data->bulkLoad) {
+		if (data->transactionDepth > 0) {
+			data->pendingChanges.createdInstances.push_back(instance);
+		} else {
+			for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE])
+				f->onPostInstanceCreate(instance);
+		} // end else
+	} // end if
 	
 	// Return
 	return Module(instance);
@@ -508,23 +515,25 @@ Design::createNet(const Module parent, const std::string &name) {
 	net->parent = parent;
 
 	// Stores net name.
-	if (data->netNames.size() <= net->id) {
-		data->netNames.resize(net->id+1);
-	} // end if
-
-	data->netNames[net->id] = netName;
-	data->netMapping[netName] = net;
+	data->netNames.add(net->id, netName, net);
 		
 	// Records this cell in it's parent module.
 	parent->moduleData->nets.add(net);
 	net->mid = parent->moduleData->nets.lastId();
 	
 	// Notify observers.
-	for (auto f : data->observers[EVENT_POST_NET_CREATE])
-		f->onPostNetCreate(net);
+	if (!data->bulkLoad) {
+		if (data->transactionDepth > 0) {
+			data->pendingChanges.createdNets.push_back(net);
+		} else {
+			for (auto f : data->observers[EVENT_POST_NET_CREATE])
+				f->onPostNetCreate(net);
+		} // end else
+	} // end if
 	
 	// Mark as dirty.
-	data->dirty = true;	
+	data->dirty = true;
+	data->connectivityVersion++;	
 	
 	// Return.
 	return net;
@@ -584,14 +593,23 @@ Design::connectPin(Pin pin, Net net) {
 	} // end switch
 	
 	// Mark as dirty.
-	data->dirty = true;	
+	data->dirty = true;
+	data->connectivityVersion++;	
 		
-	// Update topological sorting.
-	updateTopologicalIndex(pin);
+	// Update topological sorting. In bulk load mode, the topological sorting
+	// is computed once at the end.
+	if (!data->bulkLoad)
+		updateTopologicalIndex(pin);
 	
 	// Notify observers.
-	for (auto f : data->observers[EVENT_POST_PIN_CONNECT])
-		f->onPostPinConnect(pin);
+	if (!data->bulkLoad) {
+		if (data->transactionDepth > 0) {
+			data->pendingChanges.reconnectedPins.push_back(pin);
+		} else {
+			for (auto f : data->observers[EVENT_POST_PIN_CONNECT])
+				f->onPostPinConnect(pin);
+		} // end else
+	} // end if
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -599,9 +617,17 @@ Design::connectPin(Pin pin, Net net) {
 inline
 void
 Design::disconnectPin(Pin pin) {
-	// Notify observers.
-	for (auto f : data->observers[EVENT_PRE_PIN_DISCONNECT])
-		f->onPrePinDisconnect(pin);
+	// Notify observers. Pre-change notifications can't be postponed, so during
+	// a transaction they are still sent to observers not aware of transactions.
+	if (!data->bulkLoad) {
+		const bool transaction = data->transactionDepth > 0;
+		if (transaction)
+			data->pendingChanges.reconnectedPins.push_back(pin);
+		for (auto f : data->observers[EVENT_PRE_PIN_DISCONNECT]) {
+			if (!transaction || !f->Observer::observesTransactions)
+				f->onPrePinDisconnect(pin);
+		} // end for
+	} // end if
 	
 	if (pin->net) {
 		// Remove the pin from the net.
@@ -645,6 +671,7 @@ Design::disconnectPin(Pin pin) {
 
 		// Mark as dirty.
 		data->dirty = true;
+		data->connectivityVersion++;
 	} // end if
 } // end method
 
@@ -717,8 +744,15 @@ Design::remap(Cell cell, LibraryCell newLibraryCell) {
 	} // end for
 	
 	// Notify observers.
-	for (auto f : data->observers[EVENT_POST_CELL_REMAP])
-		f->onPostCellRemap(cell, oldLibraryCell);
+	if (!data->bulkLoad) {
+		if (data->transactionDepth > 0) {
+			data->pendingChanges.remappedCells.push_back(
+					std::make_pair(cell, oldLibraryCell));
+		} else {
+			for (auto f : data->observers[EVENT_POST_CELL_REMAP])
+				f->onPostCellRemap(cell, oldLibraryCell);
+		} // end else
+	} // end if
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -781,8 +815,12 @@ Design::updateTopologicalIndex(Pin pin) {
 	static_assert(TOPOLOGICAL_SORTING_SMALL_GAP <= 
 			TOPOLOGICAL_SORTING_LARGE_GAP, "small gap > large gap");
 	
-	// Gets the signature for this update search.
-	const int sign = generateNextSign();
+	// Used to invalidate cached topological orders only if some index changes.
+	const TopologicalIndex previousOrder = pin->order;
+	bool propagated = false;
+	
+	// Tracks the pins visited by this update search.
+	VisitationMarker visited;
 	
 	// Gets the lower bound index.
 	TopologicalIndex lower = 
@@ -802,6 +840,10 @@ Design::updateTopologicalIndex(Pin pin) {
 		hasUpper = true;
 	} // end for
 	
+	// Keep the current index if it still lies between the bounds.
+	if ((!hasLower || lower < pin->order) && (!hasUpper || pin->order < upper))
+		return;
+
 	// Set pin's topological ordering.
 	if (!hasLower && !hasUpper) {
 		pin->order = 0;
@@ -855,8 +897,7 @@ Design::updateTopologicalIndex(Pin pin) {
 				} // end if
 					
 				TopologicalIndex order;
-				if (current->sign != sign) {
-					current->sign = sign;
+				if (visited.visit(current->id)) {
 					order = (TopologicalIndex) std::floor(
 							(float((current->order - upper)*w1)/float(w0)) + left1);
 					if (order <= generatorOrder) {
@@ -867,6 +908,7 @@ Design::updateTopologicalIndex(Pin pin) {
 				} // end else
 				
 				current->order = order;
+				propagated = true;
 				
 				for (Rsyn::Pin successor : current.allSucessorPins(true)) {
 					if (successor->order <= order) {
@@ -876,6 +918,336 @@ Design::updateTopologicalIndex(Pin pin) {
 			} // end while
 		} // end else
 	} // end else
+	
+	// Invalidates cached topological orders.
+	if (propagated || pin->order != previousOrder)
+		data->topologyVersion++;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+void
+Design::updateTopologicalIndexes() {
+	const int numPins = data->pins.largestId();
+
+	// Counts the number of predecessors of each pin.
+	std::vector<int> numPendingPredecessors(numPins, 0);
+	std::vector<char> visited(numPins, false);
+	for (int i = 0; i < numPins; i++) {
+		Element<PinData> *element = data->pins.get(i);
+		if (element->deleted) {
+			visited[i] = true;
+			continue;
+		} // end if
+
+		Pin pin(&element->value);
+		pin->order = 0;
+		for (Rsyn::Pin successor : pin.allSucessorPins(true)) {
+			numPendingPredecessors[successor->id]++;
+		} // end for
+	} // end for
+
+	// Visits pins in topological order (Kahn's algorithm). The index of a pin
+	// is set to the largest index of its predecessors plus a small gap.
+	std::vector<Pin> open;
+	for (int i = 0; i < numPins; i++) {
+		if (!visited[i] && numPendingPredecessors[i] == 0) {
+			visited[i] = true;
+			open.push_back(&data->pins.get(i)->value);
+		} // end if
+	} // end for
+
+	while (!open.empty()) {
+		Rsyn::Pin pin = open.back();
+		open.pop_back();
+
+		for (Rsyn::Pin successor : pin.allSucessorPins(true)) {
+			successor->order = std::max(successor->order,
+					pin->order + TOPOLOGICAL_SORTING_SMALL_GAP);
+			if (--numPendingPredecessors[successor->id] == 0) {
+				visited[successor->id] = true;
+				open.push_back(successor);
+			} // end if
+		} // end for
+	} // end while
+
+	// Pins not visited yet are in or after a loop.
+	std::vector<Pin> remaining;
+	for (int i = 0; i < numPins; i++) {
+		if (!visited[i])
+			remaining.push_back(&data->pins.get(i)->value);
+	} // end for
+
+	if (!remaining.empty()) {
+		std::cout << "WARNING: Loop detected.\n";
+		updateTopologicalIndexesWithLoops(remaining);
+	} // end if
+
+	// Invalidates cached topological orders.
+	data->topologyVersion++;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+void
+Design::updateTopologicalIndexesWithLoops(const std::vector<Pin> &pins) {
+	const int numPins = (int) pins.size();
+
+	// Successors of each pin as local indexes. Successors of these pins are
+	// never visited, so they are all in the list.
+	std::vector<int> local(data->pins.largestId(), -1);
+	for (int i = 0; i < numPins; i++) {
+		local[pins[i]->id] = i;
+	} // end for
+
+	std::vector<int> firstSuccessor(numPins + 1);
+	std::vector<int> successors;
+	for (int i = 0; i < numPins; i++) {
+		firstSuccessor[i] = (int) successors.size();
+		for (Rsyn::Pin successor : pins[i].allSucessorPins(true)) {
+			successors.push_back(local[successor->id]);
+		} // end for
+	} // end for
+	firstSuccessor[numPins] = (int) successors.size();
+
+	// Finds the strongly connected components (i.e. the loops) with Tarjan's
+	// algorithm. An explicit stack is used since paths may be long. Components
+	// are found in reverse topological order.
+	std::vector<int> dfsIndex(numPins, -1);
+	std::vector<int> lowLink(numPins, 0);
+	std::vector<int> component(numPins, -1);
+	std::vector<int> componentPins;
+	std::vector<int> firstComponentPin;
+	std::vector<int> stack;
+	std::vector<std::pair<int, int>> path; // (pin, next successor)
+	int numVisitedPins = 0;
+	for (int root = 0; root < numPins; root++) {
+		if (dfsIndex[root] != -1)
+			continue;
+
+		dfsIndex[root] = lowLink[root] = numVisitedPins++;
+		stack.push_back(root);
+		path.push_back(std::make_pair(root, firstSuccessor[root]));
+
+		while (!path.empty()) {
+			const int v = path.back().first;
+			const int next = path.back().second;
+
+			if (next < firstSuccessor[v + 1]) {
+				path.back().second++;
+				const int w = successors[next];
+				if (dfsIndex[w] == -1) {
+					dfsIndex[w] = lowLink[w] = numVisitedPins++;
+					stack.push_back(w);
+					path.push_back(std::make_pair(w, firstSuccessor[w]));
+				} else if (component[w] == -1) {
+					// w is still in the stack, so it is in the same component.
+					lowLink[v] = std::min(lowLink[v], dfsIndex[w]);
+				} // end else-if
+				continue;
+			} // end if
+
+			path.pop_back();
+			if (!path.empty()) {
+				const int u = path.back().first;
+				lowLink[u] = std::min(lowLink[u], lowLink[v]);
+			} // end if
+
+			if (lowLink[v] == dfsIndex[v]) {
+				const int id = (int) firstComponentPin.size();
+				firstComponentPin.push_back((int) componentPins.size());
+				int w;
+				do {
+					w = stack.back();
+					stack.pop_back();
+					component[w] = id;
+					componentPins.push_back(w);
+				} while (w != v);
+			} // end if
+		} // end while
+	} // end for
+	firstComponentPin.push_back((int) componentPins.size());
+
+	// Visits the components in topological order, so pins after a loop get an
+	// index larger than all pins before them. Inside a component, the loop is
+	// broken by visiting the pins in depth-first order.
+	const int numComponents = (int) firstComponentPin.size() - 1;
+	for (int c = numComponents - 1; c >= 0; c--) {
+		auto begin = componentPins.begin() + firstComponentPin[c];
+		auto end = componentPins.begin() + firstComponentPin[c + 1];
+		std::sort(begin, end, [&dfsIndex](const int a, const int b) {
+			return dfsIndex[a] < dfsIndex[b];
+		});
+
+		for (auto it = begin; it != end; it++) {
+			const int v = *it;
+			for (int k = firstSuccessor[v]; k < firstSuccessor[v + 1]; k++) {
+				const int w = successors[k];
+				if (component[w] != c || dfsIndex[w] > dfsIndex[v]) {
+					Pin successor = pins[w];
+					successor->order = std::max(successor->order,
+							pins[v]->order + TOPOLOGICAL_SORTING_SMALL_GAP);
+				} // end if
+			} // end for
+		} // end for
+	} // end for
+} // end method
+
+////////////////////////////////////////////////////////////////////////////////
+// Bulk Load
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+void
+Design::beginBulkLoad(const int numInstances, const int numNets, const int numPins) {
+	Module top = getTopModule();
+
+	if (numInstances > 0) {
+		const int n = data->instances.size() + numInstances;
+		data->instances.reserve(n);
+		data->instanceNames.reserve(n);
+		top->moduleData->instances.reserve(n);
+	} // end if
+
+	if (numNets > 0) {
+		const int n = data->nets.size() + numNets;
+		data->nets.reserve(n);
+		data->netNames.reserve(n);
+		top->moduleData->nets.reserve(n);
+	} // end if
+
+	if (numPins > 0) {
+		data->pins.reserve(data->pins.size() + numPins);
+	} // end if
+
+	data->bulkLoad = true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+void
+Design::endBulkLoad() {
+	if (!data->bulkLoad)
+		return;
+
+	data->bulkLoad = false;
+	updateTopologicalIndexes();
+
+	// Notify observers.
+	for (auto f : data->observers[EVENT_POST_DESIGN_LOAD])
+		f->onPostDesignLoad();
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+bool
+Design::isBulkLoading() const {
+	return data->bulkLoad;
+} // end method
+
+////////////////////////////////////////////////////////////////////////////////
+// Transactions
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+void
+Design::beginTransaction() {
+	data->transactionDepth++;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+void
+Design::commit() {
+	if (data->transactionDepth == 0)
+		throw Exception("Trying to commit but no transaction is open.");
+
+	if (--data->transactionDepth > 0)
+		return;
+
+	// Move the changes out first as observers may start new transactions.
+	NetlistChanges changes;
+	std::swap(changes, data->pendingChanges);
+	coalesceChanges(changes);
+
+	if (changes.empty())
+		return;
+
+	// Notify observers aware of transactions.
+	for (auto f : data->observers[EVENT_POST_TRANSACTION_COMMIT])
+		f->onPostTransactionCommit(changes);
+
+	// Notify the remaining observers once per changed object.
+	for (Instance instance : changes.createdInstances) {
+		for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE])
+			if (!f->Observer::observesTransactions)
+				f->onPostInstanceCreate(instance);
+	} // end for
+
+	for (Net net : changes.createdNets) {
+		for (auto f : data->observers[EVENT_POST_NET_CREATE])
+			if (!f->Observer::observesTransactions)
+				f->onPostNetCreate(net);
+	} // end for
+
+	for (const std::pair<Cell, LibraryCell> &remap : changes.remappedCells) {
+		for (auto f : data->observers[EVENT_POST_CELL_REMAP])
+			if (!f->Observer::observesTransactions)
+				f->onPostCellRemap(remap.first, remap.second);
+	} // end for
+
+	for (Pin pin : changes.reconnectedPins) {
+		if (!pin.isConnected())
+			continue;
+		for (auto f : data->observers[EVENT_POST_PIN_CONNECT])
+			if (!f->Observer::observesTransactions)
+				f->onPostPinConnect(pin);
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+bool
+Design::isInTransaction() const {
+	return data->transactionDepth > 0;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+void
+Design::coalesceChanges(NetlistChanges &changes) const {
+	VisitationMarker visited;
+
+	// Cells created during the transaction are reported only as created.
+	for (Instance instance : changes.createdInstances)
+		visit(visited, instance);
+
+	// Keep the library cell of the first remap as it is the one the cell had
+	// before the transaction.
+	int numRemappedCells = 0;
+	for (const std::pair<Cell, LibraryCell> &remap : changes.remappedCells) {
+		if (!visit(visited, Instance(remap.first)))
+			continue;
+		if (remap.first.getLibraryCell() == remap.second)
+			continue; // mapped back
+		changes.remappedCells[numRemappedCells++] = remap;
+	} // end for
+	changes.remappedCells.resize(numRemappedCells);
+
+	visited.clear();
+	int numReconnectedPins = 0;
+	for (Pin pin : changes.reconnectedPins) {
+		if (visit(visited, pin))
+			changes.reconnectedPins[numReconnectedPins++] = pin;
+	} // end for
+	changes.reconnectedPins.resize(numReconnectedPins);
 } // end method
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -938,6 +1310,15 @@ Design::registerObserver(T *observer) {
 	if (typeid(&Observer::onPrePinDisconnect) != typeid(&T::onPrePinDisconnect)) {
 		data->observers[EVENT_PRE_PIN_DISCONNECT].push_back(observer);
 	} // end if	
+
+	if (typeid(&Observer::onPostDesignLoad) != typeid(&T::onPostDesignLoad)) {
+		data->observers[EVENT_POST_DESIGN_LOAD].push_back(observer);
+	} // end if
+
+	if (typeid(&Observer::onPostTransactionCommit) != typeid(&T::onPostTransactionCommit)) {
+		data->observers[EVENT_POST_TRANSACTION_COMMIT].push_back(observer);
+		observer->Observer::observesTransactions = true;
+	} // end if
 	
 } // end method
 
@@ -950,6 +1331,7 @@ Design::unregisterObserver(Observer *observer) {
 		data->observers[i].remove(observer);
 	} // end for
 	observer->Observer::observedDesign = nullptr;
+	observer->Observer::observesTransactions = false;
 } // end method
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -998,6 +1380,48 @@ Design::getTag(Rsyn::LibraryCell libraryCell) {
 	return LibraryCellTag(&libraryCell->tag);
 } // end method
 
+////////////////////////////////////////////////////////////////////////////////
+// Memory
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+void
+Design::reportMemoryUsage(MemoryReport &report) {
+	report.add("instances", data->instances.getMemoryUsage());
+	report.add("pins", data->pins.getMemoryUsage());
+	report.add("arcs", data->arcs.getMemoryUsage());
+	report.add("nets", data->nets.getMemoryUsage());
+	report.add("library",
+			data->libraryCells.getMemoryUsage() +
+			data->libraryPins.getMemoryUsage() +
+			data->libraryArcs.getMemoryUsage());
+	report.add("names",
+			data->instanceNames.getMemoryUsage() +
+			data->netNames.getMemoryUsage());
+	report.add("topology",
+			MemoryReport::bytes(data->structuralStartpoints) +
+			MemoryReport::bytes(data->structuralEndpoints) +
+			MemoryReport::bytes(data->netsInTopologicalOrder));
+
+	// Connectivity is stored in vectors owned by the objects.
+	std::size_t connectivity = 0;
+	for (auto it = data->instances.begin(); !it.stopFlag(); ++it) {
+		const InstanceData &instance = (*it).getValue();
+		connectivity += MemoryReport::bytes(instance.pins);
+		connectivity += MemoryReport::bytes(instance.arcs);
+	} // end for
+	for (auto it = data->pins.begin(); !it.stopFlag(); ++it) {
+		const PinData &pin = (*it).getValue();
+		connectivity += MemoryReport::bytes(pin.arcs[FORWARD]);
+		connectivity += MemoryReport::bytes(pin.arcs[BACKWARD]);
+	} // end for
+	for (auto it = data->nets.begin(); !it.stopFlag(); ++it) {
+		const NetData &net = (*it).getValue();
+		connectivity += MemoryReport::bytes(net.pins);
+	} // end for
+	report.add("connectivity", connectivity);
+} // end method
+
 ////////////////////////////////////////////////////////////////////////////////
 // Range-Based Loop
 ////////////////////////////////////////////////////////////////////////////////
@@ -31,22 +31,6 @@ Module::getDesign() const {
 
 // -----------------------------------------------------------------------------
 
-inline
-int 
-Module::generateNextSign() { 
-	return ++data->moduleData->sign; /*must be pre-increment*/ 
-} // end method
-
-// -----------------------------------------------------------------------------
-
-inline
-int 
-Module::getSign() const { 
-	return data->moduleData->sign; 
-} // end method
-
-// -----------------------------------------------------------------------------
-
 inline
 Cell 
 Module::createCell(const std::string &libraryCellName, const std::string &name) {
@@ -214,8 +198,12 @@ Module::getInstancesPerLogicalDepth(std::vector<std::vector<Rsyn::Instance>> &le
 inline
 void
 Module::getNetsPerLogicalDepth(std::vector<std::vector<Rsyn::Net>> &levels) {
-	levels.clear();
-	std::cout << "TODO: getLevelizedNets() not implemented\n";
+	const int numLevels = getNumNetLogicalDepths();
+	levels.resize(numLevels);
+	for (int i = 0; i < numLevels; i++) {
+		TopologicalOrder<Net> nets = allNetsAtLogicalDepth(i);
+		levels[i].assign(nets.begin(), nets.end());
+	} // end for
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -285,98 +273,212 @@ Module::allInterfaceArcs() const {
 // -----------------------------------------------------------------------------
 
 inline
-std::vector<TupleElement<1, TopologicalIndex, Pin>>
-Module::allPinsInTopologicalOrder() {
-	const int numNets = data->moduleData->nets.size();
+void
+Module::updateNetsInTopologicalOrder() {
+	ModuleData *moduleData = data->moduleData;
+
+	// Net levels depend on the net arcs, so this order is also invalidated by
+	// connectivity changes, which do not affect the pin and instance orders.
+	const int version = getDesign().getTopologyVersion();
+	const int connectivityVersion = getDesign().getConnectivityVersion();
+	if (moduleData->netsInTopologicalOrderVersion == version &&
+			moduleData->netsInTopologicalOrderConnectivityVersion == connectivityVersion)
+		return;
+
+	std::lock_guard<std::mutex> lock(moduleData->topologicalOrderMutex);
+	if (moduleData->netsInTopologicalOrderVersion == version &&
+			moduleData->netsInTopologicalOrderConnectivityVersion == connectivityVersion)
+		return; // updated by another thread
+
+	// Sort nets by topological index.
+	std::vector<std::tuple<TopologicalIndex, Net>> sortedNets;
+	sortedNets.reserve(moduleData->nets.size());
+
+	int maxId = -1;
+	for (Rsyn::Net net : allNets()) {
+		sortedNets.push_back(std::make_tuple(net.getTopologicalIndex(), net));
+		maxId = std::max(maxId, (int) net->id);
+	} // end for
+	std::sort(sortedNets.begin(), sortedNets.end());
+
+	// Compute the logical depth of the nets. The nets driving the incoming
+	// arcs of a driver have smaller topological indexes and hence are visited
+	// first.
+	std::vector<int> depth(maxId + 1, -1);
+	std::vector<int> count;
+	for (const std::tuple<TopologicalIndex, Net> &t : sortedNets) {
+		Rsyn::Net net = std::get<1>(t);
+
+		int lower = -1;
+		for (Rsyn::Pin driver : net.allPins(Rsyn::DRIVER)) {
+			for (Rsyn::Arc arc : driver.allIncomingArcs()) {
+				Rsyn::Net from = arc.getFromNet();
+				if (from && (int) from->id <= maxId)
+					lower = std::max(lower, depth[from->id]);
+			} // end for
+		} // end for
 
-	std::vector<TupleElement<1, TopologicalIndex, Pin>> sortedPins;
-	sortedPins.reserve(numNets*3);
+		const int level = lower + 1;
+		depth[net->id] = level;
+		if (count.size() <= level) {
+			count.resize(level + 1, 0);
+		} // end if
+		count[level]++;
+	} // end for
+
+	// Bucket nets by logical depth. Nets remain sorted by topological index
+	// inside each bucket.
+	std::vector<int> &levels = moduleData->netLevels;
+	levels.assign(count.size() + 1, 0);
+	for (int i = 0; i < count.size(); i++) {
+		levels[i + 1] = levels[i] + count[i];
+	} // end for
+
+	std::vector<int> offset(levels.begin(), levels.end() - 1);
+	moduleData->netsInTopologicalOrder.resize(sortedNets.size());
+	for (const std::tuple<TopologicalIndex, Net> &t : sortedNets) {
+		Rsyn::Net net = std::get<1>(t);
+		moduleData->netsInTopologicalOrder[offset[depth[net->id]]++] = net;
+	} // end for
+
+	moduleData->netsInTopologicalOrderVersion = version;
+	moduleData->netsInTopologicalOrderConnectivityVersion = connectivityVersion;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+void
+Module::updatePinsInTopologicalOrder() {
+	ModuleData *moduleData = data->moduleData;
+
+	const int version = getDesign().getTopologyVersion();
+	if (moduleData->pinsInTopologicalOrderVersion == version)
+		return;
+
+	std::lock_guard<std::mutex> lock(moduleData->topologicalOrderMutex);
+	if (moduleData->pinsInTopologicalOrderVersion == version)
+		return; // updated by another thread
+
+	std::vector<std::tuple<TopologicalIndex, Pin>> sortedPins;
+	sortedPins.reserve(moduleData->pinsInTopologicalOrder.size());
 
 	for (Rsyn::Instance instance : allInstances()) {
 		for (Rsyn::Pin pin : instance.allPins())
 			sortedPins.push_back(std::make_tuple(pin.getTopologicalIndex(), pin));
 	} // end for
-
 	std::sort(sortedPins.begin(), sortedPins.end());
-	return sortedPins;
+
+	std::vector<Pin> &pins = moduleData->pinsInTopologicalOrder;
+	pins.resize(sortedPins.size());
+	for (int i = 0; i < sortedPins.size(); i++) {
+		pins[i] = std::get<1>(sortedPins[i]);
+	} // end for
+
+	moduleData->pinsInTopologicalOrderVersion = version;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 inline
-std::vector<TupleElement<1, TopologicalIndex, Pin>>
-Module::allPinsInReverseTopologicalOrder() {
-	const int numNets = data->moduleData->nets.size();
+void
+Module::updateInstancesInTopologicalOrder() {
+	ModuleData *moduleData = data->moduleData;
+
+	const int version = getDesign().getTopologyVersion();
+	if (moduleData->instancesInTopologicalOrderVersion == version)
+		return;
 
-	std::vector<TupleElement<1, TopologicalIndex, Pin>> sortedPins;
-	sortedPins.reserve(numNets*3);
+	std::lock_guard<std::mutex> lock(moduleData->topologicalOrderMutex);
+	if (moduleData->instancesInTopologicalOrderVersion == version)
+		return; // updated by another thread
+
+	std::vector<std::tuple<TopologicalIndex, Instance>> sortedInstances;
+	sortedInstances.reserve(moduleData->instances.size());
 
 	for (Rsyn::Instance instance : allInstances()) {
-		for (Rsyn::Pin pin : instance.allPins())
-			sortedPins.push_back(std::make_tuple(-pin.getTopologicalIndex(), pin));
+		sortedInstances.push_back(std::make_tuple(instance.getTopologicalIndex(), instance));
 	} // end for
+	std::sort(sortedInstances.begin(), sortedInstances.end());
 
-	std::sort(sortedPins.begin(), sortedPins.end());
-	return sortedPins;
+	std::vector<Instance> &instances = moduleData->instancesInTopologicalOrder;
+	instances.resize(sortedInstances.size());
+	for (int i = 0; i < sortedInstances.size(); i++) {
+		instances[i] = std::get<1>(sortedInstances[i]);
+	} // end for
+
+	moduleData->instancesInTopologicalOrderVersion = version;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+TopologicalOrder<Pin>
+Module::allPinsInTopologicalOrder() {
+	updatePinsInTopologicalOrder();
+	const std::vector<Pin> &pins = data->moduleData->pinsInTopologicalOrder;
+	return TopologicalOrder<Pin>(pins.begin(), pins.end());
 } // end method
+
 // -----------------------------------------------------------------------------
 
 inline
-std::vector<TupleElement<1, TopologicalIndex, Net>>
+ReverseTopologicalOrder<Pin>
+Module::allPinsInReverseTopologicalOrder() {
+	updatePinsInTopologicalOrder();
+	const std::vector<Pin> &pins = data->moduleData->pinsInTopologicalOrder;
+	return ReverseTopologicalOrder<Pin>(pins.rbegin(), pins.rend());
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+TopologicalOrder<Net>
 Module::allNetsInTopologicalOrder() {
-	const int numNets = data->moduleData->nets.size();
-	
-	std::vector<TupleElement<1, TopologicalIndex, Net>> sortedNets;
-	sortedNets.resize(numNets);
-	
-	int i = 0;
-	for (Rsyn::Net net : allNets()) {
-		sortedNets[i++] = std::make_tuple(net.getTopologicalIndex(), net);
-	} // end for
-	sortedNets.resize(i);
-	std::sort(sortedNets.begin(), sortedNets.end());
-		
-	return sortedNets;
+	updateNetsInTopologicalOrder();
+	const std::vector<Net> &nets = data->moduleData->netsInTopologicalOrder;
+	return TopologicalOrder<Net>(nets.begin(), nets.end());
 } // end method
 
 // -----------------------------------------------------------------------------
 
 inline
-std::vector<TupleElement<1, TopologicalIndex, Net>>
+ReverseTopologicalOrder<Net>
 Module::allNetsInReverseTopologicalOrder() {
-	const int numNets = data->moduleData->nets.size();
-	
-	std::vector<TupleElement<1, TopologicalIndex, Net>> sortedNets;
-	sortedNets.resize(numNets);
-	
-	int i = 0;
-	for (Rsyn::Net net : allNets()) {
-		sortedNets[i++] = std::make_tuple(-net.getTopologicalIndex(), net);
-	} // end for
-	sortedNets.resize(i);
-	std::sort(sortedNets.begin(), sortedNets.end());
-		
-	return sortedNets;
+	updateNetsInTopologicalOrder();
+	const std::vector<Net> &nets = data->moduleData->netsInTopologicalOrder;
+	return ReverseTopologicalOrder<Net>(nets.rbegin(), nets.rend());
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+int
+Module::getNumNetLogicalDepths() {
+	updateNetsInTopologicalOrder();
+	return std::max(0, (int) data->moduleData->netLevels.size() - 1);
 } // end method
 
 // -----------------------------------------------------------------------------
 
 inline
-std::vector<TupleElement<1, TopologicalIndex, Instance>>
+TopologicalOrder<Net>
+Module::allNetsAtLogicalDepth(const int depth) {
+	updateNetsInTopologicalOrder();
+	const std::vector<Net> &nets = data->moduleData->netsInTopologicalOrder;
+	const std::vector<int> &levels = data->moduleData->netLevels;
+	return TopologicalOrder<Net>(
+			nets.begin() + levels[depth], nets.begin() + levels[depth + 1]);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+TopologicalOrder<Instance>
 Module::allInstancesInTopologicalOrder() {
-	const int numInstances = data->moduleData->instances.size();
-	
-	std::vector<TupleElement<1, TopologicalIndex, Instance>> sortedInstances;
-	sortedInstances.resize(numInstances);
-	
-	int i = 0;
-	for (Rsyn::Instance instance : allInstances()) {
-		sortedInstances[i++] = std::make_tuple(instance.getTopologicalIndex(), instance);
-	} // end for
-	sortedInstances.resize(i);
-	std::sort(sortedInstances.begin(), sortedInstances.end());
-		
-	return sortedInstances;
+	updateInstancesInTopologicalOrder();
+	const std::vector<Instance> &instances = data->moduleData->instancesInTopologicalOrder;
+	return TopologicalOrder<Instance>(instances.begin(), instances.end());
 } // end method
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -395,23 +497,22 @@ Module::getFanoutConeNetsInBreadthFirstOrder(Rsyn::Pin seed) {
 		open.push(net);
 	
 	// Breadth-first search.
-	const int sign = generateNextSign();
+	VisitationMarker visited;
 	
 	while (!open.empty()) {
 		Rsyn::Net currentNet = open.front();
 		open.pop();
 		
-		if (currentNet->sign == sign)
+		if (!visited.visit(currentNet->id))
 			continue;
 		
-		currentNet->sign = sign;
 		result.push_back(currentNet);
 		
 		// Add neighbors.
 		for (Rsyn::Pin sink : currentNet.allPins(SINK)) {
 			for (Rsyn::Arc arc : sink.allOutgoingArcs()) {
 				Rsyn::Net net = arc.getToNet();
-				if (net && net->sign != sign)
+				if (net && !visited.isVisited(net->id))
 					open.push(net);				
 			} // end for
 		} // end for
@@ -435,23 +536,22 @@ Module::getFaninConeNetsInBreadthFirstOrder(Rsyn::Pin seed) {
 		open.push(net);
 	
 	// Breadth-first search.
-	const int sign = generateNextSign();
+	VisitationMarker visited;
 	
 	while (!open.empty()) {
 		Rsyn::Net currentNet = open.front();
 		open.pop();
 		
-		if (currentNet->sign == sign)
+		if (!visited.visit(currentNet->id))
 			continue;
 		
-		currentNet->sign = sign;
 		result.push_back(currentNet);
 		
 		// Add neighbors.
 		for (Rsyn::Pin driver : currentNet.allPins(DRIVER)) {
 			for (Rsyn::Arc arc : driver.allIncomingArcs()) {
 				Rsyn::Net net = arc.getFromNet();
-				if (net && net->sign != sign)
+				if (net && !visited.isVisited(net->id))
 					open.push(net);		
 			} // end for
 		} // end for
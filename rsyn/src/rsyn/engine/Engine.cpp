@@ -29,6 +29,7 @@
 
 #include "rsyn/3rdparty/json/json.hpp"
 #include "rsyn/util/Environment.h"
+#include "rsyn/util/MemoryUsage.h"
 
 namespace Rsyn {
 
@@ -308,6 +309,46 @@ void Engine::registerDefaultCommands() {
 			} // end if-else 
 		});
 	} // end block
+
+	{ // reportMemory
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("reportMemory");
+		dscp.setDescription("Report the memory used by the netlist and by the running services.");
+
+		registerCommand(dscp, [&](Engine engine, const ScriptParsing::Command &command) {
+			reportMemoryUsage(std::cout);
+		});
+	} // end block
+} // end method
+
+// -----------------------------------------------------------------------------
+
+MemoryReport Engine::getMemoryUsage() {
+	MemoryReport report;
+
+	if (data->clsDesign) {
+		MemoryReport netlist;
+		data->clsDesign.reportMemoryUsage(netlist);
+		report.merge("netlist", netlist);
+	} // end if
+
+	for (auto it : data->clsRunningServices) {
+		MemoryReport service;
+		it.second->reportMemoryUsage(service);
+		report.merge(it.first, service);
+	} // end for
+
+	data->clsPeakMemoryUsage.updatePeaks(report);
+	return report;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Engine::reportMemoryUsage(std::ostream &out) {
+	const MemoryReport report = getMemoryUsage();
+	report.print(out, &data->clsPeakMemoryUsage);
+	out << "Process (MB): current = " << MemoryUsage::getCurrentMemoryUsage()
+			<< ", peak = " << MemoryUsage::getMemoryUsage() << "\n";
 } // end method
 
 } /* namespace Rsyn */
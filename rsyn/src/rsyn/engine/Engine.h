@@ -38,6 +38,7 @@
 #include "rsyn/core/Rsyn.h"
 #include "rsyn/util/Logger.h"
 #include "rsyn/util/Units.h"
+#include "rsyn/util/Parallel.h"
 
 namespace Rsyn {
 
@@ -142,6 +143,11 @@ struct EngineData {
 	ScriptParsing::CommandManager clsCommandManager;
 	
 	std::function<void(const GraphicsEvent event)> clsGraphicsCallback = nullptr;
+
+	////////////////////////////////////////////////////////////////////////////
+	// Memory
+	////////////////////////////////////////////////////////////////////////////
+	MemoryReport clsPeakMemoryUsage;
 }; // end struct
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -435,6 +441,27 @@ public:
 
 	const std::string &getInstallationPath() const { return data->clsInstallationPath; }
 
+	//! @brief Returns the thread pool shared by services and processes. Prefer
+	//!        parallel_for() and parallel_reduce() (see Parallel.h) over
+	//!        spawning threads.
+	ThreadPool &getThreadPool() { return getSharedThreadPool(); }
+
+	////////////////////////////////////////////////////////////////////////////
+	// Memory
+	////////////////////////////////////////////////////////////////////////////
+
+	//! @brief Returns the memory used by the netlist and by each running
+	//!        service (see Service::reportMemoryUsage()). Also updates the
+	//!        peak values.
+	MemoryReport getMemoryUsage();
+
+	//! @brief Returns the peak values seen by getMemoryUsage().
+	const MemoryReport &getPeakMemoryUsage() const { return data->clsPeakMemoryUsage; }
+
+	//! @brief Prints the current and peak memory usage by category along with
+	//!        the memory used by the process.
+	void reportMemoryUsage(std::ostream &out);
+
 	////////////////////////////////////////////////////////////////////////////
 	// Script
 	////////////////////////////////////////////////////////////////////////////
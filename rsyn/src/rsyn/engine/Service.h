@@ -21,6 +21,7 @@
 namespace Rsyn {
 
 class Engine;
+class MemoryReport;
 typedef nlohmann::json Json;
 
 enum ServiceRequestType {
@@ -32,6 +33,10 @@ class Service {
 public:
 	virtual void start(Engine engine, const Json &params) = 0;
 	virtual void stop() = 0;
+
+	//! @brief Adds the memory used by this service to a report, by category.
+	//!        Services holding large data structures should override it.
+	virtual void reportMemoryUsage(MemoryReport &report) {}
 }; // end class
 
 } // end namespace
@@ -573,5 +573,15 @@ void Report::reportTree(Rsyn::Net net) {
 	std::cout << std::flush;
 } // end method 
 
+// -----------------------------------------------------------------------------
+
+void Report::reportMemory() {
+	std::cout << "================================================================================\n";
+	std::cout << "Report Memory" << "\n";
+	std::cout << "================================================================================\n";
+	clsEngine.reportMemoryUsage(std::cout);
+	std::cout << "\n";
+	std::cout << std::flush;
+} // end method 
 
 } // end namespace
\ No newline at end of file
@@ -73,6 +73,9 @@ public:
 	void reportNet(Rsyn::Net net, const bool late = true, const bool early = false);
 	void reportTree(Rsyn::Net net);
 	
+	// Misc
+	void reportMemory();
+	
 }; // end class
 
 } // end namespace
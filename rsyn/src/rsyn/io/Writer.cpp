@@ -16,7 +16,10 @@
 #include "Writer.h"
 
 #include <iostream>
+#include <fstream>
 #include <string>
+#include <algorithm>
+#include <functional>
 
 #include "rsyn/engine/Engine.h"
 #include "rsyn/io/legacy/Legacy.h"
@@ -27,6 +30,12 @@
 #include "rsyn/model/routing/RoutingEstimator.h"
 
 #include "rsyn/io/parser/lef_def/DEFControlParser.h"
+#include "rsyn/io/parser/lef_def/DEFWriter.h"
+#include "rsyn/io/parser/DescriptorSerialization.h"
+#include "rsyn/io/parser/SnapshotFormat.h"
+#include "rsyn/phy/util/PhysicalUtil.h"
+#include "rsyn/util/Parallel.h"
+#include "rsyn/util/Hash.h"
 namespace Rsyn {
 
 void Writer::start(Engine engine, const Json &params) {
@@ -50,11 +59,20 @@ void Writer::start(Engine engine, const Json &params) {
 				ScriptParsing::PARAM_SPEC_OPTIONAL,
 				"DEF file name.",
 				"");
+
+		dscp.addNamedParam("full",
+				ScriptParsing::PARAM_TYPE_BOOLEAN,
+				ScriptParsing::PARAM_SPEC_OPTIONAL,
+				"Also write the die area, rows, pins and nets.",
+				"false");
 		
 		engine.registerCommand(dscp, [&](Engine engine, const ScriptParsing::Command &command) {
 			const std::string fileName = command.getParam("fileName");
+			const bool full = command.getParam("full");
 			
-			if(fileName != "")
+			if (full)
+				writeFullDEF(fileName != "" ? fileName : clsDesign.getName() + ".def");
+			else if(fileName != "")
 				writeDEF(fileName);
 			else writeDEF();
 		});
@@ -129,159 +147,332 @@ void Writer::start(Engine engine, const Json &params) {
 			writeBookshelf2(path);
 		});
 	} // end block
+
+	{ // createPlacementBaseline
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("createPlacementBaseline");
+		dscp.setDescription("Record the current placement as a baseline for placement deltas.");
+
+		dscp.addPositionalParam( "name",
+				ScriptParsing::PARAM_TYPE_STRING,
+				ScriptParsing::PARAM_SPEC_MANDATORY,
+				"Baseline name.");
+
+		engine.registerCommand(dscp, [&](Engine engine, const ScriptParsing::Command &command) {
+			const std::string name = command.getParam("name");
+			createPlacementBaseline(name);
+		});
+	} // end block
+
+	{ // writePlacementDelta
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("writePlacementDelta");
+		dscp.setDescription("Write the cells moved or remapped since a placement baseline.");
+
+		dscp.addPositionalParam( "baseline",
+				ScriptParsing::PARAM_TYPE_STRING,
+				ScriptParsing::PARAM_SPEC_MANDATORY,
+				"Baseline name.");
+
+		dscp.addPositionalParam( "fileName",
+				ScriptParsing::PARAM_TYPE_STRING,
+				ScriptParsing::PARAM_SPEC_OPTIONAL,
+				"Delta file name.",
+				"");
+
+		engine.registerCommand(dscp, [&](Engine engine, const ScriptParsing::Command &command) {
+			const std::string baseline = command.getParam("baseline");
+			const std::string fileName = command.getParam("fileName");
+
+			writePlacementDelta(baseline, fileName != "" ? fileName :
+					clsDesign.getName() + "-" + baseline + ".delta");
+		});
+	} // end block
+
+	{ // writeSnapshot
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("writeSnapshot");
+		dscp.setDescription("Write a binary snapshot of the design, which can be loaded by the snapshot reader. The design must be loaded with the reader parameter \"snapshots\".");
+
+		dscp.addPositionalParam( "fileName",
+				ScriptParsing::PARAM_TYPE_STRING,
+				ScriptParsing::PARAM_SPEC_OPTIONAL,
+				"Snapshot file name.",
+				"");
+
+		engine.registerCommand(dscp, [&](Engine engine, const ScriptParsing::Command &command) {
+			const std::string fileName = command.getParam("fileName");
+			writeSnapshot(fileName != "" ? fileName : clsDesign.getName() + ".snapshot");
+		});
+	} // end block
 } // end method
 
 // -----------------------------------------------------------------------------
 
 void Writer::stop() {
+	if (clsTrackingPlacementChanges) {
+		clsPhysicalDesign.deletePostInstanceMovedCallback(clsPostInstanceMovedCallbackHandler);
+		clsDesign.unregisterObserver(this);
+		clsTrackingPlacementChanges = false;
+	} // end if
+	clsPlacementBaselines.clear();
 } // end method
 
 // -----------------------------------------------------------------------------
 
 void Writer::writeFullDEF(string filename) {
-	cout << "TODO "<<__func__<<" in file " << __FILE__<< "\n";
-//	DEFControlParser defParser;
-//	DefStruct defStruct;
-//
-//	defStruct.dieArea = clsPhysicalDesign.getDieBounds();
-//	defStruct.designName = clsDesign.getName();
-//	defStruct.designUnits = clsPhysicalDesign.getDesignUnits();
-//
-//	int numCells = getNumCellsExcludingPorts();
-//	defStruct.clsDefMacros.resize(numCells);
-//	int pos = 0;
-//	for (Rsyn::Instance instance : clsModule.allCells()) {
-//		Rsyn::Cell cell  = instance.asCell(); // TODO: hack, assuming that the instance is a cell
-//
-//		if (cell.isPort())
-//			continue;
-//
-//		PhysicalCell &ph = getPhysicalCell(cell);
-//		DefStruct::DefMacro &defMacro = defStruct.clsDefMacros[pos++];
-//		defMacro.name = cell.getName();
-//		defMacro.lefCellName = cell.getLibraryCellName();
-//		defMacro.pos = ph.getLowerPosition();
-//		defMacro.placed = ph.getIsPlaced();
-//		defMacro.fixed = ph.isFixed();
-//	} // end for
-//
-//	int numNets = getNumNets();
-//	defStruct.clsDefConnections.resize(numNets);
-//	int posNets = 0;
-//	for (Rsyn::Net net : clsModule.allNets()) {
-//		int numPins = net.getNumPins();
-//		DefStruct::DefConnection &defConn = defStruct.clsDefConnections[posNets++];
-//		defConn.pins.resize(numPins);
-//		defConn.netName = net.getName();
-//		int pinPos = 0;
-//		for(Rsyn::Pin pin : net.allPins()){
-//			if(pin.getCell(.isPort())){
-//				DefStruct::DefPin & defPin = defConn.pins[pinPos++];
-//				defPin.cellName = "PIN";
-//				defPin.pinName = pin.getInstanceName();
-//			} // end if
-//		} // end for
-//		for(Rsyn::Pin pin : net.allPins()){
-//			if(pin.getCell(.isPort()))
-//				continue;
-//			DefStruct::DefPin & defPin = defConn.pins[pinPos++];
-//			defPin.pinName = pin.getName();
-//			defPin.cellName = pin.getInstanceName();
-//		} // end for
-//	} // end for
-//
-//	int numPorts = getNumInstances(Rsyn::PORT);
-//	defStruct.clsDefPorts.resize(numPorts);
-//	int portPos = 0;
-//	for(Rsyn::Cell cell : clsModule.allPorts(Rsyn::IN)) {
-//		DefStruct::DefPort &defPort = defStruct.clsDefPorts[portPos++];
-//		defPort.portName = cell.getName();
-//		defPort.netName = cell.getName();
-//		//if(cell.isInputPort())
-//		defPort.direction = "INPUT";
-//		//if(cell.isOutputPort())
-//		//	defPort.direction = "OUTPUT";
-//		defPort.status = "FIXED";
-//		defPort.orient = 0;
-//		defPort.clsDefPortLayer.layerName = "metal4";
-//		defPort.clsDefPortLayer.bounds = Rectangle(0,0,50,50);
-//		DBUxy pos = getCellPosition(cell);
-//		defPort.statusX = (int)pos[X];
-//		defPort.statusY = (int)pos[Y];
-//	} // end for
-//	for(Rsyn::Cell cell : clsModule.allPorts(Rsyn::OUT)) {
-//		DefStruct::DefPort &defPort = defStruct.clsDefPorts[portPos++];
-//		defPort.portName = cell.getName();
-//		defPort.netName = cell.getName();
-//		//if(cell.isInputPort())
-//		//	defPort.direction = "INPUT";
-//		//if(cell.isOutputPort())
-//		defPort.direction = "OUTPUT";
-//		defPort.orient = 0;
-//		DBUxy pos = getCellPosition(cell);
-//		defPort.clsDefPortLayer.layerName = "metal4";
-//		defPort.clsDefPortLayer.bounds = Rectangle(0,0,50,50);
-//		defPort.status = "FIXED";
-//		defPort.statusX = (int)pos[X];
-//		defPort.statusY = (int)pos[Y];
-//	} // end for
-//
-//	int numRows = clsPhysicalDesign.getNumRows();
-//	defStruct.clsDefRows.resize(numRows);
-//	int posRow = 0;
-//	for(const Rsyn::PhysicalRow &phRow : clsPhysicalDesign.getPhysicalRows()) {
-//		DefStruct::DefRow &defRow = defStruct.clsDefRows[posRow++];
-//		defRow.rowName = phRow.getRowName();
-//		defRow.rowType = phRow.getRowSiteName();
-//		defRow.origX = phRow.getRowOrigenX();
-//		defRow.origY = phRow.getRowOrigenY();
-//		defRow.xStep = (int) phRow.getRowStepX();
-//		defRow.yStep = 0; // Hard Coded -> TODO
-//		defRow.doIncrement = phRow.getRowNumSiteX();
-//		defRow.doCount = phRow.getRowNumSiteY();
-//	} // end for
-//
-//	defParser.writeFullDEF(filename, defStruct);
+	Stepwatch watch("Writing DEF file");
+	DEFWriter writer(clsDesign, clsPhysicalDesign);
+	writer.write(filename, true);
 } // end method
 
 // -----------------------------------------------------------------------------
 
 void Writer::writeDEF(std::string defFile) {
-	DEFControlParser defParser;
-	std::vector<Legacy::Design::Component> components; //data structure used to write def file for iccad 2014 contest
-	std::vector<DefComponentDscp> comps;
-
-	int numCells = clsDesign.getNumInstances(Rsyn::CELL);
-	components.resize(numCells);
-	comps.reserve(numCells);
-	int pos = 0;
+	Stepwatch watch("Writing DEF file");
+	DEFWriter writer(clsDesign, clsPhysicalDesign);
+	writer.write(defFile, false);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Writer::setSnapshotInputs(const std::string &library, const DefDscp &floorplan) {
+	clsSnapshotLibrary = library;
+	clsSnapshotFloorplan = floorplan;
+	clsHasSnapshotInputs = true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+bool Writer::writeSnapshot(const std::string &filename) {
+	if (!clsHasSnapshotInputs) {
+		std::cout << "[ERROR] The design was not loaded with snapshots "
+				"enabled (reader parameter \"snapshots\").\n";
+		return false;
+	} // end if
+
+	Stepwatch watch("Writing snapshot");
+
+	// The floorplan is kept as read, while ports, components and nets are
+	// taken from the current design.
+	DefDscp def = clsSnapshotFloorplan;
+	def.clsDesignName = clsDesign.getName();
+
+	std::map<std::string, int> floorplanPorts;
+	for (int i = 0; i < (int) clsSnapshotFloorplan.clsPorts.size(); i++)
+		floorplanPorts[clsSnapshotFloorplan.clsPorts[i].clsName] = i;
+
+	def.clsPorts.clear();
+	for (Rsyn::Port port : clsModule.allPorts()) {
+		auto it = floorplanPorts.find(port.getName());
+		if (it != floorplanPorts.end()) {
+			def.clsPorts.push_back(clsSnapshotFloorplan.clsPorts[it->second]);
+			continue;
+		} // end if
+
+		Rsyn::Net net = port.getInnerPin().getNet();
+		def.clsPorts.resize(def.clsPorts.size() + 1);
+		DefPortDscp &dscp = def.clsPorts.back();
+		dscp.clsName = port.getName();
+		dscp.clsNetName = net ? net.getName() : port.getName();
+		dscp.clsDirection = port.getDirection() == Rsyn::IN ? "INPUT" : "OUTPUT";
+		dscp.clsLocationType = "FIXED";
+		dscp.clsPos = clsPhysicalDesign.getPhysicalPort(port).getPosition();
+		dscp.clsOrientation = "N";
+	} // end for
+
 	for (Rsyn::Instance instance : clsModule.allInstances()) {
-		Rsyn::Cell cell = instance.asCell(); // TODO: hack, assuming that the instance is a cell
+		if (instance.getType() != Rsyn::CELL)
+			continue;
 
-		if (cell.isPort())
+		Rsyn::Cell cell = instance.asCell();
+		Rsyn::PhysicalCell physicalCell = clsPhysicalDesign.getPhysicalCell(cell);
+
+		def.clsComps.resize(def.clsComps.size() + 1);
+		DefComponentDscp &dscp = def.clsComps.back();
+		dscp.clsName = cell.getName();
+		dscp.clsMacroName = cell.getLibraryCellName();
+		dscp.clsLocationType = instance.isFixed() ? "FIXED" : "PLACED";
+		dscp.clsPos = physicalCell.getPosition();
+		dscp.clsOrientation = getPhysicalOrientation(physicalCell.getOrientation());
+		dscp.clsIsFixed = instance.isFixed();
+		dscp.clsIsPlaced = true;
+	} // end for
+
+	for (Rsyn::Net net : clsModule.allNets()) {
+		def.clsNets.resize(def.clsNets.size() + 1);
+		DefNetDscp &dscp = def.clsNets.back();
+		dscp.clsName = net.getName();
+		for (Rsyn::Pin pin : net.allPins()) {
+			Rsyn::Instance instance = pin.getInstance();
+			DefNetConnection connection;
+			if (instance.getType() == Rsyn::PORT) {
+				connection.clsComponentName = "PIN";
+				connection.clsPinName = instance.getName();
+			} else {
+				connection.clsComponentName = instance.getName();
+				connection.clsPinName = pin.getName();
+			} // end else
+			dscp.clsConnections.push_back(connection);
+		} // end for
+	} // end for
+
+	std::ofstream out(filename, std::ios::binary);
+	if (!out) {
+		std::cout << "[ERROR] Could not open snapshot file: " << filename << "\n";
+		return false;
+	} // end if
+
+	// Layout described in SnapshotFormat.h. The design section must match
+	// GenericReader::serializeSnapshotDesign().
+	BinaryOutputArchive ar(out);
+	ar.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	ar & SNAPSHOT_VERSION;
+	ar.write(clsSnapshotLibrary.data(), clsSnapshotLibrary.size());
+
+	bool enableNetlistFromVerilog = false;
+	ar & enableNetlistFromVerilog;
+	ar & def;
+
+	out.flush();
+	if (!out) {
+		std::cout << "[ERROR] Could not write snapshot file: " << filename << "\n";
+		return false;
+	} // end if
+
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Writer::createPlacementBaseline(const std::string &name) {
+	if (!clsTrackingPlacementChanges) {
+		clsPostInstanceMovedCallbackHandler =
+				clsPhysicalDesign.addPostInstanceMovedCallback(0, [&](Rsyn::PhysicalInstance instance) {
+			markPlacementChange(instance.getInstance());
+		});
+		clsDesign.registerObserver(this);
+		clsTrackingPlacementChanges = true;
+	} // end if
+
+	PlacementBaseline &baseline = clsPlacementBaselines[name];
+	baseline.cells = clsDesign.createAttribute();
+	baseline.changedCells.clear();
+
+	parallel_for(clsModule.allInstances(), [&](Rsyn::Instance instance) {
+		if (instance.getType() != Rsyn::CELL)
+			return;
+
+		PlacementBaselineCell &entry = baseline.cells[instance];
+		entry.position = clsPhysicalDesign.getPhysicalCell(instance.asCell()).getPosition();
+		entry.libraryCell = instance.asCell().getLibraryCell();
+		entry.valid = true;
+		entry.changed = false;
+	});
+
+	baseline.digest = computePlacementDigest(clsModule, clsPhysicalDesign);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+bool Writer::writePlacementDelta(const std::string &baselineName, const std::string &filename) {
+	auto it = clsPlacementBaselines.find(baselineName);
+	if (it == clsPlacementBaselines.end()) {
+		std::cout << "[ERROR] Placement baseline '" << baselineName << "' not found.\n";
+		return false;
+	} // end if
+
+	PlacementBaseline &baseline = it->second;
+
+	// Cells moved back to their baseline placement are not written.
+	std::vector<Rsyn::Cell> cells;
+	cells.reserve(baseline.changedCells.size());
+	for (Rsyn::Instance instance : baseline.changedCells) {
+		const PlacementBaselineCell &entry = baseline.cells[instance];
+		Rsyn::Cell cell = instance.asCell();
+		if (clsPhysicalDesign.getPhysicalCell(cell).getPosition() == entry.position &&
+				cell.getLibraryCell() == entry.libraryCell)
 			continue;
+		cells.push_back(cell);
+	} // end for
+
+	std::ofstream file(filename);
+	if (!file) {
+		std::cout << "[ERROR] Could not open output file: " << filename << "\n";
+		return false;
+	} // end if
+
+	file << "RSYN-PLACEMENT-DELTA 2\n";
+	file << "DESIGN " << clsDesign.getName() << "\n";
+	file << "BASELINE " << baselineName << "\n";
+	file << "BASELINE-DIGEST " << std::hex << baseline.digest << std::dec << "\n";
+	file << "CELLS " << cells.size() << "\n";
+	for (Rsyn::Cell cell : cells) {
+		const DBUxy pos = clsPhysicalDesign.getPhysicalCell(cell).getPosition();
+		file << cell.getName() << " " << pos[X] << " " << pos[Y] << " "
+				<< cell.getLibraryCellName() << "\n";
+	} // end for
+	file << "END\n";
+
+	return (bool) file;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+std::uint64_t Writer::computePlacementDigest(Rsyn::Module module,
+		Rsyn::PhysicalDesign physicalDesign) {
+	// FNV-1a of each cell, which are then summed up so that the order of the
+	// cells does not matter.
+	return parallel_reduce(module.allInstances(), (std::uint64_t) 0,
+			[&](Rsyn::Instance instance) {
+		if (instance.getType() != Rsyn::CELL)
+			return (std::uint64_t) 0;
+
+		Rsyn::Cell cell = instance.asCell();
+		const std::string &name = cell.getName();
+		const std::string &libraryCellName = cell.getLibraryCellName();
+		const DBUxy pos = physicalDesign.getPhysicalCell(cell).getPosition();
+		const std::int64_t coordinates[2] = {pos[X], pos[Y]};
+
+		std::uint64_t h = Hash::fnv1a(name.data(), name.size() + 1);
+		h = Hash::fnv1a(libraryCellName.data(), libraryCellName.size() + 1, h);
+		h = Hash::fnv1a(coordinates, sizeof(coordinates), h);
+		return h;
+	}, std::plus<std::uint64_t>());
+} // end method
+
+// -----------------------------------------------------------------------------
 
-		const PhysicalCell &ph = clsPhysicalDesign.getPhysicalCell(cell);
-
-		comps.push_back(DefComponentDscp());
-		DefComponentDscp &defComp = comps.back();
-		defComp.clsName = cell.getName();
-		defComp.clsMacroName = cell.getLibraryCellName();
-		defComp.clsPos = ph.getPosition();
-		defComp.clsIsFixed = instance.isFixed();
-		defComp.clsIsPlaced = true;
-
-//		Design::Component component;
-//		component.name = cell.getName();
-//		component.id = cell.getLibraryCellName();
-//		component.x = clsPhysicalDesign.getCellPosition(cell, X);
-//		component.y = clsPhysicalDesign.getCellPosition(cell, Y);
-//		component.placed = true;
-//		component.fixed = isFixed(cell);
-//		components[pos++] = component;
-	}
-//	defParser.writeDEF(defFile, clsDesign.getName(), components);
-	defParser.writeDEF(defFile, clsDesign.getName(), comps);
+void Writer::markPlacementChange(Rsyn::Instance instance) {
+	for (auto &element : clsPlacementBaselines) {
+		PlacementBaseline &baseline = element.second;
+		PlacementBaselineCell &entry = baseline.cells[instance];
+		if (entry.valid && !entry.changed) {
+			entry.changed = true;
+			baseline.changedCells.push_back(instance);
+		} // end if
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Writer::onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) {
+	markPlacementChange(cell);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Writer::onPreInstanceRemove(Rsyn::Instance instance) {
+	for (auto &element : clsPlacementBaselines) {
+		PlacementBaseline &baseline = element.second;
+		PlacementBaselineCell &entry = baseline.cells[instance];
+		if (entry.changed) {
+			std::vector<Rsyn::Instance> &changedCells = baseline.changedCells;
+			changedCells.erase(std::find(changedCells.begin(), changedCells.end(), instance));
+		} // end if
+		entry.valid = false;
+		entry.changed = false;
+	} // end for
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -16,10 +16,15 @@
 #ifndef RSYN_WRITER_H
 #define RSYN_WRITER_H
 
+#include <map>
+#include <vector>
+#include <cstdint>
+
 #include "rsyn/core/Rsyn.h"
 #include "rsyn/phy/PhysicalDesign.h"
 #include "rsyn/engine/Service.h"
 #include "rsyn/engine/Engine.h"
+#include "rsyn/phy/util/DefDescriptors.h"
 
 namespace Rsyn {
 class PhysicalService;
@@ -30,7 +35,7 @@ namespace Rsyn {
 class Timer;
 class RoutingEstimator;
 
-class Writer : public Service {
+class Writer : public Service, public Rsyn::Observer {
 private:
 	// Engine
 	Engine clsEngine;
@@ -47,6 +52,34 @@ private:
 	Timer * clsTimer = nullptr;
 	RoutingEstimator * clsRoutingEstimator = nullptr;
 
+	// Placement of a cell when the baseline was created.
+	struct PlacementBaselineCell {
+		DBUxy position;
+		Rsyn::LibraryCell libraryCell;
+		bool valid = false;
+		bool changed = false;
+	}; // end struct
+
+	// Cells moved or remapped since the baseline was created are tracked, so
+	// a delta can be written without visiting the whole design.
+	struct PlacementBaseline {
+		Rsyn::Attribute<Rsyn::Instance, PlacementBaselineCell> cells;
+		std::vector<Rsyn::Instance> changedCells;
+		std::uint64_t digest = 0;
+	}; // end struct
+
+	std::map<std::string, PlacementBaseline> clsPlacementBaselines;
+	bool clsTrackingPlacementChanges = false;
+	Rsyn::PhysicalDesign::PostInstanceMovedCallbackHandler clsPostInstanceMovedCallbackHandler;
+
+	void markPlacementChange(Rsyn::Instance instance);
+
+	// Inputs of snapshots that do not change during the session (see
+	// setSnapshotInputs()).
+	std::string clsSnapshotLibrary;
+	DefDscp clsSnapshotFloorplan;
+	bool clsHasSnapshotInputs = false;
+
 public:
 
 	virtual void start(Engine engine, const Json &params);
@@ -69,6 +102,40 @@ public:
 	void writePlacedBookshelf(const std::string & path = ".");
 	void writeSPEFFile(ostream &out, const bool onlyFixed = false);
 
+	//! @brief Records the current placement (positions and library cells) as
+	//!        a baseline for placement deltas. An existing baseline with the
+	//!        same name is replaced.
+	void createPlacementBaseline(const std::string &name);
+
+	//! @brief Writes the cells moved or remapped since a baseline. The delta
+	//!        can be applied on top of the baseline placement by the
+	//!        loadDesignPosition reader. Returns false if the baseline does not
+	//!        exist or the file could not be written.
+	bool writePlacementDelta(const std::string &baseline, const std::string &filename);
+
+	//! @brief Returns a digest of the placement (names, positions and library
+	//!        cells of all cells), which does not depend on the order of the
+	//!        cells. Placement deltas store the digest of their baseline, so
+	//!        they are only applied on top of it.
+	static std::uint64_t computePlacementDigest(Rsyn::Module module,
+			Rsyn::PhysicalDesign physicalDesign);
+
+	//! @brief Sets the serialized library section and the floorplan (DEF
+	//!        without components and nets) used to write snapshots. Called by
+	//!        the readers once the design is loaded.
+	void setSnapshotInputs(const std::string &library, const DefDscp &floorplan);
+
+	//! @brief Writes a binary snapshot of the current design, which can be
+	//!        loaded by the snapshot reader. Returns false if no snapshot
+	//!        inputs were set or the file could not be written.
+	bool writeSnapshot(const std::string &filename);
+
+	virtual void
+	onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) override;
+
+	virtual void
+	onPreInstanceRemove(Rsyn::Instance instance) override;
+
 	// Debug function. Should be rethought...
 	void printTimingPropagation(ostream &out, bool newLine = false );
 
@@ -0,0 +1,188 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_BINARY_ARCHIVE_H
+#define RSYN_BINARY_ARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+#include "rsyn/core/infra/Exception.h"
+
+namespace Rsyn {
+
+// Archives used to store data structures in a compact binary format. A type
+// is made serializable by providing, in its own namespace, a function
+//
+//    template<class Archive> void serialize(Archive &ar, Type &obj);
+//
+// which lists its fields (e.g. ar & obj.x & obj.y). The same function is used
+// for saving and loading. Binary data is stored in the native byte order, so
+// it should not be moved among machines with different architectures.
+
+//! @brief Writes data to a binary stream.
+class BinaryOutputArchive {
+public:
+
+	BinaryOutputArchive(std::ostream &out) : clsOut(out) {}
+
+	template<typename T>
+	BinaryOutputArchive &operator&(const T &value) {
+		save(value);
+		return *this;
+	} // end method
+
+	//! @brief Writes raw bytes.
+	void write(const void *data, const std::size_t size) {
+		clsOut.write(static_cast<const char *>(data), size);
+	} // end method
+
+private:
+
+	std::ostream &clsOut;
+
+	template<typename T>
+	typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+	save(const T &value) {
+		write(&value, sizeof(T));
+	} // end method
+
+	template<typename T>
+	typename std::enable_if<std::is_class<T>::value>::type
+	save(const T &value) {
+		serialize(*this, const_cast<T &>(value));
+	} // end method
+
+	void save(const std::string &value) {
+		const std::uint64_t size = value.size();
+		write(&size, sizeof(size));
+		write(value.data(), size);
+	} // end method
+
+	template<typename T>
+	void save(const std::vector<T> &value) {
+		const std::uint64_t size = value.size();
+		write(&size, sizeof(size));
+		if (std::is_arithmetic<T>::value) {
+			write(value.data(), size * sizeof(T));
+		} else {
+			for (const T &element : value)
+				save(element);
+		} // end else
+	} // end method
+
+	void save(const std::vector<bool> &value) {
+		const std::uint64_t size = value.size();
+		write(&size, sizeof(size));
+		for (const bool element : value)
+			save(element);
+	} // end method
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+//! @brief Reads data from a binary buffer (e.g. a memory mapped file). Throws
+//!        an exception if the buffer is too short.
+class BinaryInputArchive {
+public:
+
+	BinaryInputArchive(const char *begin, const char *end) :
+		clsCurrent(begin), clsEnd(end) {}
+
+	template<typename T>
+	BinaryInputArchive &operator&(T &value) {
+		load(value);
+		return *this;
+	} // end method
+
+	//! @brief Reads raw bytes.
+	void read(void *data, const std::size_t size) {
+		std::memcpy(data, skip(size), size);
+	} // end method
+
+	//! @brief Returns a pointer to the next bytes and skips them.
+	const char *skip(const std::size_t size) {
+		if (size > (std::size_t) (clsEnd - clsCurrent))
+			throw Exception("Unexpected end of binary data.");
+		const char *data = clsCurrent;
+		clsCurrent += size;
+		return data;
+	} // end method
+
+	//! @brief Returns true if all data was read.
+	bool eof() const { return clsCurrent == clsEnd; }
+
+private:
+
+	const char *clsCurrent;
+	const char *clsEnd;
+
+	std::size_t readSize(const std::size_t elementSize) {
+		std::uint64_t size;
+		read(&size, sizeof(size));
+		// Also protects against huge allocations due to corrupted data.
+		if (size > (std::uint64_t) (clsEnd - clsCurrent) / elementSize)
+			throw Exception("Unexpected end of binary data.");
+		return (std::size_t) size;
+	} // end method
+
+	template<typename T>
+	typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+	load(T &value) {
+		read(&value, sizeof(T));
+	} // end method
+
+	template<typename T>
+	typename std::enable_if<std::is_class<T>::value>::type
+	load(T &value) {
+		serialize(*this, value);
+	} // end method
+
+	void load(std::string &value) {
+		const std::size_t size = readSize(1);
+		value.assign(skip(size), size);
+	} // end method
+
+	template<typename T>
+	void load(std::vector<T> &value) {
+		// Each element takes at least one byte.
+		const std::size_t size = readSize(std::is_arithmetic<T>::value? sizeof(T) : 1);
+		value.resize(size);
+		if (std::is_arithmetic<T>::value) {
+			read(value.data(), size * sizeof(T));
+		} else {
+			for (T &element : value)
+				load(element);
+		} // end else
+	} // end method
+
+	void load(std::vector<bool> &value) {
+		const std::size_t size = readSize(1);
+		value.resize(size);
+		for (std::size_t i = 0; i < size; i++) {
+			bool element;
+			load(element);
+			value[i] = element;
+		} // end for
+	} // end method
+}; // end class
+
+} // end namespace
+
+#endif /* RSYN_BINARY_ARCHIVE_H */
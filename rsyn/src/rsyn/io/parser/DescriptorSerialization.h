@@ -0,0 +1,328 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_DESCRIPTOR_SERIALIZATION_H
+#define RSYN_DESCRIPTOR_SERIALIZATION_H
+
+// Binary serialization of the descriptors filled by the parsers (see
+// BinaryArchive.h). Any field added to a descriptor must also be added here
+// and the version of the formats storing it must be bumped.
+
+#include "rsyn/io/parser/BinaryArchive.h"
+#include "rsyn/phy/util/LefDescriptors.h"
+#include "rsyn/phy/util/DefDescriptors.h"
+#include "rsyn/io/legacy/PlacerInternals.h"
+#include "rsyn/io/legacy/ispd13/global.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Geometry
+////////////////////////////////////////////////////////////////////////////////
+
+template<class Archive>
+inline void serialize(Archive &ar, double2 &obj) {
+	ar & obj.x & obj.y;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, DBUxy &obj) {
+	ar & obj.x & obj.y;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, DoubleRectangle &obj) {
+	ar & obj[LOWER] & obj[UPPER];
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, Bounds &obj) {
+	ar & obj[LOWER] & obj[UPPER];
+} // end function
+
+////////////////////////////////////////////////////////////////////////////////
+// LEF
+////////////////////////////////////////////////////////////////////////////////
+
+template<class Archive>
+inline void serialize(Archive &ar, LefPolygonDscp &obj) {
+	ar & obj.clsPolygonPoints;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LefPortDscp &obj) {
+	ar & obj.clsMetalName & obj.clsBounds & obj.clsLefPolygonDscp;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LefPinDscp &obj) {
+	ar & obj.clsHasPort & obj.clsPinName & obj.clsPinDirection & obj.clsBounds
+			& obj.clsPorts;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LefObsDscp &obj) {
+	ar & obj.clsMetalLayer & obj.clsBounds;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LefMacroDscp &obj) {
+	ar & obj.clsMacroName & obj.clsMacroClass & obj.clsSite & obj.clsOrigin
+			& obj.clsSize & obj.clsSymmetry & obj.clsPins & obj.clsObs;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LefLayerDscp &obj) {
+	ar & obj.clsName & obj.clsType & obj.clsDirection & obj.clsPitch
+			& obj.clsOffset & obj.clsWidth & obj.clsSpacing;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LefSiteDscp &obj) {
+	ar & obj.clsName & obj.clsSize & obj.clsHasClass & obj.clsSiteClass;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LefSpacingDscp &obj) {
+	ar & obj.clsLayer1 & obj.clsLayer2 & obj.clsDistance;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LefViaLayerDscp &obj) {
+	ar & obj.clsLayerName & obj.clsBounds;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LefViaDscp &obj) {
+	ar & obj.clsHasDefault & obj.clsName & obj.clsViaLayers;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LefUnitsDscp &obj) {
+	ar & obj.clsHasTime & obj.clsHasCapacitance & obj.clsHasResitance
+			& obj.clsHasPower & obj.clsHasCurrent & obj.clsHasVoltage
+			& obj.clsHasDatabase & obj.clsHasFrequency;
+	ar & obj.clsTime & obj.clsCapacitance & obj.clsResitance & obj.clsPower
+			& obj.clsCurrent & obj.clsVoltage & obj.clsDatabase
+			& obj.clsFrequency;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LefDscp &obj) {
+	ar & obj.clsMajorVersion & obj.clsMinorVersion & obj.clsCaseSensitive
+			& obj.clsBusBitChars & obj.clsDivideChar & obj.clsManufactGrid;
+	ar & obj.clsLefUnitsDscp & obj.clsLefSiteDscps & obj.clsLefLayerDscps
+			& obj.clsLefMacroDscps & obj.clsLefSpacingDscps
+			& obj.clsLefViaDscps;
+} // end function
+
+////////////////////////////////////////////////////////////////////////////////
+// DEF
+////////////////////////////////////////////////////////////////////////////////
+
+template<class Archive>
+inline void serialize(Archive &ar, DefRowDscp &obj) {
+	ar & obj.clsName & obj.clsSite & obj.clsOrigin & obj.clsOrientation
+			& obj.clsNumX & obj.clsNumY & obj.clsStepX & obj.clsStepY;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, DefComponentDscp &obj) {
+	ar & obj.clsName & obj.clsMacroName & obj.clsLocationType & obj.clsPos
+			& obj.clsOrientation & obj.clsIsFixed & obj.clsIsPlaced;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, DefPortDscp &obj) {
+	ar & obj.clsName & obj.clsNetName & obj.clsDirection & obj.clsLocationType
+			& obj.clsPos & obj.clsICCADPos & obj.clsOrientation
+			& obj.clsLayerName & obj.clsLayerBounds;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, DefNetConnection &obj) {
+	ar & obj.clsPinName & obj.clsComponentName;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, DefWireSegmentDscp &obj) {
+	ar & obj.clsLayerName & obj.clsViaName & obj.clsExtensionBegin
+			& obj.clsExtensionEnd & obj.clsMask & obj.clsWidth;
+
+	// Bit fields can't be bound to references.
+	bool isNew = obj.clsNew;
+	bool hasVia = obj.clsHasVia;
+	bool hasRectangle = obj.clsHasRectangle;
+	ar & isNew & hasVia & hasRectangle;
+	obj.clsNew = isNew;
+	obj.clsHasVia = hasVia;
+	obj.clsHasRectangle = hasRectangle;
+
+	ar & obj.clsRect & obj.clsPoints;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, DefWireDscp &obj) {
+	ar & obj.clsWireSegments & obj.clsWireType;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, DefNetDscp &obj) {
+	ar & obj.clsName & obj.clsConnections & obj.clsWires;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, DefRegionDscp &obj) {
+	ar & obj.clsName & obj.clsType & obj.clsBounds;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, DefGroupDscp &obj) {
+	ar & obj.clsName & obj.clsPatterns & obj.clsRegion;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, DefDscp &obj) {
+	ar & obj.clsVersion & obj.clsDeviderChar & obj.clsBusBitChars
+			& obj.clsDesignName & obj.clsDieBounds & obj.clsDatabaseUnits;
+	ar & obj.clsRows & obj.clsComps & obj.clsPorts & obj.clsNets
+			& obj.clsRegions & obj.clsGroups;
+} // end function
+
+////////////////////////////////////////////////////////////////////////////////
+// Verilog
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Legacy {
+
+template<class Archive>
+inline void serialize(Archive &ar, Design::Component &obj) {
+	ar & obj.id & obj.name & obj.fixed & obj.placed & obj.x & obj.y;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, Design::Connection &obj) {
+	ar & obj.pin & obj.instance;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, Design::Net &obj) {
+	ar & obj.name & obj.connections;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, Design::Row &obj) {
+	ar & obj.x & obj.y & obj.numSitesX & obj.numSitesY & obj.site & obj.name
+			& obj.stepX & obj.stepY;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, Design::Pin &obj) {
+	ar & obj.name & obj.net & obj.metal & obj.direction & obj.x & obj.y
+			& obj.routingLower & obj.routingUpper;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, Design::DieArea &obj) {
+	ar & obj.xmin & obj.ymin & obj.xmax & obj.ymax;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, Design::Track &obj) {
+	ar & obj.direction & obj.doStart & obj.doCount & obj.doStep
+			& obj.numLayers & obj.layers;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, Design::GCellGrid &obj) {
+	ar & obj.master & obj.doStart & obj.doCount & obj.doStep;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, Design &obj) {
+	ar & obj.name & obj.distanceUnit & obj.defVersion;
+	ar & obj.components & obj.ports & obj.nets & obj.rows;
+	ar & obj.primaryInputs & obj.primaryOutputs;
+	ar & obj.tracks & obj.gCellGrids & obj.dieArea;
+} // end function
+
+} // end namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Liberty and SDC
+////////////////////////////////////////////////////////////////////////////////
+
+namespace ISPD13 {
+
+template<class Archive>
+inline void serialize(Archive &ar, LibParserLUT &obj) {
+	ar & obj.isScalar & obj.loadIndices & obj.transitionIndices & obj.tableVals;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LibParserTimingInfo &obj) {
+	ar & obj.fromPin & obj.toPin & obj.timingSense & obj.timingType;
+	ar & obj.fallDelay & obj.riseDelay & obj.fallTransition
+			& obj.riseTransition;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LibParserPinInfo &obj) {
+	ar & obj.name & obj.related & obj.capacitance & obj.maxCapacitance
+			& obj.maxTransition & obj.isInput & obj.isClock
+			& obj.isTimingEndpoint & obj.risingEdge;
+	ar & obj.riseSetup & obj.fallSetup & obj.riseHold & obj.fallHold;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LibParserCellInfo &obj) {
+	ar & obj.name & obj.footprint & obj.leakagePower & obj.area
+			& obj.isSequential & obj.dontTouch & obj.isTieLow & obj.isTieHigh;
+	ar & obj.pins & obj.timingArcs;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, LIBInfo &obj) {
+	ar & obj.default_max_transition & obj.libCells;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, InputDelay &obj) {
+	ar & obj.port_name & obj.delay;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, OutputDelay &obj) {
+	ar & obj.port_name & obj.delay;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, InputDriver &obj) {
+	ar & obj.port_name & obj.driver & obj.rise & obj.fall;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, OutputLoad &obj) {
+	ar & obj.port_name & obj.load;
+} // end function
+
+template<class Archive>
+inline void serialize(Archive &ar, SDCInfo &obj) {
+	ar & obj.clk_name & obj.clk_port & obj.clk_period;
+	ar & obj.input_delays & obj.input_drivers & obj.output_delays
+			& obj.output_loads;
+} // end function
+
+} // end namespace
+
+#endif /* RSYN_DESCRIPTOR_SERIALIZATION_H */
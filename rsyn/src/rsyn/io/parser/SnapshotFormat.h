@@ -0,0 +1,42 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_SNAPSHOT_FORMAT_H
+#define RSYN_SNAPSHOT_FORMAT_H
+
+#include <cstdint>
+
+namespace Rsyn {
+
+// A design snapshot is stored as:
+//
+//    magic, version,
+//    library section: technology parameters, LEF, Liberty and SDC descriptors
+//                     (GenericReader::serializeSnapshotLibrary()),
+//    design section:  enableNetlistFromVerilog flag, DEF descriptor and, if
+//                     the flag is set, the Verilog descriptor
+//                     (GenericReader::serializeSnapshotDesign()).
+//
+// The library section does not change during a session, so the writer keeps
+// it as raw bytes and only builds the design section from the current design.
+// The version must be bumped whenever the layout of the snapshot or of any
+// serialized descriptor changes.
+
+const char SNAPSHOT_MAGIC[8] = {'R', 'S', 'Y', 'N', 'S', 'N', 'A', 'P'};
+const std::uint32_t SNAPSHOT_VERSION = 2;
+
+} // end namespace
+
+#endif /* RSYN_SNAPSHOT_FORMAT_H */
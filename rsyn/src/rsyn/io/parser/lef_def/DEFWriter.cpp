@@ -0,0 +1,319 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <atomic>
+#include <iostream>
+
+#include "DEFWriter.h"
+#include "rsyn/phy/util/PhysicalUtil.h"
+#include "rsyn/util/Parallel.h"
+
+namespace Rsyn {
+
+namespace {
+
+// Number of connections written per line in the nets section.
+const int CONNECTIONS_PER_LINE = 4;
+
+void appendInteger(std::string &buffer, const long long value) {
+	char digits[24];
+	int numDigits = 0;
+
+	unsigned long long magnitude = value < 0 ?
+			0ull - (unsigned long long) value : (unsigned long long) value;
+	do {
+		digits[numDigits++] = (char) ('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude);
+
+	if (value < 0)
+		buffer += '-';
+	while (numDigits)
+		buffer += digits[--numDigits];
+} // end function
+
+// -----------------------------------------------------------------------------
+
+void appendPoint(std::string &buffer, const DBUxy point) {
+	buffer += "( ";
+	appendInteger(buffer, point[X]);
+	buffer += ' ';
+	appendInteger(buffer, point[Y]);
+	buffer += " )";
+} // end function
+
+// -----------------------------------------------------------------------------
+
+const char *getOrientationName(const Rsyn::PhysicalOrientation orientation) {
+	switch (orientation) {
+		case ORIENTATION_S: return "S";
+		case ORIENTATION_E: return "E";
+		case ORIENTATION_W: return "W";
+		case ORIENTATION_FN: return "FN";
+		case ORIENTATION_FS: return "FS";
+		case ORIENTATION_FE: return "FE";
+		case ORIENTATION_FW: return "FW";
+		default: return "N";
+	} // end switch
+} // end function
+
+// -----------------------------------------------------------------------------
+
+//! @brief Formats the objects of a netlist collection in parallel, appending
+//!        one buffer per chunk. format(buffer, object) returns true if the
+//!        object was written. Returns the number of objects written.
+template<class Collection, class Function>
+int formatChunks(Range<Collection> range, std::vector<std::string> &buffers,
+		Function format) {
+	Collection &collection = range.getCollection();
+	const int numChunks = collection.getNumChunks();
+	const std::size_t firstBuffer = buffers.size();
+	buffers.resize(firstBuffer + numChunks);
+
+	std::atomic<int> count(0);
+	ParallelInternal::processChunks(getSharedThreadPool(), numChunks,
+			[&](const int chunk) {
+		std::string &buffer = buffers[firstBuffer + chunk];
+		int numWritten = 0;
+		for (auto object : Range<Collection>(collection.getChunks(chunk, chunk + 1))) {
+			if (format(buffer, object))
+				numWritten++;
+		} // end for
+		count += numWritten;
+	});
+
+	return count;
+} // end function
+
+} // end namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool DEFWriter::write(const std::string &filename, const bool full) {
+	std::string header;
+	writeHeader(header, full);
+	if (full)
+		writeRows(header);
+
+	std::vector<std::string> components;
+	const int numComponents = writeComponents(components);
+
+	std::string pins;
+	std::vector<std::string> nets;
+	int numPins = 0;
+	int numNets = 0;
+	if (full) {
+		numPins = writePins(pins);
+		numNets = writeNets(nets);
+	} // end if
+
+	// Join the sections in order.
+	std::size_t size = header.size() + pins.size() + 256;
+	for (const std::string &buffer : components)
+		size += buffer.size();
+	for (const std::string &buffer : nets)
+		size += buffer.size();
+
+	std::string out;
+	out.reserve(size);
+	out += header;
+
+	out += "COMPONENTS ";
+	appendInteger(out, numComponents);
+	out += " ;\n";
+	for (const std::string &buffer : components)
+		out += buffer;
+	out += "END COMPONENTS\n\n";
+
+	if (full) {
+		out += "PINS ";
+		appendInteger(out, numPins);
+		out += " ;\n";
+		out += pins;
+		out += "END PINS\n\n";
+
+		out += "NETS ";
+		appendInteger(out, numNets);
+		out += " ;\n";
+		for (const std::string &buffer : nets)
+			out += buffer;
+		out += "END NETS\n\n";
+	} // end if
+
+	out += "END DESIGN\n";
+
+	FILE *file = std::fopen(filename.c_str(), "wb");
+	if (!file) {
+		std::cout << "[ERROR] Could not open output file: " << filename << "\n";
+		return false;
+	} // end if
+
+	const bool success = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+	if (std::fclose(file) != 0 || !success) {
+		std::cout << "[ERROR] Could not write output file: " << filename << "\n";
+		return false;
+	} // end if
+
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void DEFWriter::writeHeader(std::string &buffer, const bool full) {
+	buffer += "# ICCAD 2015 contest - CADA085 Team solution\n\n\n";
+
+	if (!full) {
+		buffer += "VERSION 5.7 ;\n";
+		buffer += "DESIGN " + clsDesign.getName() + " ;\n\n";
+		return;
+	} // end if
+
+	buffer += "VERSION 5.8 ;\n";
+	buffer += "DIVIDERCHAR \"/\" ;\n";
+	buffer += "BUSBITCHARS \"[]\" ;\n";
+	buffer += "DESIGN " + clsDesign.getName() + " ;\n";
+	buffer += "UNITS DISTANCE MICRONS ";
+	appendInteger(buffer, clsPhysicalDesign.getDatabaseUnits(Rsyn::DESIGN_DBU));
+	buffer += " ;\n\n";
+
+	const Bounds &die = clsPhysicalDesign.getPhysicalDie().getBounds();
+	buffer += "DIEAREA ";
+	appendPoint(buffer, die[LOWER]);
+	buffer += ' ';
+	appendPoint(buffer, die[UPPER]);
+	buffer += " ;\n\n";
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void DEFWriter::writeRows(std::string &buffer) {
+	for (Rsyn::PhysicalRow row : clsPhysicalDesign.allPhysicalRows()) {
+		buffer += "ROW " + row.getName() + " " + row.getSiteName() + " ";
+		appendInteger(buffer, row.getOrigin(X));
+		buffer += ' ';
+		appendInteger(buffer, row.getOrigin(Y));
+		buffer += ' ';
+		buffer += getOrientationName(row.getSiteOrientation());
+		buffer += " DO ";
+		appendInteger(buffer, row.getNumSites(X));
+		buffer += " BY ";
+		appendInteger(buffer, row.getNumSites(Y));
+		buffer += " STEP ";
+		appendInteger(buffer, row.getStep(X));
+		buffer += ' ';
+		appendInteger(buffer, row.getStep(Y));
+		buffer += " ;\n";
+	} // end for
+	buffer += '\n';
+} // end method
+
+// -----------------------------------------------------------------------------
+
+int DEFWriter::writeComponents(std::vector<std::string> &buffers) {
+	Rsyn::Module module = clsDesign.getTopModule();
+	return formatChunks(module.allInstances(), buffers,
+			[&](std::string &buffer, Rsyn::Instance instance) {
+		if (instance.getType() != Rsyn::CELL)
+			return false;
+
+		Rsyn::Cell cell = instance.asCell();
+		Rsyn::PhysicalCell physicalCell = clsPhysicalDesign.getPhysicalCell(cell);
+
+		buffer += "   - ";
+		buffer += cell.getName();
+		buffer += ' ';
+		buffer += cell.getLibraryCellName();
+		buffer += "\n      + ";
+		buffer += instance.isFixed() ? "FIXED " : "PLACED ";
+		appendPoint(buffer, physicalCell.getPosition());
+		buffer += ' ';
+		buffer += getOrientationName(physicalCell.getOrientation());
+		buffer += " ;\n";
+		return true;
+	});
+} // end method
+
+// -----------------------------------------------------------------------------
+
+int DEFWriter::writePins(std::string &buffer) {
+	Rsyn::Module module = clsDesign.getTopModule();
+
+	int numPins = 0;
+	for (Rsyn::Port port : module.allPorts()) {
+		Rsyn::PhysicalPort physicalPort = clsPhysicalDesign.getPhysicalPort(port);
+		Rsyn::Net net = port.getInnerPin().getNet();
+
+		buffer += "   - ";
+		buffer += port.getName();
+		buffer += " + NET ";
+		buffer += net ? net.getName() : port.getName();
+		switch (port.getDirection()) {
+			case Rsyn::IN: buffer += "\n      + DIRECTION INPUT"; break;
+			case Rsyn::OUT: buffer += "\n      + DIRECTION OUTPUT"; break;
+			default: buffer += "\n      + DIRECTION INOUT"; break;
+		} // end switch
+
+		// The original pin shape is not kept, so the port is written as a
+		// point at its position.
+		if (physicalPort.hasPortLayer()) {
+			buffer += "\n      + LAYER ";
+			buffer += physicalPort.getPortLayer().getName();
+			buffer += " ( 0 0 ) ( 0 0 )";
+		} // end if
+
+		buffer += "\n      + FIXED ";
+		appendPoint(buffer, physicalPort.getPosition());
+		buffer += " N ;\n";
+		numPins++;
+	} // end for
+
+	return numPins;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+int DEFWriter::writeNets(std::vector<std::string> &buffers) {
+	Rsyn::Module module = clsDesign.getTopModule();
+	return formatChunks(module.allNets(), buffers,
+			[&](std::string &buffer, Rsyn::Net net) {
+		buffer += "   - ";
+		buffer += net.getName();
+
+		int numConnections = 0;
+		for (Rsyn::Pin pin : net.allPins()) {
+			if (numConnections > 0 && numConnections % CONNECTIONS_PER_LINE == 0)
+				buffer += "\n     ";
+			numConnections++;
+
+			Rsyn::Instance instance = pin.getInstance();
+			if (instance.getType() == Rsyn::PORT) {
+				buffer += " ( PIN ";
+				buffer += instance.getName();
+			} else {
+				buffer += " ( ";
+				buffer += instance.getName();
+				buffer += ' ';
+				buffer += pin.getName();
+			} // end else
+			buffer += " )";
+		} // end for
+
+		buffer += " ;\n";
+		return true;
+	});
+} // end method
+
+} // end namespace
@@ -0,0 +1,61 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARSER_LEF_DEF_DEFWRITER_H_
+#define PARSER_LEF_DEF_DEFWRITER_H_
+
+#include <string>
+#include <vector>
+
+#include "rsyn/core/Rsyn.h"
+#include "rsyn/phy/PhysicalDesign.h"
+
+namespace Rsyn {
+
+////////////////////////////////////////////////////////////////////////////////
+// Writes DEF files directly from the netlist and the physical design, without
+// going through DefDscp and the Si2 DEF writer.
+//
+// Components and nets are formatted in parallel, one buffer per chunk of the
+// underlying netlist list. The buffers are then joined in order and the file
+// is written with a single call.
+////////////////////////////////////////////////////////////////////////////////
+
+class DEFWriter {
+public:
+
+	DEFWriter(Rsyn::Design design, Rsyn::PhysicalDesign physicalDesign) :
+		clsDesign(design), clsPhysicalDesign(physicalDesign) {}
+
+	//! @brief Writes the components (ICCAD 2015 format). If full is true, the
+	//!        die area, rows, pins and nets are written as well. Returns
+	//!        false if the file could not be written.
+	bool write(const std::string &filename, const bool full);
+
+private:
+
+	Rsyn::Design clsDesign;
+	Rsyn::PhysicalDesign clsPhysicalDesign;
+
+	void writeHeader(std::string &buffer, const bool full);
+	void writeRows(std::string &buffer);
+	int writeComponents(std::vector<std::string> &buffers);
+	int writePins(std::string &buffer);
+	int writeNets(std::vector<std::string> &buffers);
+}; // end class
+
+} // end namespace
+
+#endif /* PARSER_LEF_DEF_DEFWRITER_H_ */
@@ -22,8 +22,66 @@
 
 #include <math.h>
 #include <limits>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "LibertyControlParser.h"
+#include "rsyn/io/parser/DescriptorSerialization.h"
+#include "rsyn/util/MappedFile.h"
+#include "rsyn/util/MD5.h"
+
+namespace {
+
+// Cache header. The version must be bumped whenever the layout of the cache or
+// of the serialized Liberty descriptors changes.
+const char LIBERTY_CACHE_MAGIC[8] = {'R', 'S', 'Y', 'N', 'L', 'I', 'B', 'C'};
+const std::uint32_t LIBERTY_CACHE_VERSION = 1;
+
+// Identifies the contents of a Liberty file. The size and modification time
+// are only used to skip hashing the file when they did not change.
+struct LibertyFileKey {
+	std::uint64_t size = 0;
+	std::int64_t modificationTime = 0;
+	std::string digest;
+}; // end struct
+
+template<class Archive>
+inline void serialize(Archive &ar, LibertyFileKey &obj) {
+	ar & obj.size & obj.modificationTime & obj.digest;
+} // end function
+
+bool getLibertyFileKey(const string &filename, LibertyFileKey &key) {
+	struct stat info;
+	if (stat(filename.c_str(), &info) != 0)
+		return false;
+	key.size = (std::uint64_t) info.st_size;
+	key.modificationTime = (std::int64_t) info.st_mtime;
+	return true;
+} // end function
+
+// Computes the MD5 digest of the file contents.
+std::string computeLibertyFileDigest(const string &filename) {
+	Rsyn::MappedFile file;
+	if (!file.open(filename))
+		return "";
+
+	// MD5 takes 32-bit sizes.
+	const std::size_t blockSize = 1 << 30;
+
+	MD5 md5;
+	for (std::size_t offset = 0; offset < file.size(); offset += blockSize) {
+		const std::size_t size = std::min(blockSize, file.size() - offset);
+		md5.update(file.data() + offset, (MD5::size_type) size);
+	} // end for
+	md5.finalize();
+	return md5.hexdigest();
+} // end function
+
+} // end namespace
 
 LibertyControlParser::LibertyControlParser() {
 	print = false;
@@ -587,3 +645,111 @@ void LibertyControlParser::parseLiberty(const string &filename, ISPD13::LIBInfo
 	} // end if
 	
 } // end method
+
+// -----------------------------------------------------------------------------
+
+void LibertyControlParser::parseLibertyCached(const string &filename, const string &cacheFilename, ISPD13::LIBInfo & lib) {
+	if (readCache(cacheFilename, filename, lib))
+		return;
+
+	lib = ISPD13::LIBInfo();
+	parseLiberty(filename, lib);
+	writeCache(cacheFilename, filename, lib);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<class Archive>
+void LibertyControlParser::serializeCache(Archive &ar, ISPD13::LIBInfo &lib) {
+	ar & unitPrefixForTime & unitPrefixForCapacitance & unitPrefixForLeakagePower;
+	ar & lib;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+bool LibertyControlParser::readCache(const string &cacheFilename, const string &filename, ISPD13::LIBInfo & lib) {
+	LibertyFileKey key;
+	if (!getLibertyFileKey(filename, key))
+		return false;
+
+	Rsyn::MappedFile file;
+	if (!file.open(cacheFilename))
+		return false;
+
+	try {
+		Rsyn::BinaryInputArchive ar(file.begin(), file.end());
+
+		char magic[sizeof(LIBERTY_CACHE_MAGIC)];
+		std::uint32_t version;
+		ar.read(magic, sizeof(magic));
+		ar & version;
+		if (std::memcmp(magic, LIBERTY_CACHE_MAGIC, sizeof(magic)) || version != LIBERTY_CACHE_VERSION)
+			return false;
+
+		LibertyFileKey cachedKey;
+		ar & cachedKey;
+		if (cachedKey.size != key.size)
+			return false;
+		if (cachedKey.modificationTime != key.modificationTime &&
+				cachedKey.digest != computeLibertyFileDigest(filename))
+			return false;
+
+		serializeCache(ar, lib);
+		if (!ar.eof())
+			return false;
+	} catch (Rsyn::Exception &) {
+		std::cout << "[WARNING] Ignoring corrupted Liberty cache " << cacheFilename << "\n";
+		return false;
+	} // end catch
+
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void LibertyControlParser::writeCache(const string &cacheFilename, const string &filename, ISPD13::LIBInfo & lib) {
+	LibertyFileKey key;
+	if (!getLibertyFileKey(filename, key))
+		return;
+	key.digest = computeLibertyFileDigest(filename);
+
+	std::ostringstream buffer;
+	Rsyn::BinaryOutputArchive ar(buffer);
+	ar.write(LIBERTY_CACHE_MAGIC, sizeof(LIBERTY_CACHE_MAGIC));
+	ar & LIBERTY_CACHE_VERSION;
+	ar & key;
+	serializeCache(ar, lib);
+	const std::string data = buffer.str();
+
+	// Write to a uniquely named temporary file and then rename it, so that
+	// concurrent runs never read a partially written cache nor write to the
+	// same temporary file.
+	std::string tmpFilename = cacheFilename + ".XXXXXX";
+	const int fd = mkstemp(&tmpFilename[0]);
+	if (fd == -1) {
+		std::cout << "[WARNING] Failed to create Liberty cache " << cacheFilename << "\n";
+		return;
+	} // end if
+
+	// mkstemp() creates the file only readable by the owner.
+	bool success = fchmod(fd, 0644) == 0;
+
+	std::size_t numWrittenBytes = 0;
+	while (success && numWrittenBytes < data.size()) {
+		const ssize_t n = ::write(fd, data.data() + numWrittenBytes,
+				data.size() - numWrittenBytes);
+		if (n <= 0) {
+			success = false;
+		} else {
+			numWrittenBytes += n;
+		} // end else
+	} // end while
+
+	if (::close(fd) != 0)
+		success = false;
+
+	if (!success || std::rename(tmpFilename.c_str(), cacheFilename.c_str()) != 0) {
+		std::cout << "[WARNING] Failed to write Liberty cache " << cacheFilename << "\n";
+		std::remove(tmpFilename.c_str());
+	} // end if
+} // end method
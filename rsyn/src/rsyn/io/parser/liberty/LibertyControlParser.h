@@ -82,10 +82,21 @@ private:
 	Rsyn::UnitPrefix unitPrefixForCapacitance;
 	Rsyn::UnitPrefix unitPrefixForLeakagePower;
 	
+	template<class Archive>
+	void serializeCache(Archive &ar, ISPD13::LIBInfo &lib);
+	bool readCache(const string &cacheFilename, const string &filename, ISPD13::LIBInfo &lib);
+	void writeCache(const string &cacheFilename, const string &filename, ISPD13::LIBInfo &lib);
+	
 public:
 	bool print;
 	LibertyControlParser();
 	void parseLiberty(const string &filename, ISPD13::LIBInfo & lib);
+	
+	//! @brief Same as parseLiberty(), but the library is loaded from a binary
+	//!        cache file if it was created from a Liberty file with the same
+	//!        contents. Otherwise, the Liberty file is parsed and the cache is
+	//!        (re)written.
+	void parseLibertyCached(const string &filename, const string &cacheFilename, ISPD13::LIBInfo & lib);
 	virtual ~LibertyControlParser();
 	
 	const Rsyn::UnitPrefix getUnitPrefixForCapacitance() const {
@@ -0,0 +1,445 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <iostream>
+#include <algorithm>
+#include <unordered_map>
+
+#include "SPEFStreamReader.h"
+#include "rsyn/model/routing/RoutingEstimator.h"
+#include "rsyn/util/MappedFile.h"
+#include "rsyn/util/Hash.h"
+#include "rsyn/util/Parallel.h"
+#include "rsyn/util/Units.h"
+
+namespace Rsyn {
+
+namespace {
+
+// Target size of the chunks processed by each task.
+const std::size_t CHUNK_SIZE = 4 * 1024 * 1024;
+
+// Maximum number of tokens stored per line. No SPEF statement handled here
+// needs more than that.
+const int MAX_TOKENS = 8;
+
+bool isBlank(const char ch) {
+	return ch == ' ' || ch == '\t' || ch == '\r';
+} // end function
+
+// -----------------------------------------------------------------------------
+
+//! @brief Returns the line starting at pos (without the line break) and moves
+//!        pos to the beginning of the next line.
+boost::string_ref nextLine(const char *&pos, const char *end) {
+	const char *newline = (const char *) std::memchr(pos, '\n', end - pos);
+	const char *lineEnd = newline ? newline : end;
+	const boost::string_ref line(pos, lineEnd - pos);
+	pos = newline ? newline + 1 : end;
+	return line;
+} // end function
+
+// -----------------------------------------------------------------------------
+
+//! @brief Splits a line into blank-separated tokens ignoring // comments.
+//!        Returns the number of tokens found, which may be larger than
+//!        maxTokens, but only the first maxTokens are stored.
+int splitLine(const boost::string_ref line, boost::string_ref *tokens, const int maxTokens) {
+	int numTokens = 0;
+
+	const char *pos = line.begin();
+	const char *end = line.end();
+	while (true) {
+		while (pos != end && isBlank(*pos))
+			pos++;
+		if (pos == end)
+			break;
+
+		if (*pos == '/' && pos + 1 != end && pos[1] == '/')
+			break;
+
+		const char *begin = pos;
+		while (pos != end && !isBlank(*pos))
+			pos++;
+
+		if (numTokens < maxTokens)
+			tokens[numTokens] = boost::string_ref(begin, pos - begin);
+		numTokens++;
+	} // end while
+
+	return numTokens;
+} // end function
+
+// -----------------------------------------------------------------------------
+
+//! @brief Returns true if the line starting at pos is a *D_NET line.
+bool isSectionStart(const char *pos, const char *end) {
+	while (pos != end && isBlank(*pos))
+		pos++;
+	return end - pos > 6 && std::memcmp(pos, "*D_NET", 6) == 0 && isBlank(pos[6]);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+//! @brief Returns the beginning of the first *D_NET line at or after pos,
+//!        which must be at the beginning of a line.
+const char *findSection(const char *pos, const char *end) {
+	while (pos != end && !isSectionStart(pos, end))
+		nextLine(pos, end);
+	return pos;
+} // end function
+
+// -----------------------------------------------------------------------------
+
+//! @brief Parses a number. Only the first value of triplets (e.g. 1.2:1.3:1.5)
+//!        is used.
+double parseNumber(const boost::string_ref token) {
+	// The token is copied as it is not null-terminated.
+	char buffer[64];
+	const std::size_t size = std::min(token.size(), sizeof(buffer) - 1);
+	std::memcpy(buffer, token.data(), size);
+	buffer[size] = '\0';
+	return std::strtod(buffer, nullptr);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+//! @brief Returns the scale from a SPEF unit (e.g. 1 PF) to internal units or
+//!        zero if the unit is not supported.
+Number getUnitScale(const Measure measure, const boost::string_ref value, const boost::string_ref unit) {
+	UnitPrefix prefix;
+	if (measure == MEASURE_CAPACITANCE) {
+		if (unit == "FF") prefix = FEMTO;
+		else if (unit == "PF") prefix = PICO;
+		else if (unit == "NF") prefix = NANO;
+		else if (unit == "UF") prefix = MICRO;
+		else if (unit == "F") prefix = NO_UNIT_PREFIX;
+		else return 0;
+	} else {
+		if (unit == "OHM") prefix = NO_UNIT_PREFIX;
+		else if (unit == "KOHM") prefix = KILO;
+		else if (unit == "MOHM") prefix = MEGA;
+		else return 0;
+	} // end else
+
+	return (Number) Units::convertToInternalUnits(measure, parseNumber(value), prefix);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+//! @brief Removes the escape characters of a SPEF name (e.g. a\[0\]).
+std::string unescapeName(const std::string &name) {
+	std::string result;
+	result.reserve(name.size());
+	for (std::size_t i = 0; i < name.size(); i++) {
+		if (name[i] == '\\' && i + 1 < name.size())
+			i++;
+		result += name[i];
+	} // end for
+	return result;
+} // end function
+
+} // end namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool SPEFStreamReader::read(const std::string &filename) {
+	// The file must remain mapped while sections are processed as names in the
+	// name map point into it.
+	MappedFile file;
+	if (!file.open(filename)) {
+		std::cout << "[ERROR] Could not open SPEF file '" << filename << "'.\n";
+		return false;
+	} // end if
+
+	clsEnd = file.end();
+	clsNameMap.clear();
+	clsNumAnnotatedNets = 0;
+	clsNumSkippedNets = 0;
+	clsAnnotatedNets.clear();
+
+	const char *body = readHeader(file.begin());
+	if (clsCapacitanceScale == 0 || clsResistanceScale == 0) {
+		std::cout << "[ERROR] Unsupported units in SPEF file '" << filename << "'.\n";
+		return false;
+	} // end if
+
+	// Split the sections into chunks. Chunks start at the beginning of a line
+	// and each one handles the sections starting in it.
+	const std::size_t bodySize = clsEnd - body;
+	const std::size_t maxChunks = 4 * (getSharedThreadPool().getNumThreads() + 1);
+	const int numChunks = (int) std::max((std::size_t) 1,
+			std::min(maxChunks, bodySize / CHUNK_SIZE));
+
+	std::vector<const char *> boundaries(numChunks + 1, clsEnd);
+	boundaries[0] = body;
+	for (int i = 1; i < numChunks; i++) {
+		const char *pos = std::max(boundaries[i - 1], body + (bodySize * i) / numChunks);
+		if (pos != body && pos != clsEnd && pos[-1] != '\n')
+			nextLine(pos, clsEnd);
+		boundaries[i] = pos;
+	} // end for
+
+	std::vector<std::vector<Rsyn::Net>> annotatedNets(numChunks);
+	ParallelInternal::processChunks(getSharedThreadPool(), numChunks,
+			[&](const int chunk) {
+		readSections(boundaries[chunk], boundaries[chunk + 1], annotatedNets[chunk]);
+	});
+
+	for (const std::vector<Rsyn::Net> &nets : annotatedNets)
+		clsAnnotatedNets.insert(clsAnnotatedNets.end(), nets.begin(), nets.end());
+
+	clsEnd = nullptr;
+	clsNameMap.clear();
+
+	std::cout << "\tAnnotated nets: " << clsNumAnnotatedNets << "\n";
+	if (clsNumSkippedNets > 0) {
+		std::cout << "[WARNING] " << clsNumSkippedNets << " SPEF net(s) were "
+				"skipped as the net, its driver or one of its pins was not "
+				"found.\n";
+	} // end if
+
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+const char *SPEFStreamReader::readHeader(const char *begin) {
+	boost::string_ref tokens[MAX_TOKENS];
+
+	bool nameMap = false;
+
+	const char *pos = begin;
+	while (pos != clsEnd) {
+		const char *lineBegin = pos;
+		const int numTokens = splitLine(nextLine(pos, clsEnd), tokens, MAX_TOKENS);
+		if (numTokens == 0)
+			continue;
+
+		const boost::string_ref keyword = tokens[0];
+		if (keyword == "*D_NET")
+			return lineBegin;
+
+		if (nameMap && keyword.size() > 1 && keyword[0] == '*' &&
+				std::isdigit((unsigned char) keyword[1])) {
+			const double index = parseNumber(keyword.substr(1));
+			if (numTokens >= 2 && index >= 0 && index < (1 << 30)) {
+				const std::size_t i = (std::size_t) index;
+				if (i >= clsNameMap.size())
+					clsNameMap.resize(i + 1);
+				clsNameMap[i] = tokens[1];
+			} // end if
+			continue;
+		} // end if
+
+		nameMap = false;
+
+		if (keyword == "*NAME_MAP") {
+			nameMap = true;
+		} else if (keyword == "*DELIMITER" && numTokens >= 2) {
+			clsDelimiter = tokens[1][0];
+		} else if (keyword == "*C_UNIT" && numTokens >= 3) {
+			clsCapacitanceScale = getUnitScale(MEASURE_CAPACITANCE, tokens[1], tokens[2]);
+		} else if (keyword == "*R_UNIT" && numTokens >= 3) {
+			clsResistanceScale = getUnitScale(MEASURE_RESISTANCE, tokens[1], tokens[2]);
+		} // end else
+	} // end while
+
+	return clsEnd;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SPEFStreamReader::readSections(const char *begin, const char *end,
+		std::vector<Rsyn::Net> &annotatedNets) {
+	enum Mode {
+		MODE_NONE,
+		MODE_CONN,
+		MODE_CAP,
+		MODE_RES
+	}; // end enum
+
+	boost::string_ref tokens[MAX_TOKENS];
+
+	// Maps node names to node indexes in the descriptor.
+	std::unordered_map<boost::string_ref, int, StringRefHash> nodes;
+	auto getNode = [&](const boost::string_ref name) {
+		return nodes.emplace(name, (int) nodes.size()).first->second;
+	}; // end lambda
+
+	std::vector<std::pair<int, Rsyn::Pin>> pins;
+
+	const char *pos = findSection(begin, clsEnd);
+	while (pos < end) {
+		const int numHeaderTokens = splitLine(nextLine(pos, clsEnd), tokens, MAX_TOKENS);
+		const Rsyn::Net net = numHeaderTokens >= 3 ? findNet(tokens[1]) : nullptr;
+		const Number totalCap = numHeaderTokens >= 3 ?
+				(Number) parseNumber(tokens[2]) * clsCapacitanceScale : 0;
+
+		RCTreeDescriptor dscp;
+		nodes.clear();
+		pins.clear();
+
+		int root = -1;
+		bool hasResistors = false;
+		bool hasMissingPins = false;
+		Mode mode = MODE_NONE;
+
+		while (pos != clsEnd) {
+			const char *lineBegin = pos;
+			const int numTokens = splitLine(nextLine(pos, clsEnd), tokens, MAX_TOKENS);
+			if (numTokens == 0)
+				continue;
+
+			const boost::string_ref keyword = tokens[0];
+			if (keyword == "*END") {
+				break;
+			} else if (keyword == "*D_NET") {
+				// Missing *END.
+				pos = lineBegin;
+				break;
+			} else if (keyword == "*CONN") {
+				mode = MODE_CONN;
+			} else if (keyword == "*CAP") {
+				mode = MODE_CAP;
+			} else if (keyword == "*RES") {
+				mode = MODE_RES;
+			} else if (keyword == "*INDUC") {
+				mode = MODE_NONE;
+			} else if (!net) {
+				// Keep reading until the end of the section.
+			} else if (mode == MODE_CONN) {
+				if (numTokens < 3 || !(keyword == "*P" || keyword == "*I"))
+					continue;
+				const bool port = keyword == "*P";
+				const Rsyn::Pin pin = findPin(tokens[1], port);
+				if (!pin || pin.getNet() != net) {
+					hasMissingPins = true;
+					continue;
+				} // end if
+				const int node = getNode(tokens[1]);
+				pins.push_back(std::make_pair(node, pin));
+				const char direction = tokens[2][0];
+				if ((port && direction == 'I') || (!port && direction == 'O'))
+					root = node;
+			} else if (mode == MODE_CAP) {
+				// Coupling capacitances (id node other cap) are grounded.
+				if (numTokens == 3) {
+					dscp.addCapacitor(getNode(tokens[1]),
+							(Number) parseNumber(tokens[2]) * clsCapacitanceScale);
+				} else if (numTokens >= 4) {
+					dscp.addCapacitor(getNode(tokens[1]),
+							(Number) parseNumber(tokens[3]) * clsCapacitanceScale);
+				} // end else
+			} else if (mode == MODE_RES) {
+				if (numTokens >= 4) {
+					dscp.addResistor(getNode(tokens[1]), getNode(tokens[2]),
+							(Number) parseNumber(tokens[3]) * clsResistanceScale);
+					hasResistors = true;
+				} // end if
+			} // end else
+		} // end while
+
+		if (!net) {
+			clsNumSkippedNets++;
+		} else if (!hasResistors) {
+			clsRoutingEstimator->getRCTree(net).setUserSpecifiedWireLoad(totalCap);
+			annotatedNets.push_back(net);
+			clsNumAnnotatedNets++;
+		} else if (root == -1 || dscp.findNode(root) == -1) {
+			clsNumSkippedNets++;
+		} else if (hasMissingPins || (int) pins.size() != net.getNumPins()) {
+			// A sink without a node in the tree would not be timed.
+			clsNumSkippedNets++;
+		} else {
+			dscp.applyDefaultNodeTag(RCTreeNodeTag(nullptr, 0, 0));
+			for (const std::pair<int, Rsyn::Pin> &p : pins) {
+				if (dscp.findNode(p.first) != -1)
+					dscp.setNodeTag(p.first, RCTreeNodeTag(p.second, 0, 0));
+			} // end for
+
+			if (!clsRoutingEstimator->setUserSpecifiedRouting(net, dscp, dscp.findNode(root))) {
+				std::cout << "[WARNING] Loop removed from SPEF net '" << net.getName() << "'.\n";
+			} // end if
+			annotatedNets.push_back(net);
+			clsNumAnnotatedNets++;
+		} // end else
+
+		pos = findSection(pos, clsEnd);
+	} // end while
+} // end method
+
+// -----------------------------------------------------------------------------
+
+std::string SPEFStreamReader::resolveName(const boost::string_ref name) const {
+	if (name.size() > 1 && name[0] == '*' && std::isdigit((unsigned char) name[1])) {
+		// Name map reference, possibly followed by a pin (e.g. *12:A).
+		const char *pos = name.begin() + 1;
+		while (pos != name.end() && std::isdigit((unsigned char) *pos))
+			pos++;
+
+		const std::size_t index = (std::size_t) parseNumber(boost::string_ref(name.begin() + 1, pos - name.begin() - 1));
+		if (index < clsNameMap.size() && !clsNameMap[index].empty())
+			return clsNameMap[index].to_string() + std::string(pos, name.end());
+	} // end if
+
+	return name.to_string();
+} // end method
+
+// -----------------------------------------------------------------------------
+
+Rsyn::Net SPEFStreamReader::findNet(const boost::string_ref name) const {
+	const std::string fullName = resolveName(name);
+	const Rsyn::Net net = clsDesign.findNetByName(fullName);
+	if (net || fullName.find('\\') == std::string::npos)
+		return net;
+	return clsDesign.findNetByName(unescapeName(fullName));
+} // end method
+
+// -----------------------------------------------------------------------------
+
+Rsyn::Pin SPEFStreamReader::findPin(const boost::string_ref name, const bool port) const {
+	std::string fullName = resolveName(name);
+
+	if (port) {
+		Rsyn::Port rsynPort = clsDesign.findPortByName(fullName);
+		if (!rsynPort && fullName.find('\\') != std::string::npos)
+			rsynPort = clsDesign.findPortByName(unescapeName(fullName));
+		return rsynPort ? rsynPort.getInnerPin() : nullptr;
+	} // end if
+
+	// The delimiter is searched for before removing escapes as it may also
+	// appear escaped in the instance name.
+	std::size_t separator = std::string::npos;
+	for (std::size_t i = 0; i < fullName.size(); i++) {
+		if (fullName[i] == '\\')
+			i++;
+		else if (fullName[i] == clsDelimiter)
+			separator = i;
+	} // end for
+	if (separator == std::string::npos)
+		return nullptr;
+
+	const std::string instanceName = fullName.substr(0, separator);
+	Rsyn::Cell cell = clsDesign.findCellByName(instanceName);
+	if (!cell && instanceName.find('\\') != std::string::npos)
+		cell = clsDesign.findCellByName(unescapeName(instanceName));
+	return cell ? cell.getPinByName(unescapeName(fullName.substr(separator + 1))) : nullptr;
+} // end method
+
+} // end namespace
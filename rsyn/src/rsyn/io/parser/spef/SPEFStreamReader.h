@@ -0,0 +1,109 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARSER_SPEF_SPEFSTREAMREADER_H_
+#define PARSER_SPEF_SPEFSTREAMREADER_H_
+
+#include <string>
+#include <vector>
+#include <atomic>
+
+#include <boost/utility/string_ref.hpp>
+
+#include "rsyn/core/Rsyn.h"
+#include "rsyn/model/timing/types.h"
+
+namespace Rsyn {
+
+class RoutingEstimator;
+
+////////////////////////////////////////////////////////////////////////////////
+// Reads a SPEF file and sets the parasitics of each net as user-specified
+// routing in the routing estimator. Unlike SPEFControlParser, nets are not
+// stored in a descriptor: each *D_NET section is turned into an RC tree as soon
+// as it is read.
+//
+// The file is memory-mapped. The header (units, delimiter and name map) is read
+// first. The rest of the file is then split into chunks, which are processed
+// by the shared thread pool. Each chunk handles the *D_NET sections starting
+// in it.
+//
+// Nets without resistors (e.g. lumped-only sections) get the total
+// capacitance as user-specified wire load. Nets whose driver is not found or
+// whose connections do not match the pins of the net in the design are skipped
+// and keep their estimated routing.
+////////////////////////////////////////////////////////////////////////////////
+
+class SPEFStreamReader {
+public:
+
+	SPEFStreamReader(Rsyn::Design design, RoutingEstimator *routingEstimator) :
+		clsDesign(design), clsRoutingEstimator(routingEstimator) {}
+
+	//! @brief Reads the SPEF file. Returns false if the file could not be
+	//!        opened or its header is invalid.
+	bool read(const std::string &filename);
+
+	int getNumAnnotatedNets() const { return clsNumAnnotatedNets; }
+	int getNumSkippedNets() const { return clsNumSkippedNets; }
+
+	//! @brief Returns the nets annotated by the last read().
+	const std::vector<Rsyn::Net> &getAnnotatedNets() const { return clsAnnotatedNets; }
+
+private:
+
+	Rsyn::Design clsDesign;
+	RoutingEstimator *clsRoutingEstimator;
+
+	const char *clsEnd = nullptr;
+
+	// Conversion from SPEF units to internal units.
+	Number clsCapacitanceScale = 1;
+	Number clsResistanceScale = 1;
+
+	// Separates instance and pin names (e.g. u1:A).
+	char clsDelimiter = ':';
+
+	// Names indexed by the name map index (e.g. *12).
+	std::vector<boost::string_ref> clsNameMap;
+
+	std::atomic<int> clsNumAnnotatedNets{0};
+	std::atomic<int> clsNumSkippedNets{0};
+
+	std::vector<Rsyn::Net> clsAnnotatedNets;
+
+	//! @brief Reads the header and returns the position of the first *D_NET
+	//!        section (or the end of the file).
+	const char *readHeader(const char *begin);
+
+	//! @brief Processes the sections starting in [begin, end) and appends the
+	//!        annotated nets.
+	void readSections(const char *begin, const char *end,
+			std::vector<Rsyn::Net> &annotatedNets);
+
+	//! @brief Returns the name referenced by a SPEF name (e.g. *12) or the
+	//!        name itself.
+	std::string resolveName(const boost::string_ref name) const;
+
+	//! @brief Returns the net referenced by a *D_NET section.
+	Rsyn::Net findNet(const boost::string_ref name) const;
+
+	//! @brief Returns the pin referenced by a *CONN entry.
+	Rsyn::Pin findPin(const boost::string_ref name, const bool port) const;
+}; // end class
+
+} // end namespace
+
+#endif /* PARSER_SPEF_SPEFSTREAMREADER_H_ */
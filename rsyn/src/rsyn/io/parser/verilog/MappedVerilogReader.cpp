@@ -0,0 +1,517 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+#include "MappedVerilogReader.h"
+#include "rsyn/util/Parallel.h"
+
+namespace Parsing {
+
+namespace {
+
+// Smaller pieces of the module body are not worth a task.
+const std::size_t MIN_CHUNK_SIZE = 1 << 20;
+
+enum TokenType {
+	TOKEN_END,
+	TOKEN_IDENTIFIER,
+	TOKEN_MODULE,
+	TOKEN_END_MODULE,
+	TOKEN_INPUT,
+	TOKEN_OUTPUT,
+	TOKEN_WIRE,
+	TOKEN_SYMBOL,
+	TOKEN_INVALID
+}; // end enum
+
+struct Token {
+	TokenType type;
+	boost::string_ref text;
+}; // end struct
+
+// -----------------------------------------------------------------------------
+
+inline bool isSymbol(const Token &token, const char symbol) {
+	return token.type == TOKEN_SYMBOL && token.text[0] == symbol;
+} // end function
+
+// -----------------------------------------------------------------------------
+
+// Splits the text into the same tokens as SimplifiedVerilog.l. Symbols not
+// used by the grammar are returned as invalid tokens.
+class Lexer {
+public:
+
+	Lexer(const char *begin, const char *end) : clsPos(begin), clsEnd(end) {}
+
+	const char *getPosition() const { return clsPos; }
+
+	Token next() {
+		if (!skipWhitespacesAndComments())
+			return Token{TOKEN_INVALID, boost::string_ref()};
+
+		if (clsPos == clsEnd)
+			return Token{TOKEN_END, boost::string_ref()};
+
+		const char *begin = clsPos;
+		const char c = *clsPos;
+
+		if (isIdentifierStart(c)) {
+			clsPos++;
+			while (clsPos != clsEnd && isIdentifierChar(*clsPos))
+				clsPos++;
+			const boost::string_ref text(begin, clsPos - begin);
+			return Token{getKeyword(text), text};
+		} // end if
+
+		if (c == '\\') {
+			// Escaped identifiers end at a white space. The backslash is not
+			// part of the name.
+			clsPos++;
+			while (clsPos != clsEnd && !isEscapedIdentifierTerminator(*clsPos))
+				clsPos++;
+			if (clsPos == begin + 1)
+				return Token{TOKEN_INVALID, boost::string_ref()};
+			return Token{TOKEN_IDENTIFIER, boost::string_ref(begin + 1, clsPos - begin - 1)};
+		} // end if
+
+		if (c == '(' || c == ')' || c == ';' || c == ',' || c == '.') {
+			clsPos++;
+			return Token{TOKEN_SYMBOL, boost::string_ref(begin, clsPos - begin)};
+		} // end if
+
+		return Token{TOKEN_INVALID, boost::string_ref()};
+	} // end method
+
+private:
+
+	const char *clsPos;
+	const char *clsEnd;
+
+	static bool isIdentifierStart(const char c) {
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+	} // end method
+
+	static bool isIdentifierChar(const char c) {
+		return isIdentifierStart(c) || (c >= '0' && c <= '9') || c == '$';
+	} // end method
+
+	static bool isEscapedIdentifierTerminator(const char c) {
+		return c == ' ' || c == '\t' || c == '\b' || c == '\f' || c == '\r';
+	} // end method
+
+	static bool isWhitespace(const char c) {
+		return isEscapedIdentifierTerminator(c) || c == '\n';
+	} // end method
+
+	static TokenType getKeyword(const boost::string_ref text) {
+		if (text == "input") return TOKEN_INPUT;
+		if (text == "output") return TOKEN_OUTPUT;
+		if (text == "wire") return TOKEN_WIRE;
+		if (text == "module") return TOKEN_MODULE;
+		if (text == "endmodule") return TOKEN_END_MODULE;
+		return TOKEN_IDENTIFIER;
+	} // end method
+
+	// Returns false if a block comment is not closed.
+	bool skipWhitespacesAndComments() {
+		while (clsPos != clsEnd) {
+			if (isWhitespace(*clsPos)) {
+				clsPos++;
+			} else if (*clsPos == '/' && clsPos + 1 != clsEnd && clsPos[1] == '/') {
+				const char *newline = (const char *)
+						std::memchr(clsPos, '\n', clsEnd - clsPos);
+				clsPos = newline ? newline + 1 : clsEnd;
+			} else if (*clsPos == '/' && clsPos + 1 != clsEnd && clsPos[1] == '*') {
+				const char *pos = clsPos + 2;
+				while (true) {
+					pos = (const char *) std::memchr(pos, '*', clsEnd - pos);
+					if (!pos || pos + 1 == clsEnd)
+						return false;
+					if (pos[1] == '/')
+						break;
+					pos++;
+				} // end while
+				clsPos = pos + 2;
+			} else {
+				break;
+			} // end else
+		} // end while
+		return true;
+	} // end method
+}; // end class
+
+} // end namespace
+
+// -----------------------------------------------------------------------------
+
+bool MappedVerilogReader::parse(const char *begin, const char *end) {
+	clsEnd = end;
+
+	const char *body = nullptr;
+	if (!parseHeader(begin, body))
+		return false;
+
+	const std::size_t size = end - body;
+	const std::size_t maxChunks = 4 * (getSharedThreadPool().getNumThreads() + 1);
+	const int numChunks = (int) std::max<std::size_t>(1,
+			std::min<std::size_t>(maxChunks, size / MIN_CHUNK_SIZE));
+
+	// If a chunk starts inside a comment, the chunks do not line up. In this
+	// case the body is parsed again as a single chunk.
+	if (!parseBody(body, numChunks)) {
+		if (numChunks == 1 || !parseBody(body, 1))
+			return false;
+	} // end if
+
+	resolveNets();
+	buildDescriptor();
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+bool MappedVerilogReader::parseHeader(const char *begin, const char *&body) {
+	Lexer lexer(begin, clsEnd);
+
+	if (lexer.next().type != TOKEN_MODULE)
+		return false;
+
+	const Token name = lexer.next();
+	if (name.type != TOKEN_IDENTIFIER)
+		return false;
+	clsModuleName = name.text;
+
+	// The identifiers in the port list are ignored. Ports are read from the
+	// input and output declarations.
+	Token token = lexer.next();
+	if (isSymbol(token, '(')) {
+		do {
+			if (lexer.next().type != TOKEN_IDENTIFIER)
+				return false;
+			token = lexer.next();
+		} while (isSymbol(token, ','));
+
+		if (!isSymbol(token, ')'))
+			return false;
+		token = lexer.next();
+	} // end if
+
+	if (!isSymbol(token, ';'))
+		return false;
+
+	body = lexer.getPosition();
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+bool MappedVerilogReader::parseBody(const char *begin, const int numChunks) {
+	clsChunks.clear();
+	clsChunks.resize(numChunks);
+
+	// Chunks start right after a semicolon, which is a statement boundary
+	// unless it is inside a comment.
+	const std::size_t size = clsEnd - begin;
+	clsChunks[0].begin = begin;
+	for (int i = 1; i < numChunks; i++) {
+		const char *pos = std::max(clsChunks[i - 1].begin, begin + (size * i) / numChunks);
+		const char *semicolon = (const char *) std::memchr(pos, ';', clsEnd - pos);
+		clsChunks[i].begin = semicolon ? semicolon + 1 : clsEnd;
+		clsChunks[i - 1].limit = clsChunks[i].begin;
+	} // end for
+	clsChunks.back().limit = clsEnd;
+
+	ParallelInternal::processChunks(getSharedThreadPool(), numChunks,
+			[&](const int i) {
+		parseChunk(clsChunks[i], i == numChunks - 1);
+	});
+
+	// Each chunk must end exactly where the next one starts. Since the first
+	// chunk starts at a statement boundary, so do all others.
+	for (int i = 0; i < numChunks - 1; i++) {
+		const Chunk &chunk = clsChunks[i];
+		if (!chunk.valid || chunk.endModule || chunk.end != chunk.limit)
+			return false;
+	} // end for
+
+	const Chunk &last = clsChunks.back();
+	return last.valid && last.endModule;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void MappedVerilogReader::parseChunk(Chunk &chunk, const bool last) {
+	Lexer lexer(chunk.begin, clsEnd);
+
+	// The last chunk goes up to endmodule.
+	while (last || lexer.getPosition() < chunk.limit) {
+		const Token token = lexer.next();
+
+		Statement statement;
+		statement.firstToken = (int) chunk.tokens.size();
+
+		switch (token.type) {
+			case TOKEN_END_MODULE:
+				chunk.endModule = true;
+				chunk.valid = lexer.next().type == TOKEN_END;
+				chunk.end = lexer.getPosition();
+				return;
+			case TOKEN_INPUT:
+				statement.type = STATEMENT_INPUT;
+				break;
+			case TOKEN_OUTPUT:
+				statement.type = STATEMENT_OUTPUT;
+				break;
+			case TOKEN_WIRE:
+				statement.type = STATEMENT_WIRE;
+				break;
+			case TOKEN_IDENTIFIER:
+				statement.type = STATEMENT_INSTANCE;
+				break;
+			default:
+				return;
+		} // end switch
+
+		Token next;
+		if (statement.type == STATEMENT_INSTANCE) {
+			// cell instance ( .port(net), .port(), ... ) ;
+			const Token name = lexer.next();
+			if (name.type != TOKEN_IDENTIFIER || !isSymbol(lexer.next(), '('))
+				return;
+			chunk.tokens.push_back(token.text);
+			chunk.tokens.push_back(name.text);
+
+			next = lexer.next();
+			if (!isSymbol(next, ')')) {
+				while (true) {
+					if (!isSymbol(next, '.'))
+						return;
+
+					const Token port = lexer.next();
+					if (port.type != TOKEN_IDENTIFIER || !isSymbol(lexer.next(), '('))
+						return;
+
+					const Token net = lexer.next();
+					if (net.type == TOKEN_IDENTIFIER) {
+						if (!isSymbol(lexer.next(), ')'))
+							return;
+						chunk.tokens.push_back(port.text);
+						chunk.tokens.push_back(net.text);
+					} else if (isSymbol(net, ')')) {
+						// Unconnected ports are connected to a net named "".
+						chunk.tokens.push_back(port.text);
+						chunk.tokens.push_back(boost::string_ref());
+					} else {
+						return;
+					} // end else
+
+					next = lexer.next();
+					if (isSymbol(next, ')'))
+						break;
+					if (!isSymbol(next, ','))
+						return;
+					next = lexer.next();
+				} // end while
+			} // end if
+			next = lexer.next();
+		} else {
+			// input|output|wire identifier, identifier, ... ;
+			do {
+				const Token identifier = lexer.next();
+				if (identifier.type != TOKEN_IDENTIFIER)
+					return;
+				chunk.tokens.push_back(identifier.text);
+				next = lexer.next();
+			} while (isSymbol(next, ','));
+		} // end else
+
+		if (!isSymbol(next, ';'))
+			return;
+
+		statement.numTokens = (int) chunk.tokens.size() - statement.firstToken;
+		chunk.statements.push_back(statement);
+	} // end while
+
+	chunk.end = lexer.getPosition();
+	chunk.valid = true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+int MappedVerilogReader::createNet(const boost::string_ref name, bool &alreadyExisted) {
+	auto result = clsNetMap.emplace(name, (int) clsNetNames.size());
+	alreadyExisted = !result.second;
+	if (!alreadyExisted) {
+		clsNetNames.push_back(name);
+		clsNetNumConnections.push_back(0);
+	} // end if
+	return result.first->second;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void MappedVerilogReader::resolveNets() {
+	Legacy::Design &design = clsVerilogDescriptor;
+
+	std::size_t numDeclaredNets = 0;
+	for (const Chunk &chunk : clsChunks) {
+		for (const Statement &statement : chunk.statements) {
+			if (statement.type != STATEMENT_INSTANCE)
+				numDeclaredNets += statement.numTokens;
+		} // end for
+	} // end for
+	clsNetMap.reserve(numDeclaredNets);
+
+	clsNumComponents = 0;
+	for (Chunk &chunk : clsChunks) {
+		chunk.firstComponent = clsNumComponents;
+
+		for (const Statement &statement : chunk.statements) {
+			const boost::string_ref *tokens = chunk.tokens.data() + statement.firstToken;
+
+			switch (statement.type) {
+				case STATEMENT_INPUT:
+				case STATEMENT_OUTPUT: {
+					const bool input = statement.type == STATEMENT_INPUT;
+					for (int i = 0; i < statement.numTokens; i++) {
+						const std::string name = tokens[i].to_string();
+
+						(input? design.primaryInputs : design.primaryOutputs).push_back(name);
+						Legacy::Design::Pin designPin;
+						designPin.name = name;
+						designPin.net = name;
+						designPin.direction = input? "INPUT" : "OUTPUT";
+						designPin.x = designPin.y = -1;
+						design.ports.push_back(designPin);
+
+						if (clsPorts.count(tokens[i])) {
+							std::cout << "[WARNING] Multiple definition of primary "
+									<< (input? "input" : "output") << " '" << name << "'\n";
+						} else {
+							bool alreadyExisted;
+							createNet(tokens[i], alreadyExisted);
+							clsPorts.insert(tokens[i]);
+						} // end else
+					} // end for
+					break;
+				} // end case
+
+				case STATEMENT_WIRE: {
+					for (int i = 0; i < statement.numTokens; i++) {
+						bool alreadyExisted;
+						createNet(tokens[i], alreadyExisted);
+						if (alreadyExisted && !clsPorts.count(tokens[i])) {
+							std::cout << "WARNING: Multiple definition of net '" << tokens[i] << "'\n";
+						} // end if
+					} // end for
+					break;
+				} // end case
+
+				case STATEMENT_INSTANCE: {
+					clsNumComponents++;
+					for (int i = 2; i < statement.numTokens; i += 2) {
+						const boost::string_ref netName = tokens[i + 1];
+
+						bool alreadyExisted;
+						const int net = createNet(netName, alreadyExisted);
+						if (!alreadyExisted) {
+							std::cout << "WARNING: Net '" << netName << "' is used without being declared.\n";
+						} // end if
+
+						chunk.connectionNets.push_back(net);
+						chunk.connectionSlots.push_back(clsNetNumConnections[net]++);
+					} // end for
+					break;
+				} // end case
+			} // end switch
+		} // end for
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void MappedVerilogReader::buildDescriptor() {
+	Legacy::Design &design = clsVerilogDescriptor;
+	ThreadPool &pool = getSharedThreadPool();
+
+	design.name = clsModuleName.to_string();
+
+	// Connection lists are sized beforehand, so each chunk fills its own slots.
+	const int numNets = (int) clsNetNames.size();
+	const int numNetChunks = std::min(numNets, (int) clsChunks.size());
+	design.nets.resize(numNets);
+	ParallelInternal::processChunks(pool, numNetChunks, [&](const int chunk) {
+		const int first = (int) (((long long) numNets * chunk) / numNetChunks);
+		const int last = (int) (((long long) numNets * (chunk + 1)) / numNetChunks);
+		for (int i = first; i < last; i++) {
+			design.nets[i].name = clsNetNames[i].to_string();
+			design.nets[i].connections.resize(clsNetNumConnections[i]);
+		} // end for
+	});
+
+	design.components.resize(clsNumComponents);
+	ParallelInternal::processChunks(pool, (int) clsChunks.size(), [&](const int index) {
+		const Chunk &chunk = clsChunks[index];
+
+		int component = chunk.firstComponent;
+		int connection = 0;
+		for (const Statement &statement : chunk.statements) {
+			if (statement.type != STATEMENT_INSTANCE)
+				continue;
+
+			const boost::string_ref *tokens = chunk.tokens.data() + statement.firstToken;
+
+			Legacy::Design::Component &designComponent = design.components[component++];
+			designComponent.id = tokens[0].to_string();
+			designComponent.name = tokens[1].to_string();
+			designComponent.fixed = true;
+			designComponent.placed = false;
+			designComponent.x = designComponent.y = -1;
+
+			for (int i = 2; i < statement.numTokens; i += 2, connection++) {
+				Legacy::Design::Net &designNet = design.nets[chunk.connectionNets[connection]];
+				Legacy::Design::Connection &designConnection =
+						designNet.connections[chunk.connectionSlots[connection]];
+				designConnection.pin = tokens[i].to_string();
+				designConnection.instance = designComponent.name;
+			} // end for
+		} // end for
+	});
+
+	// Add primary inputs and outputs as connections to their nets as done by
+	// SimplifiedVerilogReader::workaround().
+	for (const bool input : {true, false}) {
+		const std::vector<std::string> &names =
+				input? design.primaryInputs : design.primaryOutputs;
+		for (const std::string &netName : names) {
+			auto it = clsNetMap.find(boost::string_ref(netName));
+			if (it == clsNetMap.end()) {
+				std::cout << "WARNING: Primary " << (input? "input" : "output")
+						<< " without a corresponding net. NetName: " << netName << "\n";
+			} else {
+				Legacy::Design::Connection connection;
+				connection.instance = "PIN";
+				connection.pin = netName;
+				design.nets[it->second].connections.push_back(connection);
+			} // end else
+		} // end for
+	} // end for
+} // end method
+
+} // end namespace
@@ -0,0 +1,124 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MAPPED_VERILOG_READER_H
+#define MAPPED_VERILOG_READER_H
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "rsyn/io/legacy/PlacerInternals.h"
+#include "rsyn/util/Hash.h"
+
+namespace Parsing {
+
+////////////////////////////////////////////////////////////////////////////////
+// Fast path for the structural Verilog subset accepted by
+// SimplifiedVerilogReader: a single module with input, output and wire
+// declarations and cell instances with named port mappings.
+//
+// The input is expected to be memory-mapped. Tokens point directly into it and
+// are only copied when the descriptor is built. The module body is split at
+// statement boundaries and the pieces are tokenized in parallel. Nets are then
+// numbered sequentially, in the order they appear, so the descriptor (and the
+// warnings) are the same as the ones from SimplifiedVerilogReader.
+////////////////////////////////////////////////////////////////////////////////
+
+class MappedVerilogReader {
+public:
+
+	MappedVerilogReader(Legacy::Design &verilogDescriptor) :
+		clsVerilogDescriptor(verilogDescriptor) {}
+
+	//! @brief Parses the text in [begin, end). Returns false, without changing
+	//!        the descriptor, if the text is not in the supported subset (in
+	//!        which case it should be parsed by SimplifiedVerilogReader).
+	bool parse(const char *begin, const char *end);
+
+private:
+
+	enum StatementType {
+		STATEMENT_INPUT,
+		STATEMENT_OUTPUT,
+		STATEMENT_WIRE,
+		STATEMENT_INSTANCE
+	}; // end enum
+
+	// Tokens of a statement. For port and net declarations these are the
+	// identifiers. For instances these are the cell type, the instance name
+	// and then a (port, net) pair per connection.
+	struct Statement {
+		StatementType type;
+		int firstToken;
+		int numTokens;
+	}; // end struct
+
+	// Statements starting in [begin, limit).
+	struct Chunk {
+		const char *begin = nullptr;
+		const char *limit = nullptr;
+
+		// Position after the last statement parsed.
+		const char *end = nullptr;
+
+		// False if some statement could not be parsed.
+		bool valid = false;
+
+		// True if endmodule was found.
+		bool endModule = false;
+
+		std::vector<boost::string_ref> tokens;
+		std::vector<Statement> statements;
+
+		// Index of the first component created by this chunk.
+		int firstComponent = 0;
+
+		// Net and position in the net connection list of each connection.
+		std::vector<int> connectionNets;
+		std::vector<int> connectionSlots;
+	}; // end struct
+
+	Legacy::Design &clsVerilogDescriptor;
+
+	const char *clsEnd = nullptr;
+
+	boost::string_ref clsModuleName;
+	std::vector<Chunk> clsChunks;
+
+	std::vector<boost::string_ref> clsNetNames;
+	std::vector<int> clsNetNumConnections;
+	std::unordered_map<boost::string_ref, int, Rsyn::StringRefHash> clsNetMap;
+	std::unordered_set<boost::string_ref, Rsyn::StringRefHash> clsPorts;
+
+	int clsNumComponents = 0;
+
+	bool parseHeader(const char *begin, const char *&body);
+	bool parseBody(const char *begin, const int numChunks);
+	void parseChunk(Chunk &chunk, const bool last);
+
+	int createNet(const boost::string_ref name, bool &alreadyExisted);
+
+	//! @brief Reads the ports and numbers the nets visiting the statements in
+	//!        file order.
+	void resolveNets();
+
+	//! @brief Copies the components and nets to the descriptor.
+	void buildDescriptor();
+}; // end class
+
+} // end namespace
+
+#endif
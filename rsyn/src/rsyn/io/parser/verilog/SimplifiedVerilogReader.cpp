@@ -18,6 +18,8 @@
 #include <cassert>
 
 #include "SimplifiedVerilogReader.h"
+#include "MappedVerilogReader.h"
+#include "rsyn/util/MappedFile.h"
 
 namespace Parsing {
 
@@ -29,6 +31,19 @@ SimplifiedVerilogReader::~SimplifiedVerilogReader() {
 // -----------------------------------------------------------------------------
 
 void SimplifiedVerilogReader::parseFromFile(const std::string &filename) {
+	// Fast path: most netlists only use the structural subset handled by the
+	// mapped reader. Anything else is parsed by the flex/bison parser below.
+	if (clsVerilogDescriptor.components.empty() && clsVerilogDescriptor.nets.empty()) {
+		Rsyn::MappedFile file;
+		if (file.open(filename)) {
+			MappedVerilogReader mappedReader(clsVerilogDescriptor);
+			if (mappedReader.parse(file.begin(), file.end())) {
+				std::cout << "Parse succeed.\n";
+				return;
+			} // end if
+		} // end if
+	} // end if
+
 	std::ifstream in_file(filename.c_str());
 	if (!in_file.good()) {
 		std::exit(1);
@@ -28,6 +28,8 @@
 
 #include "DesignPositionReader.h"
 
+#include <fstream>
+
 #include "rsyn/io/parser/lef_def/DEFControlParser.h"
 
 #include "rsyn/io/parser/bookshelf/BookshelfParser.h"
@@ -37,6 +39,7 @@
 
 #include "rsyn/phy/PhysicalService.h"
 #include "rsyn/phy/PhysicalDesign.h"
+#include "rsyn/io/Writer.h"
 
 #include "rsyn/util/Stepwatch.h"
 
@@ -59,6 +62,8 @@ void DesignPositionReader::load(Rsyn::Engine engine, const Json & config ) {
 		openBookshelf(path);
 	} else if (ext.compare(".def") == 0) {
 		openDef(path);
+	} else if (ext.compare(".delta") == 0) {
+		openPlacementDelta(path);
 	} else {
 		throw Exception("Invalid extension file in the path " + path);
 	} // end if-else 
@@ -117,5 +122,77 @@ void DesignPositionReader::openBookshelf(std::string & path) {
 
 // -----------------------------------------------------------------------------
 
+void DesignPositionReader::openPlacementDelta(std::string & path) {
+	std::ifstream file(path);
+	if (!file) {
+		throw Exception("Could not open placement delta '" + path + "'.\n");
+	} // end if
+
+	std::string keyword;
+	int version = 0;
+	std::string designName;
+	std::string baselineName;
+	std::uint64_t baselineDigest = 0;
+	int numCells = 0;
+
+	file >> keyword >> version;
+	if (keyword != "RSYN-PLACEMENT-DELTA" || version != 2) {
+		throw Exception("Invalid placement delta '" + path + "'.\n");
+	} // end if
+	file >> keyword >> designName;
+	file >> keyword >> baselineName;
+	file >> keyword >> std::hex >> baselineDigest >> std::dec;
+	file >> keyword >> numCells;
+	if (!file) {
+		throw Exception("Invalid placement delta '" + path + "'.\n");
+	} // end if
+
+	if (designName != clsDesign.getName()) {
+		std::cout << "[WARNING] Placement delta was written for design '"
+				<< designName << "'.\n";
+	} // end if
+
+	// The delta only lists the cells changed since the baseline, so it must be
+	// applied on top of the baseline placement.
+	if (Writer::computePlacementDigest(clsModule, clsPhysicalDesign) != baselineDigest) {
+		throw Exception("The current placement does not match the baseline '" +
+				baselineName + "' of placement delta '" + path + "'.\n");
+	} // end if
+
+	Stepwatch watch("Applying placement delta (baseline " + baselineName + ")");
+	for (int i = 0; i < numCells; i++) {
+		std::string cellName;
+		std::string libraryCellName;
+		DBU x;
+		DBU y;
+		if (!(file >> cellName >> x >> y >> libraryCellName)) {
+			throw Exception("Unexpected end of placement delta '" + path + "'.\n");
+		} // end if
+
+		Rsyn::Cell cell = clsDesign.findCellByName(cellName);
+		if (!cell) {
+			throw Exception("Cell '" + cellName + "' not found.\n");
+		} // end if
+
+		if (cell.getLibraryCellName() != libraryCellName) {
+			Rsyn::LibraryCell libraryCell = clsDesign.findLibraryCellByName(libraryCellName);
+			if (!libraryCell) {
+				throw Exception("Library cell '" + libraryCellName + "' not found.\n");
+			} // end if
+			cell.remap(libraryCell);
+		} // end if
+
+		if (cell.isFixed())
+			continue;
+		PhysicalCell physicalCell = clsPhysicalDesign.getPhysicalCell(cell);
+		clsPhysicalDesign.placeCell(physicalCell, DBUxy(x, y));
+	} // end for
+	watch.finish();
+
+	std::cout << "\tApplied changes: " << numCells << "\n";
+} // end method 
+
+// -----------------------------------------------------------------------------
+
 } // end namespace 
 
@@ -50,6 +50,9 @@ public:
 protected:
 	void openDef(std::string & path);
 	void openBookshelf(std::string & path);
+	//! @brief Applies a placement delta written by Writer::writePlacementDelta()
+	//!        on top of the current placement.
+	void openPlacementDelta(std::string & path);
 }; // end class 
 
 }
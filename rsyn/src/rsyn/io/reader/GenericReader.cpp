@@ -42,11 +42,72 @@
 #include "rsyn/phy/PhysicalDesign.h"
 #include "rsyn/util/Stepwatch.h"
 #include "rsyn/model/timing/Timer.h"
+#include "rsyn/io/parser/DescriptorSerialization.h"
+#include "rsyn/io/parser/SnapshotFormat.h"
+#include "rsyn/io/Writer.h"
+#include "rsyn/util/MappedFile.h"
 
 #include "rsyn/io/reader/GenericReader.h"
 
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <memory>
+#include <exception>
+#include <functional>
+
 namespace Rsyn {
 
+namespace {
+
+// An independent parsing stage (i.e. it only fills its own descriptor).
+struct ParsingStage {
+	std::string name;
+	std::function<void()> parse;
+	double runtime;
+	std::exception_ptr error;
+
+	ParsingStage(const std::string &name, const std::function<void()> &parse) :
+		name(name), parse(parse), runtime(0) {}
+}; // end struct
+
+// Runs the stages concurrently, one thread per stage, and returns when all of
+// them finish. Runtimes are reported afterwards in the order of the stages so
+// that the output does not depend on scheduling.
+void runParsingStages(std::vector<ParsingStage> &stages) {
+	auto run = [](ParsingStage &stage) {
+		Stepwatch watch(stage.name, false);
+		try {
+			stage.parse();
+		} catch (...) {
+			stage.error = std::current_exception();
+		} // end catch
+		watch.finish();
+		stage.runtime = watch.getElapsedTime();
+	}; // end lambda
+
+	std::vector<std::thread> threads;
+	for (int i = 1; i < stages.size(); i++) {
+		threads.emplace_back(run, std::ref(stages[i]));
+	} // end for
+	if (!stages.empty())
+		run(stages[0]);
+
+	for (std::thread &thread : threads) {
+		thread.join();
+	} // end for
+
+	for (const ParsingStage &stage : stages) {
+		if (stage.error)
+			std::rethrow_exception(stage.error);
+		std::cout << stage.name << "... Done (runtime: " << stage.runtime
+			<< " seconds)" << std::endl;
+	} // end for
+} // end function
+
+} // end namespace
+
+
 void GenericReader::load(Engine engine, const Json& params) {
 	std::string path = params.value("path", "");
 	
@@ -91,6 +152,7 @@ void GenericReader::load(Engine engine, const Json& params) {
 	if (params.count("sdcFile") && params.count("libFile")) {
 		sdcFile = path + params.value("sdcFile", "");
 		libertyFile = path + params.value("libFile", "");
+		enableLibertyCache = params.value("libertyCache", false);
 
 		enableTiming = true;
 
@@ -115,6 +177,9 @@ void GenericReader::load(Engine engine, const Json& params) {
 		enableTiming = true;
 	} // end if 
 
+	snapshotFile = params.value("writeSnapshot", "");
+	enableSnapshots = params.value("snapshots", false) || !snapshotFile.empty();
+
 	this->engine = engine;
 
 	parsingFlow();
@@ -125,34 +190,53 @@ void GenericReader::load(Engine engine, const Json& params) {
 void GenericReader::parsingFlow() {
 	Stepwatch watch("Running generic reader");
 
-	parseLEFFiles();
-
-	parseDEFFiles();
+	// The parser constructors set the global locale, which is not thread
+	// safe, so all parsers are constructed before the stages start.
+	LEFControlParser lefParser;
+	DEFControlParser defParser;
+	std::unique_ptr<LibertyControlParser> libertyParser;
+	std::unique_ptr<SDCControlParser> sdcParser;
+	if (enableTiming) {
+		libertyParser.reset(new LibertyControlParser());
+		sdcParser.reset(new SDCControlParser());
+	} // end if
 
+	// Each parser only fills its own descriptor, so they run concurrently. The
+	// design is populated only after all of them finish.
+	std::vector<ParsingStage> stages;
+	stages.emplace_back("Parsing DEF files", [&] { parseDEFFiles(defParser); });
+	stages.emplace_back("Parsing LEF files", [&] { parseLEFFiles(lefParser); });
 	if (enableNetlistFromVerilog)
-		parseVerilogFile();
+		stages.emplace_back("Parsing Verilog file", [&] { parseVerilogFile(); });
+	if (enableTiming) {
+		stages.emplace_back("Parsing Liberty file", [&] { parseLibertyFile(*libertyParser); });
+		stages.emplace_back("Parsing SDC file", [&] { parseSDCFile(*sdcParser); });
+	} // end if
 
-	if (enableTiming)
-		parseLibertyFile();
+	{
+		Stepwatch watchParsing("Parsing input files");
+		runParsingStages(stages);
+	} // end block
 
 	populateDesign();
 
-	if (enableTiming)
-		parseSDCFile();
-
 	initializeAuxiliarInfrastructure();
+
+	if (enableSnapshots)
+		keepSnapshotInputs();
+
+	if (!snapshotFile.empty()) {
+		Writer *writer = engine.getService("rsyn.writer");
+		writer->writeSnapshot(snapshotFile);
+	} // end if
 } // end method 
 
 // -----------------------------------------------------------------------------
 
-void GenericReader::parseLEFFiles() {
-	Stepwatch watch("Parsing LEF files");
-	LEFControlParser lefParser;
-
+void GenericReader::parseLEFFiles(LEFControlParser &lefParser) {
 	for (int i = 0; i < lefFiles.size(); i++) {
 		if (!boost::filesystem::exists(lefFiles[i])) {
-			std::cout << "[WARNING] Failed to open file " << lefFiles[i] << "\n";
-			std::exit(1);
+			throw Exception("Failed to open file " + lefFiles[i] + ".");
 		} // end if 
 
 		lefParser.parseLEF(lefFiles[i], lefDescriptor);
@@ -161,14 +245,10 @@ void GenericReader::parseLEFFiles() {
 
 // -----------------------------------------------------------------------------
 
-void GenericReader::parseDEFFiles() {
-	Stepwatch watch("Parsing DEF files");
-	DEFControlParser defParser;
-
+void GenericReader::parseDEFFiles(DEFControlParser &defParser) {
 	for (int i = 0; i < defFiles.size(); i++) {
 		if (!boost::filesystem::exists(defFiles[i])) {
-			std::cout << "[WARNING] Failed to open file " << defFiles[i] << "\n";
-			std::exit(1);
+			throw Exception("Failed to open file " + defFiles[i] + ".");
 		} // end if 
 
 		defParser.parseDEF(defFiles[i], defDescriptor);
@@ -178,11 +258,8 @@ void GenericReader::parseDEFFiles() {
 // -----------------------------------------------------------------------------
 
 void GenericReader::parseVerilogFile() {
-	Stepwatch watch("Parsing Verilog file");
-
 	if (!boost::filesystem::exists(verilogFile)) {
-		std::cout << "[WARNING] Failed to open file " << verilogFile << "\n";
-		std::exit(1);
+		throw Exception("Failed to open file " + verilogFile + ".");
 	} // end if 
 
 	Parsing::SimplifiedVerilogReader parser(verilogDescriptor);
@@ -206,6 +283,7 @@ void GenericReader::populateDesign() {
 	Json physicalDesignConfiguration;
 	physicalDesignConfiguration["clsEnableMergeRectangles"] = true;
 	physicalDesignConfiguration["clsEnableNetPinBoundaries"] = true;
+	physicalDesignConfiguration["clsEnablePinPositionCache"] = true;
 	physicalDesignConfiguration["clsEnableRowSegments"] = true;
 	engine.startService("rsyn.physical", physicalDesignConfiguration);
 	Rsyn::PhysicalService* phService = engine.getService("rsyn.physical");
@@ -217,33 +295,26 @@ void GenericReader::populateDesign() {
 
 // -----------------------------------------------------------------------------
 
-void GenericReader::parseLibertyFile() {
-	Stepwatch parsingLibertyWatch("Parsing Liberty file");
-
-	Rsyn::Design design = engine.getDesign();
-
+void GenericReader::parseLibertyFile(LibertyControlParser &libertyParser) {
 	if (!boost::filesystem::exists(libertyFile)) {
-		std::cout << "[WARNING] Failed to open file " << libertyFile << "\n";
-		std::exit(1);
+		throw Exception("Failed to open file " + libertyFile + ".");
 	} // end if 
 
-	LibertyControlParser libertyParser;
-	libertyParser.parseLiberty(libertyFile, libInfo);
+	if (enableLibertyCache) {
+		libertyParser.parseLibertyCached(libertyFile, libertyFile + ".rsyncache", libInfo);
+	} else {
+		libertyParser.parseLiberty(libertyFile, libInfo);
+	} // end else
 } // end method 
 
 // -----------------------------------------------------------------------------
 
-void GenericReader::parseSDCFile() {
-	Stepwatch watchParsingSdc("Parsing SDC file");
-	SDCControlParser sdcParser;
-
+void GenericReader::parseSDCFile(SDCControlParser &sdcParser) {
 	if (!boost::filesystem::exists(sdcFile)) {
-		std::cout << "[WARNING] Failed to open file " << sdcFile << "\n";
-		std::exit(1);
+		throw Exception("Failed to open file " + sdcFile + ".");
 	} // end if 
 
 	sdcParser.parseSDC_iccad15(sdcFile, sdcInfo);
-	watchParsingSdc.finish();
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -330,4 +401,96 @@ void GenericReader::initializeAuxiliarInfrastructure() {
 	engine.startService("rsyn.jezz",{});
 } // end method
 
+// -----------------------------------------------------------------------------
+
+template<class Archive>
+void GenericReader::serializeSnapshotLibrary(Archive &ar) {
+	ar & enableTiming;
+	ar & localWireCapacitancePerMicron & localWireResistancePerMicron;
+	ar & maxWireSegmentInMicron;
+
+	ar & lefDescriptor;
+	if (enableTiming)
+		ar & libInfo & sdcInfo;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<class Archive>
+void GenericReader::serializeSnapshotDesign(Archive &ar) {
+	// Must match Writer::writeSnapshot().
+	ar & enableNetlistFromVerilog;
+	ar & defDescriptor;
+	if (enableNetlistFromVerilog)
+		ar & verilogDescriptor;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void GenericReader::keepSnapshotInputs() {
+	std::ostringstream library;
+	BinaryOutputArchive ar(library);
+	serializeSnapshotLibrary(ar);
+
+	// Components and nets are taken from the design when the snapshot is
+	// written, so only the floorplan is kept. They are set aside while the
+	// floorplan is copied.
+	std::vector<DefComponentDscp> components;
+	std::vector<DefNetDscp> nets;
+	components.swap(defDescriptor.clsComps);
+	nets.swap(defDescriptor.clsNets);
+	const DefDscp floorplan = defDescriptor;
+	components.swap(defDescriptor.clsComps);
+	nets.swap(defDescriptor.clsNets);
+
+	Writer *writer = engine.getService("rsyn.writer");
+	writer->setSnapshotInputs(library.str(), floorplan);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+bool GenericReader::readSnapshot(const std::string &filename) {
+	Stepwatch watch("Reading snapshot");
+
+	MappedFile file;
+	if (!file.open(filename)) {
+		std::cout << "[ERROR] Failed to open snapshot " << filename << "\n";
+		return false;
+	} // end if
+
+	try {
+		BinaryInputArchive ar(file.begin(), file.end());
+
+		if (std::memcmp(ar.skip(sizeof(SNAPSHOT_MAGIC)), SNAPSHOT_MAGIC,
+				sizeof(SNAPSHOT_MAGIC)) != 0) {
+			std::cout << "[ERROR] " << filename << " is not a snapshot.\n";
+			return false;
+		} // end if
+
+		std::uint32_t version;
+		ar & version;
+		if (version != SNAPSHOT_VERSION) {
+			std::cout << "[ERROR] Snapshot " << filename << " has version "
+					<< version << " but version " << SNAPSHOT_VERSION
+					<< " is expected. Please regenerate it.\n";
+			return false;
+		} // end if
+
+		serializeSnapshotLibrary(ar);
+		serializeSnapshotDesign(ar);
+
+		if (!ar.eof()) {
+			std::cout << "[ERROR] Unexpected data at the end of snapshot "
+					<< filename << ".\n";
+			return false;
+		} // end if
+	} catch (const Exception &e) {
+		std::cout << "[ERROR] Snapshot " << filename << " is corrupted: "
+				<< e.what() << "\n";
+		return false;
+	} // end catch
+
+	return true;
+} // end method
+
 } // end namespace 
\ No newline at end of file
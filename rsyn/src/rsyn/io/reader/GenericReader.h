@@ -32,9 +32,15 @@
 #include "rsyn/engine/Engine.h"
 #include "rsyn/model/timing/types.h"
 
+class LEFControlParser;
+class DEFControlParser;
+class LibertyControlParser;
+class SDCControlParser;
+
 namespace Rsyn {
 
 class GenericReader : public Reader {
+protected:
 	Engine engine;	
 	
 	std::vector<std::string> lefFiles;
@@ -49,6 +55,22 @@ class GenericReader : public Reader {
 	
 	bool enableTiming = false;
 	bool enableNetlistFromVerilog = false;
+
+	//! @brief If true (parameter "libertyCache"), the Liberty library is loaded
+	//!        from a binary cache stored next to the Liberty file, which is
+	//!        created on the first run. Disabled by default as the directory
+	//!        of the Liberty file may be shared or read-only.
+	bool enableLibertyCache = false;
+
+	//! @brief If not empty, a snapshot of the design is written to this file
+	//!        once it is loaded (see SnapshotReader).
+	std::string snapshotFile;
+
+	//! @brief If true (parameter "snapshots"), the library and the floorplan
+	//!        are kept during the session so that snapshots can be written
+	//!        later on (command "writeSnapshot"). Implied by "writeSnapshot".
+	//!        Disabled by default as the library is kept serialized in memory.
+	bool enableSnapshots = false;
 	
 public:
 	GenericReader() = default;
@@ -56,26 +78,29 @@ public:
 	//! @brief Overriden method, responsible for processing the input parameters
 	//!		   and calling the parsing flow.
 	void load(Engine engine, const Json& params) override;
-private:
+protected:
 	LefDscp lefDescriptor;
 	DefDscp defDescriptor;
 	Legacy::Design verilogDescriptor;
 	ISPD13::LIBInfo libInfo;
 	ISPD13::SDCInfo sdcInfo;
 	
-	//! @brief	Defines the order in which the input files are going to be parsed.
+	//! @brief	Parses the input files concurrently and then populates the design.
 	void parsingFlow();
 	
 	//! @brief	Verifies the consistency of the input URLs and runs the LEF parser.
-	void parseLEFFiles();
+	//!         Parsers are constructed by the caller as their constructors
+	//!         set the global locale, which is not thread safe. Throws an
+	//!         exception if an input file does not exist.
+	void parseLEFFiles(LEFControlParser &lefParser);
 	//! @brief	Verifies the consistency of the input URLs and runs the DEF parser.
-	void parseDEFFiles();
+	void parseDEFFiles(DEFControlParser &defParser);
 	//! @brief	Verifies the consistency of the input URL and runs the Verilog parser.
 	void parseVerilogFile();
 	//! @brief	Verifies the consistency of the input URL and runs the Liberty parser.
-	void parseLibertyFile();
+	void parseLibertyFile(LibertyControlParser &libertyParser);
 	//! @brief	Verifies the consistency of the input URL and runs the SDC parser.
-	void parseSDCFile();
+	void parseSDCFile(SDCControlParser &sdcParser);
 	//! @brief	Populates Rsyn core data structures using the information read in the input files.
 	void populateDesign();
 	//! @brief  Initializes some services, depending on which files were specified:
@@ -86,6 +111,23 @@ private:
 	//!			Report is dependant on Timer;
 	//!			Graphics and Writer do not have dependencies.
 	void initializeAuxiliarInfrastructure();
+
+	//! @brief  Hands the inputs of a snapshot that do not change during the 
+	//!         session (library and floorplan) to the writer, so that 
+	//!         snapshots can be written later on (see Writer::writeSnapshot()).
+	//!         Must be called after initializeAuxiliarInfrastructure(), which
+	//!         starts the writer. The descriptors are not changed.
+	void keepSnapshotInputs();
+	//! @brief  Reads the descriptors from a binary snapshot. Returns false if
+	//!         the snapshot could not be read.
+	bool readSnapshot(const std::string &filename);
+	//! @brief  Lists the library section of a snapshot (see SnapshotFormat.h).
+	//!         Used for both reading and writing.
+	template<class Archive>
+	void serializeSnapshotLibrary(Archive &ar);
+	//! @brief  Lists the design section of a snapshot (see SnapshotFormat.h).
+	template<class Archive>
+	void serializeSnapshotDesign(Archive &ar);
 }; // end class
 
 } // end namespace 
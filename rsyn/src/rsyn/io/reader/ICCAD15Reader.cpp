@@ -174,6 +174,8 @@ void ICCAD15Reader::openBenchmarkFromICCAD15()  {
 	if(ENABLE_RECTANGLE_MERGE) {
 		phDesignJason["clsEnableMergeRectangles"] = true;
 	}// end if 
+	// Used by the free space queries of the ICCAD15 infrastructure.
+	phDesignJason["clsEnableRowOccupancy"] = true;
 	engine.startService("rsyn.physical", phDesignJason);	
 	Rsyn::PhysicalService * phService = engine.getService("rsyn.physical");
 	Rsyn::PhysicalDesign clsPhysicalDesign = phService->getPhysicalDesign();
@@ -102,6 +102,17 @@ void PopulateRsyn::populateRsynNetlistFromVerilog(
 	Rsyn::Module top = rsynDesign.getTopModule();
 	rsynDesign.updateName(verilogDesign.name);
 
+	// Builds the netlist in bulk load mode.
+	int numPins = 0;
+	for (auto &net : verilogDesign.nets)
+		numPins += net.connections.size();
+
+	rsynDesign.beginBulkLoad(
+		verilogDesign.primaryInputs.size() +
+		verilogDesign.primaryOutputs.size() +
+		verilogDesign.components.size(),
+		verilogDesign.nets.size(), numPins);
+
 	keepWarning = true;
 	keepWarningCounter = 0;
 	for (auto &port : verilogDesign.primaryInputs) {
@@ -205,6 +216,8 @@ void PopulateRsyn::populateRsynNetlistFromVerilog(
 			} // end else
 		} // end for
 	} // end for
+
+	rsynDesign.endBulkLoad();
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -227,6 +240,18 @@ void PopulateRsyn::populateRsyn(
 	// also cells using LEF.
 	populateRsynLibraryFromLef(lefDscp, rsynDesign);
 
+	// Builds the netlist in bulk load mode.
+	int numPins = 0;
+	for (auto &net : verilogDesign.nets)
+		numPins += net.connections.size();
+
+	rsynDesign.beginBulkLoad(
+		defDscp.clsPorts.size() +
+		verilogDesign.primaryInputs.size() +
+		verilogDesign.primaryOutputs.size() +
+		defDscp.clsComps.size(),
+		verilogDesign.nets.size(), numPins);
+
 	// Creates ports.
 	for (const DefPortDscp &port : defDscp.clsPorts) {
 
@@ -339,6 +364,8 @@ void PopulateRsyn::populateRsyn(
 			} // end else
 		} // end for
 	} // end for
+
+	rsynDesign.endBulkLoad();
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -360,6 +387,15 @@ void PopulateRsyn::populateRsyn(
 	// also cells using LEF.
 	populateRsynLibraryFromLef(lefDscp, rsynDesign);
 
+	// Builds the netlist in bulk load mode.
+	int numPins = 0;
+	for (const DefNetDscp &net : defDscp.clsNets)
+		numPins += net.clsConnections.size();
+
+	rsynDesign.beginBulkLoad(
+		defDscp.clsPorts.size() + defDscp.clsComps.size(),
+		defDscp.clsNets.size(), numPins);
+
 	// Creates ports.
 	for (const DefPortDscp &port : defDscp.clsPorts) {
 
@@ -422,6 +458,8 @@ void PopulateRsyn::populateRsyn(
 			} // end else
 		} // end for
 	} // end for
+
+	rsynDesign.endBulkLoad();
 } // end method
 
 // -----------------------------------------------------------------------------
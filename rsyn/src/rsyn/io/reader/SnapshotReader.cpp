@@ -0,0 +1,51 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rsyn/util/Stepwatch.h"
+
+#include "rsyn/io/reader/SnapshotReader.h"
+
+namespace Rsyn {
+
+void SnapshotReader::load(Engine engine, const Json& params) {
+	std::string path = params.value("path", "");
+
+	if (!path.empty() && path.back() != '/')
+		path += "/";
+
+	if (!params.count("snapshotFile")) {
+		std::cout << "[ERROR] snapshot file not specified...\n";
+		return;
+	} // end if
+
+	const std::string filename = path + params.value("snapshotFile", "");
+
+	this->engine = engine;
+	enableSnapshots = params.value("snapshots", false);
+
+	Stepwatch watch("Running snapshot reader");
+
+	if (!readSnapshot(filename))
+		return;
+
+	populateDesign();
+
+	initializeAuxiliarInfrastructure();
+
+	if (enableSnapshots)
+		keepSnapshotInputs();
+} // end method
+
+} // end namespace
@@ -0,0 +1,41 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_SNAPSHOTREADER_H
+#define RSYN_SNAPSHOTREADER_H
+
+#include "rsyn/io/reader/GenericReader.h"
+
+namespace Rsyn {
+
+//! @brief Loads a design from a binary snapshot written by the writer (command
+//!        "writeSnapshot" or generic reader parameter "writeSnapshot"). The
+//!        snapshot stores descriptors of the library and of the design, so the
+//!        design is restored without parsing the input files.
+//!        Derived data (e.g. Steiner trees and timing) is rebuilt as in the
+//!        generic reader. As there, snapshots can only be written again if
+//!        the parameter "snapshots" is set.
+class SnapshotReader : public GenericReader {
+public:
+	SnapshotReader() = default;
+
+	//! @brief Overriden method, responsible for processing the input parameters
+	//!		   and loading the snapshot.
+	void load(Engine engine, const Json& params) override;
+}; // end class
+
+} // end namespace
+
+#endif /* RSYN_SNAPSHOTREADER_H */
@@ -58,4 +58,11 @@ void DensityGridService::stop() {
 	
 } // end method 
 
+// -----------------------------------------------------------------------------
+
+void DensityGridService::reportMemoryUsage(Rsyn::MemoryReport &report) {
+	if (clsDensityGrid.isInitialized())
+		report.add("bins", clsDensityGrid.getMemoryUsage());
+} // end method 
+
 } // end namespace
\ No newline at end of file
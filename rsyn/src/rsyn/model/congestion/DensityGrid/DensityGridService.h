@@ -44,6 +44,7 @@ public:
 	DensityGridService () {}
 	virtual void start(Rsyn::Engine engine, const Rsyn::Json &params) override;
 	virtual void stop() override;
+	virtual void reportMemoryUsage(Rsyn::MemoryReport &report) override;
 
 	Rsyn::DensityGrid getDensityGrid() { return clsDensityGrid; }
 }; // end class
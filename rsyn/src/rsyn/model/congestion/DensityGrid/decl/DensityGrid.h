@@ -113,6 +113,9 @@ public:
 	// update area usage of the bins and the abu violation
 	void updateAbu(bool showDetails = false);
 	
+	// estimate of the memory allocated by the bins in bytes
+	std::size_t getMemoryUsage() const;
+	
 protected:
 	// Adding out of row bound region to fixed area of the bin
 	void updatePlaceableArea(const bool storeRowBounds = false);
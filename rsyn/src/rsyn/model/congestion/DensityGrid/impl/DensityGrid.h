@@ -29,6 +29,21 @@ inline bool DensityGrid::isInitialized() const {
 
 // -----------------------------------------------------------------------------
 
+inline std::size_t DensityGrid::getMemoryUsage() const {
+	std::size_t bytes = data->clsBins.capacity() * sizeof(DensityGridBin);
+	for (const DensityGridBin &bin : data->clsBins) {
+		bytes += bin.clsAreas.capacity() * sizeof(DBU);
+		bytes += bin.clsNumPins.capacity() * sizeof(int);
+		bytes += bin.clsRows.capacity() * sizeof(Bounds);
+		bytes += bin.clsBlockages.capacity() * sizeof(DensityGridBlockage);
+		for (const DensityGridBlockage &blockage : bin.clsBlockages)
+			bytes += blockage.allBounds().capacity() * sizeof(Bounds);
+	} // end for
+	return bytes;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
 inline void DensityGrid::init(Rsyn::PhysicalDesign phDesign, Rsyn::Module module, double targetUtilization,
 	double unit, bool showDetails, const bool keepRowBounds) {
 	if (data) {
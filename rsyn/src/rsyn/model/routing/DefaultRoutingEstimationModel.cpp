@@ -74,6 +74,8 @@ DBU DefaultRoutingEstimationModel::generateSteinerTree(Rsyn::Net net, Rsyn::Rout
 	DBU netSteinerWirelength = 0;
 	std::set<std::tuple<int, int>> edges;
 
+	const bool usePinPositionCache = clsPhysicalDesign.isEnablePinPositionCache();
+
 	// Build the Steiner tree.
 	if (ENABLE_DO_NOT_USE_FLUTE_FOR_2_PIN_NETS && numPins == 2) {
 		// [NOTE] For 2-pin nets, ICCAD 2014 Contest evaluation script does
@@ -83,7 +85,9 @@ DBU DefaultRoutingEstimationModel::generateSteinerTree(Rsyn::Net net, Rsyn::Rout
 		DBU y[2];
 		for (Rsyn::Pin pin : net.allPins()) {
 
-			const DBUxy pinPos = clsPhysicalDesign.getPinPosition(pin);
+			const DBUxy pinPos = usePinPositionCache ?
+					clsPhysicalDesign.getCachedPinPosition(pin) :
+					clsPhysicalDesign.getPinPosition(pin);
 			x[counter] = pinPos[X];
 			y[counter] = pinPos[Y];
 
@@ -114,7 +118,9 @@ DBU DefaultRoutingEstimationModel::generateSteinerTree(Rsyn::Net net, Rsyn::Rout
 		FLUTE_DTYPE *y = new FLUTE_DTYPE[numPins];
 		for (Rsyn::Pin pin : net.allPins()) {
 
-			const DBUxy pinPos = clsPhysicalDesign.getPinPosition(pin);
+			const DBUxy pinPos = usePinPositionCache ?
+					clsPhysicalDesign.getCachedPinPosition(pin) :
+					clsPhysicalDesign.getPinPosition(pin);
 			x[counter] = (FLUTE_DTYPE) (pinPos[X]);
 			y[counter] = (FLUTE_DTYPE) (pinPos[Y]);
 
@@ -431,6 +431,10 @@ public:
 	// TODO: Add description.
 	int getNumNodes() const;
 
+	//! @brief Returns an estimate of the heap memory owned by this tree in
+	//!        bytes.
+	std::size_t getMemoryUsage() const;
+
 	// TODO: Add description.
 	const Node &getNode(const int index) const;
 
@@ -1472,6 +1476,21 @@ int RCTreeBaseTemplate<NameType, TagType>::getNumNodes() const {
 
 // -----------------------------------------------------------------------------
 
+template<class NameType, class TagType>
+inline
+std::size_t RCTreeBaseTemplate<NameType, TagType>::getMemoryUsage() const {
+	std::size_t bytes =
+			clsNodeNames.capacity() * sizeof(NameType) +
+			clsNodeTags.capacity() * sizeof(TagType) +
+			clsNodes.capacity() * sizeof(Node) +
+			clsCeffs.capacity() * sizeof(EdgeArray<Number>);
+	for (const Node &node : clsNodes)
+		bytes += node.propSinks.capacity() * sizeof(int);
+	return bytes;
+} // end method
+
+// -----------------------------------------------------------------------------
+
 template<class NameType, class TagType>
 inline
 const typename RCTreeBaseTemplate<NameType, TagType>::Node &
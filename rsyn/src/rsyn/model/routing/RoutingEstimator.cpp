@@ -18,6 +18,9 @@
 #include "rsyn/model/routing/DefaultRoutingExtractionModel.h"
 #include "rsyn/engine/Engine.h"
 #include "rsyn/phy/PhysicalService.h"
+#include "rsyn/io/parser/spef/SPEFStreamReader.h"
+#include "rsyn/model/timing/Timer.h"
+#include "rsyn/util/Stepwatch.h"
 
 namespace Rsyn {
 
@@ -84,6 +87,32 @@ void RoutingEstimator::start(Engine engine, const Json &params) {
 			} // end if
 		});
 	} // end block
+
+	{ // readSPEF
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("readSPEF");
+		dscp.setDescription("Reads the parasitics of the nets from a SPEF file.");
+
+		dscp.addPositionalParam("fileName",
+			ScriptParsing::PARAM_TYPE_STRING,
+			ScriptParsing::PARAM_SPEC_MANDATORY,
+			"Path to the SPEF file.");
+
+		engine.registerCommand(dscp, [&](Rsyn::Engine engine, const ScriptParsing::Command &command) {
+			const std::string fileName = command.getParam("fileName");
+
+			Stepwatch watch("Reading SPEF");
+			SPEFStreamReader reader(design, this);
+			reader.read(fileName);
+
+			// The timer is not aware of user-specified routing changes.
+			Timer *timer = engine.getService("rsyn.timer", Rsyn::SERVICE_OPTIONAL);
+			if (timer) {
+				for (Rsyn::Net net : reader.getAnnotatedNets())
+					timer->dirtyNet(net);
+			} // end if
+		});
+	} // end block
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -93,6 +122,18 @@ void RoutingEstimator::stop() {
 
 // -----------------------------------------------------------------------------
 
+void RoutingEstimator::reportMemoryUsage(Rsyn::MemoryReport &report) {
+	std::size_t rctrees = 0;
+	for (Rsyn::Net net : module.allNets()) {
+		rctrees += clsRoutingNets[net].rctree.getMemoryUsage();
+	} // end for
+
+	report.add("nets", clsRoutingNets->getMemoryUsage());
+	report.add("rc trees", rctrees);
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void RoutingEstimator::onPostNetCreate(Rsyn::Net net) {
 	std::cout << "INFO: RoutingEstimator was notified about a new net.\n";
 	clsDirtyNets.insert(net);
@@ -119,6 +160,17 @@ void RoutingEstimator::updateRoutingOfNet(Rsyn::Net net) {
 
 	RoutingNet &timingNet = clsRoutingNets[net];
 
+	// User-specified parasitics are kept, but pin loads may have changed (e.g.
+	// due to a remap). They are dropped if the pins of the net changed, as new
+	// sinks would not be timed.
+	if (timingNet.rctree.hasUserSpecifiedRouting()) {
+		if (matchesPins(timingNet.rctree, net)) {
+			updateLoadCaps(timingNet.rctree);
+			return;
+		} // end if
+		timingNet.rctree.clear();
+	} // end if
+
 	// Incrementally update the Steiner wirelength;
 	clsTotalWirelength -= timingNet.wirelength;
 
@@ -138,6 +190,64 @@ void RoutingEstimator::updateRoutingOfNet(Rsyn::Net net) {
 
 // -----------------------------------------------------------------------------
 
+bool RoutingEstimator::setUserSpecifiedRouting(Rsyn::Net net, const RCTreeDescriptor &dscp, const int root) {
+	RCTree &tree = clsRoutingNets[net].rctree;
+	const bool noLoops = tree.build(dscp, root, true, true);
+	updateLoadCaps(tree);
+	return noLoops;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void RoutingEstimator::clearUserSpecifiedRouting(Rsyn::Net net) {
+	RCTree &tree = clsRoutingNets[net].rctree;
+	if (tree.hasUserSpecifiedRouting()) {
+		tree.clear();
+		dirtyNet(net);
+	} // end if
+} // end method
+
+// -----------------------------------------------------------------------------
+
+bool RoutingEstimator::matchesPins(const RCTree &tree, Rsyn::Net net) const {
+	int numPins = 0;
+	const int numRCTreeNodes = tree.getNumNodes();
+	for (int i = 0; i < numRCTreeNodes; i++) {
+		Rsyn::Pin pin = tree.getNodeTag(i).getPin();
+		if (!pin)
+			continue;
+		if (pin.getNet() != net)
+			return false;
+		numPins++;
+	} // end for
+	return numPins == net.getNumPins();
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void RoutingEstimator::updateLoadCaps(RCTree &tree) const {
+	const int numRCTreeNodes = tree.getNumNodes();
+	for (int i = 1; i < numRCTreeNodes; i++) { // start @ 1 to skip root node
+		Rsyn::Pin pin = tree.getNodeTag(i).getPin();
+		if (!pin)
+			continue;
+
+		EdgeArray<Number> load;
+		if (pin.isPort()) {
+			const Number outputCap = clsScenario->getOutputLoad(pin.getInstance().asPort(), 0);
+			load.setBoth(outputCap);
+		} else {
+			load.setBoth(clsScenario->getTimingLibraryPin(pin.getLibraryPin()).getCapacitance());
+		} // end else
+
+		tree.setNodeLoadCap(i, load);
+	} // end for
+
+	tree.updateDownstreamCap();
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void RoutingEstimator::updateRoutingFull() { 
 	StopwatchGuard guard(clsStopwatchUpdateSteinerTrees);
 	
@@ -55,10 +55,18 @@ private:
 	
 	Rsyn::Attribute<Rsyn::Net, RoutingNet> clsRoutingNets;
 	
+	// Sets the load capacitance of the nodes connected to sink pins.
+	void updateLoadCaps(RCTree &tree) const;
+
+	// Returns true if the pins tagged in the tree are exactly the pins of the
+	// net.
+	bool matchesPins(const RCTree &tree, Rsyn::Net net) const;
+	
 public:
 	
 	virtual void start(Engine engine, const Json &params);
 	virtual void stop();
+	virtual void reportMemoryUsage(Rsyn::MemoryReport &report) override;
 
 	void setRoutingEstimationModel(RoutingEstimationModel *model) { routingEstimationModel = model; }
 	void setRoutingExtractionModel(RoutingExtractionModel *model) { routingExtractionModel = model; }
@@ -87,6 +95,18 @@ public:
 	void updateRoutingOfNet(Rsyn::Net net);
 	void updateRoutingFull();
 	void updateRouting();
+
+	//! @brief Replaces the estimated routing of a net by user-specified
+	//!        parasitics (e.g. read from a SPEF file). The root is the node
+	//!        connected to the driver and pins are taken from the node tags.
+	//!        User-specified trees are kept by routing updates, which only
+	//!        refresh their pin loads. May be called concurrently for different
+	//!        nets. Returns false if a loop was detected (and removed).
+	bool setUserSpecifiedRouting(Rsyn::Net net, const RCTreeDescriptor &dscp, const int root);
+
+	//! @brief Discards the user-specified parasitics of a net. The net is
+	//!        routed again in the next routing update.
+	void clearUserSpecifiedRouting(Rsyn::Net net);
 	
 	void dirtyInstance(Rsyn::Instance instance) {
 		for (Rsyn::Pin pin : instance.allPins()) {
@@ -27,7 +27,9 @@ namespace Rsyn {
 
 class Timer;
 
-class DefaultTimingModel : public TimingModel, public Service {
+// Declared final so that the timers can resolve calls to this model at compile
+// time (see TimingPropagation.h).
+class DefaultTimingModel final : public TimingModel, public Service {
 public:
 
 	virtual void start(Engine engine, const Json &params) override;
@@ -143,6 +145,36 @@ private:
 		return EdgeArray<Number>(load, load);
 	} // end method
 
+	EdgeArray<Number> computeNetPinLoad(Rsyn::SandboxNet net, const TimingMode mode) {
+		EdgeArray<Number> load(0, 0);
+		for (Rsyn::SandboxPin pin : net.allPins(Rsyn::SINK)) {
+			switch (pin.getInstanceType()) {
+			case Rsyn::CELL:
+				load += getLibraryPinInputCapacitance(pin.getLibraryPin());
+				break;
+			case Rsyn::PORT: {
+				Rsyn::SandboxPort port = pin.getPort();
+				if (port.isVirtual()) {
+					// The virtual port stands for the design net driven by
+					// the attached pin, so it loads the driver as that net.
+					Rsyn::Pin relatedPin = port.getAttachedPin().getRelated();
+					if (relatedPin) {
+						EdgeArray<Number> netLoad(0, 0);
+						calculateLoadCapacitance(relatedPin, mode, netLoad);
+						load += netLoad;
+					} // end if
+				} else {
+					Rsyn::Port relatedPort = port.getRelated();
+					if (relatedPort)
+						load += clsScenario->getOutputLoad(relatedPort, 0);
+				} // end else
+				break;
+			} // end case
+			} // end switch
+		} // end for
+		return load;
+	} // end method
+
 	EdgeArray<Number> getSetupTime(Scenario::TimingLibraryPin &timingLibraryPin) const {
 		// HARD CODED
 		EdgeArray<Number> tsetup(0, 0);
@@ -324,7 +356,14 @@ public:
 	const Rsyn::SandboxPin pin,
 	const TimingMode mode,
 	EdgeArray<Number> &load) {
-		load.set(0, 0);
+		// Note: Assuming ideal interconnect, so only the pin loads are
+		// accounted for, as done by the design timing for ideal nets.
+		Rsyn::SandboxNet net = pin.getNet();
+		if (net) {
+			load = computeNetPinLoad(net, mode);
+		} else {
+			load.set(0, 0);
+		} // end else
 	} // end method
 
 	virtual
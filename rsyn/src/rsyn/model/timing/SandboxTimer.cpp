@@ -22,7 +22,10 @@
 #include "rsyn/sandbox/Sandbox.h"
 
 #include "rsyn/model/timing/SandboxTimer.h"
+#include "rsyn/model/timing/TimingPropagation.h"
+#include "rsyn/model/timing/DefaultTimingModel.h"
 #include "rsyn/model/scenario/Scenario.h"
+#include "rsyn/model/routing/RoutingEstimator.h"
 
 #include "rsyn/util/FloatingPoint.h"
 #include "rsyn/util/ThreadPool.h"
@@ -37,6 +40,11 @@ const bool SandboxTimer::ENABLE_UITIMER_COMPATIBILITY_MODE = true;
 
 // -----------------------------------------------------------------------------
 
+typedef TimingPropagation<SandboxTimer, SandboxTimingView, TimingModel> GenericPropagation;
+typedef TimingPropagation<SandboxTimer, SandboxTimingView, DefaultTimingModel> DefaultPropagation;
+
+// -----------------------------------------------------------------------------
+
 // [TODO] Use functors, not lambda.
 
 const std::function<bool(const Number a, const Number b)>
@@ -188,15 +196,30 @@ void SandboxTimer::uninitializeTimingCell(Rsyn::SandboxCell rsynCell) {
 
 // -----------------------------------------------------------------------------
 
+void SandboxTimer::setTimingModel(TimingModel &model) {
+	timingModel = &model;
+	clsDefaultTimingModel = dynamic_cast<DefaultTimingModel *>(&model);
+	clsForceFullTimingUpdate = true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void SandboxTimer::init(Rsyn::Engine rsynEngine, Rsyn::Sandbox rsynSandbox) {
 	engine = rsynEngine;
-	design = rsynSandbox.getDesign();
-	sandbox = rsynSandbox;
 
 	clsScenario = rsynEngine.getService("rsyn.scenario");
 	clsTimer = rsynEngine.getService("rsyn.timer");
 
-	timingModel = clsTimer->getTimingModel();
+	setTimingModel(*clsTimer->getTimingModel());
+
+	reset(rsynSandbox);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SandboxTimer::reset(Rsyn::Sandbox rsynSandbox) {
+	design = rsynSandbox.getDesign();
+	sandbox = rsynSandbox;
 
 	clsMaxCentrality[EARLY] = 0;
 	clsMaxCentrality[LATE ] = 0;
@@ -204,10 +227,26 @@ void SandboxTimer::init(Rsyn::Engine rsynEngine, Rsyn::Sandbox rsynSandbox) {
 	clsSign = 0;
 	clsForceFullTimingUpdate = true;
 
-	// Initializing Layers
-	clsNetLayer = rsynSandbox.createAttribute();
-	clsPinLayer = rsynSandbox.createAttribute();
-	clsArcLayer = rsynSandbox.createAttribute();
+	clsClockNet = nullptr;
+	clsClockPort = nullptr;
+
+	for (const TimingMode mode : allTimingModes()) {
+		clsCriticalEndpoints[mode].clear();
+	} // end for
+
+	sequentialCells.clear();
+	endpoints.clear();
+	ties.clear();
+	floatingEndpoints.clear();
+	floatingStartpoints.clear();
+	dirtyNets.clear();
+	clsDirtyTimingCells.clear();
+
+	// Initializing Layers (storage is reused if the timer is being reset)
+	clsNetLayer.rebind(rsynSandbox.createAttribute());
+	clsPinLayer.rebind(rsynSandbox.createAttribute());
+	clsArcLayer.rebind(rsynSandbox.createAttribute());
+	clsPortConstraints.rebind(rsynSandbox.createAttribute());
 
 	// More initializations.
 	for (Rsyn::SandboxInstance instance : sandbox.allInstances()) {
@@ -308,124 +347,191 @@ void SandboxTimer::init(Rsyn::Engine rsynEngine, Rsyn::Sandbox rsynSandbox) {
 
 // -----------------------------------------------------------------------------
 
-void SandboxTimer::timingBuildTimingArcs_SetupBacktrackEdge(TimingArc &arc, const TimingSense sense) {
-	for (const TimingMode mode : allTimingModes()) {
-		TimingArcState &state = arc.state[mode];
-		switch (sense) {
-			case POSITIVE_UNATE:
-				state.backtrack[RISE] = RISE;
-				state.backtrack[FALL] = FALL;
-				break;
-			case NEGATIVE_UNATE:
-				state.backtrack[RISE] = FALL;
-				state.backtrack[FALL] = RISE;
-				break;
-			case NON_UNATE:
-				// Backtrack edge depends on timing context.
-				break;
-			default:
-				throw Exception("Invalid timing arc sense.");
-		} // end switch
+bool SandboxTimer::commit() {
+	// The sandbox timing can only be used if it is up-to-date.
+	bool valid = !clsForceFullTimingUpdate &&
+			dirtyNets.empty() && clsDirtyTimingCells.empty();
+
+	// Loads of the design nets driving the sandbox as seen by the design
+	// timing, which was used to initialize the sandbox inputs. If they change
+	// with the commit, the timing at the sandbox inputs is no longer valid.
+	std::vector<std::pair<Rsyn::Net, std::array<EdgeArray<Number>, NUM_TIMING_MODES>>> inputs;
+	for (Rsyn::SandboxPort port : sandbox.allPorts(Rsyn::IN)) {
+		if (!valid)
+			break;
+		if (!port.isVirtual())
+			continue;
+
+		Rsyn::Pin relatedPin = port.getAttachedPin().getRelated();
+		Rsyn::Net net = relatedPin? relatedPin.getNet() : nullptr;
+		if (net) {
+			inputs.resize(inputs.size() + 1);
+			inputs.back().first = net;
+			for (const TimingMode mode : allTimingModes()) {
+				inputs.back().second[mode] = clsTimer->getNetLoad(net, mode);
+			} // end for
+		} // end if
 	} // end for
-} // end method
 
-// -----------------------------------------------------------------------------
+	sandbox.commit();
 
-void SandboxTimer::updateTiming_Arc_NonUnate(const TimingMode mode, const EdgeArray<Number> islew, const EdgeArray<Number> load, Rsyn::SandboxArc arc) {
-	TimingArc &timingArc = getTimingArc(arc);
-	TimingPin &timingPinFrom = getTimingPin(arc.getFromPin());
+	// Compare with the loads computed on the committed design.
+	for (const std::pair<Rsyn::Net, std::array<EdgeArray<Number>, NUM_TIMING_MODES>> &input : inputs) {
+		EdgeArray<Number> load[NUM_TIMING_MODES];
+		for (const TimingMode mode : allTimingModes()) {
+			load[mode] = input.second[mode];
+		} // end for
 
-	TimingArcState &state = timingArc.state[mode];
-	Rsyn::LibraryArc larc = arc.getLibraryArc();
+		if (!isLoadCompatible(input.first, load)) {
+			valid = false;
+			break;
+		} // end if
+	} // end for
 
-	if (ENABLE_IITIMER_COMPATIBILITY_MODE) {
+	// Loads of the nets driven inside the sandbox.
+	for (Rsyn::SandboxNet net : sandbox.allNets()) {
+		if (!valid)
+			break;
 
-		// Compatibility mode enables our timer to match the timing reported by
-		// the evaluation script of ICCAD 2014 Contest, which uses IITimer. In
-		// this mode timing through non-unate arcs are calculated using the
-		// worst input slew. Since some arcs may recovery slew (negative
-		// coefficients in the library), this may lead to different results if
-		// one compute the four possibilities (e.g. R->R, R->F, F->R, F->F).
-		//
-		// Note that IITimer also does not use the triggering edge of flip-flops
-		// to compute the timing through sequential arcs. IITimer treats them
-		// as regular non-unate arcs. However, for setup and hold calculation,
-		// which is not done here, IITimer assumes rising triggered flip-flops.
+		Rsyn::SandboxPin driver = net.getDriver();
+		if (!driver || !driver.getRelated())
+			continue;
 
-		TimingTransition iedge;
-		switch (mode) {
-			case LATE: iedge = islew.getMaxEdge();
-				break;
-			case EARLY: iedge = islew.getMinEdge();
-				break;
-			default:
-				assert(false);
-		} // end switch
+		EdgeArray<Number> load[NUM_TIMING_MODES];
+		for (const TimingMode mode : allTimingModes()) {
+			load[mode].set(0, 0);
+			timingModel->calculateLoadCapacitance(driver, mode, load[mode]);
+		} // end for
+
+		if (!isLoadCompatible(driver.getRelated().getNet(), load)) {
+			valid = false;
+		} // end if
+	} // end for
+
+	if (valid) {
+		seedDesignTimer();
+	} // end if
+	return valid;
+} // end method
+
+// -----------------------------------------------------------------------------
 
-		for (const TimingTransition oedge : allTimingTransitions()) {
-			timingModel->calculateLibraryArcTiming(larc, mode, oedge, islew[iedge], load[oedge], state.delay[oedge], state.oslew[oedge]);
+bool SandboxTimer::isLoadCompatible(Rsyn::Net net, const EdgeArray<Number> (&load)[NUM_TIMING_MODES]) {
+	if (!net)
+		return false;
+
+	Rsyn::Pin driver = net.getAnyDriver();
+	if (!driver)
+		return false;
+
+	// The routing of changed nets is only updated in the next timing update,
+	// so only ideal nets, whose load does not depend on the routing, are
+	// accepted.
+	RoutingEstimator *routingEstimator =
+			engine.getService("rsyn.routingEstimator", Rsyn::SERVICE_OPTIONAL);
+	if (routingEstimator) {
+		const RCTree &tree = routingEstimator->getRCTree(net);
+		if (!tree.isIdeal() || tree.hasUserSpecifiedWireLoad())
+			return false;
+	} // end if
+
+	// Load of the net in the (committed) design.
+	for (const TimingMode mode : allTimingModes()) {
+		EdgeArray<Number> designLoad(0, 0);
+		timingModel->calculateLoadCapacitance(driver, mode, designLoad);
+		for (const TimingTransition edge : allTimingTransitions()) {
+			if (!FloatingPoint::approximatelyEqual(designLoad[edge], load[mode][edge]))
+				return false;
 		} // end for
+	} // end for
 
-		// Define backtrack.
-		const auto &comparator = TM_MODE_COMPARATORS[mode];
-		if (comparator(timingPinFrom.state[mode].a[RISE], timingPinFrom.state[mode].a[FALL])) {
-			state.backtrack[RISE] = RISE;
-			state.backtrack[FALL] = RISE;
-		} else {
-			state.backtrack[RISE] = FALL;
-			state.backtrack[FALL] = FALL;
-		} // end else
+	return true;
+} // end method
 
-	} else {
+// -----------------------------------------------------------------------------
 
-		if (timingPinFrom.clocked /*is sequential*/) {
-			// [TODO] For sequential timing arcs we should use the triggering edge
-			// to fetch the input slew.
+void SandboxTimer::seedDesignTimer() {
+	for (Rsyn::SandboxInstance instance : sandbox.allInstances()) {
+		if (instance.getType() != Rsyn::CELL)
+			continue;
+
+		Rsyn::Instance relatedInstance = instance.getRelated();
+		if (!relatedInstance)
+			continue;
 
-			// [NOTE] Assuming only rising edge-triggered flip-flops.
+		for (Rsyn::SandboxPin pin : instance.allPins()) {
+			clsTimer->getTimingPin(pin.getRelated()).state = getTimingPin(pin).state;
+		} // end for
 
-			const TimingTransition iedge = RISE;
-			for (const TimingTransition oedge : allTimingTransitions()) {
-				timingModel->calculateLibraryArcTiming(larc, mode, oedge, islew[iedge], load[oedge], state.delay[oedge], state.oslew[oedge]);
+		for (Rsyn::SandboxArc arc : instance.allArcs()) {
+			Rsyn::Arc relatedArc = arc.getRelated();
+			if (relatedArc) {
+				clsTimer->getTimingArc(relatedArc).state = getTimingArc(arc).state;
+			} // end if
+		} // end for
 
-				state.backtrack[oedge] = iedge;
-			} // end for
+		clsTimer->undirtyInstance(relatedInstance);
+	} // end for
 
-		} else {
-			// Transition direction cannot be inferred from a single input (take
-			// the worst, among rise/fall).
-
-			// Compute the four possibilities: input x output transitions.
-			Number delay[2][2]; // delay[transition at output][transition at input]
-			Number oslew[2][2]; // oslew[transition at output][transition at input]
-			for (const std::tuple<TimingTransition, TimingTransition> transitions : allTimingTransitionPairs()) {
-				const TimingTransition iedge = std::get<0>(transitions);
-				const TimingTransition oedge = std::get<1>(transitions);
-				timingModel->calculateLibraryArcTiming(larc, mode, oedge, islew[iedge], load[oedge], delay[oedge][iedge], oslew[oedge][iedge]);
-			} // end for
+	for (Rsyn::SandboxNet net : sandbox.allNets()) {
+		Rsyn::SandboxPin driver = net.getDriver();
+		if (!driver || !driver.getRelated())
+			continue;
 
-			// Update delay, output slew and backtrack edge.
-			const auto &comparator = TM_MODE_COMPARATORS[mode];
+		Rsyn::Net relatedNet = driver.getRelated().getNet();
 
+		// Backtrack arcs point to timing arcs of the sandbox, so they need to
+		// be translated to the timing arcs of the design.
+		const TimingNet &timingNet = getTimingNet(net);
+		TimingNet &relatedTimingNet = clsTimer->getTimingNet(relatedNet);
+		for (const TimingMode mode : allTimingModes()) {
 			for (const TimingTransition edge : allTimingTransitions()) {
-				// Delay and backtrack.
-				if (comparator(delay[edge][RISE], delay[edge][FALL])) {
-					state.delay[edge] = delay[edge][RISE];
-					state.backtrack[edge] = RISE;
-				} else {
-					state.delay[edge] = delay[edge][FALL];
-					state.backtrack[edge] = FALL;
-				} // end else
-
-				// Slew.
-				if (comparator(oslew[edge][RISE], oslew[edge][FALL])) {
-					state.oslew[edge] = oslew[edge][RISE];
-				} else {
-					state.oslew[edge] = oslew[edge][FALL];
-				} // end else
+				const TimingArc *backtrackArc = timingNet.state[mode].backtrackArc[edge];
+				TimingArc *relatedBacktrackArc = nullptr;
+				for (Rsyn::SandboxArc arc : driver.allIncomingArcs()) {
+					if (&getTimingArc(arc) == backtrackArc) {
+						Rsyn::Arc relatedArc = arc.getRelated();
+						if (relatedArc)
+							relatedBacktrackArc = &clsTimer->getTimingArc(relatedArc);
+						break;
+					} // end if
+				} // end for
+				relatedTimingNet.state[mode].backtrackArc[edge] = relatedBacktrackArc;
 			} // end for
-		} // end else
-	} // end else
+		} // end for
+
+		// Nets leaving the sandbox need to be propagated in the design.
+		for (Rsyn::SandboxPin pin : net.allPins()) {
+			Rsyn::SandboxInstance instance = pin.getInstance();
+			if (instance.isPort() && instance.asPort().isVirtual()) {
+				clsTimer->dirtyNet(relatedNet);
+				break;
+			} // end if
+		} // end for
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SandboxTimer::timingBuildTimingArcs_SetupBacktrackEdge(TimingArc &arc, const TimingSense sense) {
+	for (const TimingMode mode : allTimingModes()) {
+		TimingArcState &state = arc.state[mode];
+		switch (sense) {
+			case POSITIVE_UNATE:
+				state.backtrack[RISE] = RISE;
+				state.backtrack[FALL] = FALL;
+				break;
+			case NEGATIVE_UNATE:
+				state.backtrack[RISE] = FALL;
+				state.backtrack[FALL] = RISE;
+				break;
+			case NON_UNATE:
+				// Backtrack edge depends on timing context.
+				break;
+			default:
+				throw Exception("Invalid timing arc sense.");
+		} // end switch
+	} // end for
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -439,47 +545,13 @@ void SandboxTimer::updateTiming_Arc(
 		Rsyn::LibraryArc larc,
 		TimingArcState &state
 ) {
-	// [NOTE] By construction, ports do not have a timing arc... So we don't
-	// need to deal with ports here.
-
-	const TimingLibraryArc &libarc = getTimingLibraryArc(larc);
-
-	switch (libarc.sense) {
-		case POSITIVE_UNATE:
-		{
-			// Transition direction is maintained from input to output:
-			// rise->rise and fall->fall.
-
-			timingModel->calculateLibraryArcTiming(larc, mode, FALL, islew[FALL], load[FALL], state.delay[FALL], state.oslew[FALL]);
-			timingModel->calculateLibraryArcTiming(larc, mode, RISE, islew[RISE], load[RISE], state.delay[RISE], state.oslew[RISE]);
-
-			// Backtrack edge are constant for this timing sense.
-			break;
-		} // end case
-		case NEGATIVE_UNATE:
-		{
-			// Transition direction is reversed from input to output: rise->fall
-			// and fall->rise.
-
-			timingModel->calculateLibraryArcTiming(larc, mode, FALL, islew[RISE], load[FALL], state.delay[FALL], state.oslew[FALL]);
-			timingModel->calculateLibraryArcTiming(larc, mode, RISE, islew[FALL], load[RISE], state.delay[RISE], state.oslew[RISE]);
-
-			// Backtrack edge are constant for this timing sense.
-			break;
-		} // end case
-		case NON_UNATE:
-		{
-			updateTiming_Arc_NonUnate(mode, islew, load, arc);
-			break;
-		} // end case
-		default:
-			throw Exception("Invalid timing arc sense.");
-	} // end switch
-
-	if (skip) {
-		state.delay.setBoth(0);
-	} // end if
-
+	if (clsDefaultTimingModel) {
+		DefaultPropagation(*this, *clsDefaultTimingModel).updateArc(
+				mode, islew, load, skip, arc, larc, state);
+	} else {
+		GenericPropagation(*this, *timingModel).updateArc(
+				mode, islew, load, skip, arc, larc, state);
+	} // end else
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -544,130 +616,11 @@ void SandboxTimer::updateTiming_Net_InitDriver(Rsyn::SandboxPin driver, const Ti
 } // end method
 // -----------------------------------------------------------------------------
 
-void SandboxTimer::updateTiming_Net_TimingMode(const TimingMode mode, Rsyn::SandboxNet net, const EdgeArray<Number> load, Rsyn::SandboxArc arc) {
-	// Assumes the driver state has been initialized properly (i.e. driver's
-	// max arrival is set to -inf and min arrival is set to +inf and so on).
-
-	const auto &comparator = TM_MODE_COMPARATORS[mode];
-
-	TimingNet &timingNet = getTimingNet(net);
-	TimingArc &timingArc = getTimingArc(arc);
-
-	TimingPin &timingPinFrom = getTimingPin(arc.getFromPin());
-	TimingPin &timingPinTo = getTimingPin(arc.getToPin());
-
-	TimingNetState &netState = timingNet.state[mode];
-	TimingArcState &arcState = timingArc.state[mode];
-	TimingPinState &toPinState = timingPinTo.state[mode];
-	const TimingPinState &fromPinState = timingPinFrom.state[mode];
-
-	updateTiming_Arc(mode, fromPinState.slew, load, timingPinFrom.skip, arc,
-			arc.getLibraryArc(), arcState);
-
-	for (const TimingTransition edge : allTimingTransitions()) {
-		const Number iarrival = fromPinState.a[arcState.backtrack[edge]];
-		const Number oarrival = iarrival + arcState.delay[edge];
-
-		if (comparator(oarrival, toPinState.a[edge])) {
-			toPinState.a[edge] = oarrival;
-			netState.backtrackArc[edge] = &timingArc;
-		} // end if
-
-		if (comparator(arcState.oslew[edge], toPinState.slew[edge])) {
-			toPinState.slew[edge] = arcState.oslew[edge];
-		} // end if
-
-	} // end for
-
-} // end method
-
-// -----------------------------------------------------------------------------
-
 void SandboxTimer::updateTiming_Net(Rsyn::SandboxNet net) {
-	if (net.getNumPins() < 1) {
-		std::cout << "[WARNING] Net without pins.\n";
-		return;
-	} // end if
-
-	Rsyn::SandboxPin driver = net.getDriver();
-	TimingNet &timingNet = getTimingNet(net);
-	TimingPin &timingPin = getTimingPin(driver);
-
-	// Effective load capacitance..
-	EdgeArray<Number> load[NUM_TIMING_MODES];
-
-	for (const TimingMode mode : allTimingModes()) {
-		// Compute effective capacitance loaded by the driver.
-		timingModel->calculateLoadCapacitance(driver, mode, load[mode]);
-
-		// Initialize the driver timing data with safe values (e.g. +inf, -inf).
-		updateTiming_Net_InitDriver(driver, mode, load[mode]);
-	} // end for
-
-	// Update  s delay and annotate the max and min timing data (e.g.
-	// arrival, slew).
-
-	const bool previousSkip = timingPin.skip;
-
-	int counter = 0;
-	timingPin.skip = true;
-	for (Rsyn::SandboxArc arc : driver.allIncomingArcs()) {
-		updateTiming_Net_TimingMode(LATE , net, load[LATE ], arc);
-		updateTiming_Net_TimingMode(EARLY, net, load[EARLY], arc);
-
-		timingPin.skip &= getTimingPin(arc.getFromPin()).skip;
-		counter++;
-	} // end for
-
-	if (counter == 0)
-		timingPin.skip = previousSkip;
-
-	// Update nets and propagate the timing information
-	// to the net sinks.
-
-	for (const TimingMode mode : allTimingModes()) {
-		const TimingPinState &driverState = timingPin.state[mode];
-		timingModel->prepareNet(net, mode, driverState.slew);
-
-		for (Rsyn::SandboxPin sink : net.allPins(Rsyn::SINK)) {
-			TimingPin &timingSinkPin = getTimingPin(sink);
-			timingSinkPin.skip = timingPin.skip;
-
-			EdgeArray<Number> delay;
-			EdgeArray<Number> slew;
-			timingModel->calculateNetArcTiming(driver, sink, mode,
-					driverState.slew, delay, slew);
-
-			TimingPinState &sinkState = timingSinkPin.state[mode];
-			sinkState.a = delay + driverState.a;
-			sinkState.slew = slew;
-			sinkState.wdelay = delay;
-		} // end for
-	} // end for
-
-	if (timingPin.skip) {
-		for (Rsyn::SandboxPin pin : net.allPins(Rsyn::SINK)) {
-			for (const TimingMode mode : allTimingModes()) {
-				const TimingPinState &driverState = timingPin.state[mode];
-
-				TimingPin &timingSinkPin = getTimingPin(pin);
-				timingSinkPin.skip = timingPin.skip;
-
-				TimingPinState & sinkState = timingSinkPin.state[mode];
-				sinkState.a = driverState.a;
-				sinkState.wdelay.set(0, 0);
-
-				if (ENABLE_UITIMER_COMPATIBILITY_MODE) {
-					for (const TimingTransition edge : allTimingTransitions()) {
-						if (std::abs(driverState.slew[edge]) == UNINITVALUE) {
-							sinkState.slew[edge] = driverState.slew[edge];
-						} // end if
-					} // end for
-				} else {
-					sinkState.slew = driverState.slew;
-				} // end else
-			} // end for
-		} // end for
+	if (clsDefaultTimingModel) {
+		DefaultPropagation(*this, *clsDefaultTimingModel).updateNet(net);
+	} else {
+		GenericPropagation(*this, *timingModel).updateNet(net);
 	} // end else
 } // end method
 
@@ -751,127 +704,8 @@ void SandboxTimer::updateTiming_UpdateTimingTests() {
 // -----------------------------------------------------------------------------
 
 void SandboxTimer::updateTiming_PropagateRequiredTimes_Net(Rsyn::SandboxNet net) {
-	// [NOTE] 16/Sep/2015 - Guilherme Flach
-	// A bug we found was that we were propagating the required time to
-	// from pins of arcs driven the driver pin of the net. This is ok for most
-	// cases, but breaks down whenever a from pin has more than one arc from it
-	// (e.g. multiple output cells). Be aware of that :)
-
-	// [ASSUMPTION] Single driver net.
-
-	// Update driver required time.
-	Rsyn::SandboxPin driver = net.getDriver();
-	if (!driver)
-		return; // [TODO] We should still process the sinks.
-
-	TimingPin &driverTimingPin = getTimingPin(driver);
-
-	// Initialize with safe values.
-	driverTimingPin.state[EARLY].q.set(-UNINITVALUE, -UNINITVALUE);
-	driverTimingPin.state[LATE ].q.set(+UNINITVALUE, +UNINITVALUE);
-
-	for (Rsyn::SandboxPin sink : net.allPins(Rsyn::SINK)) {
-		TimingPin &from = getTimingPin(sink);
-
-		// Initialize worst required times with safe values.
-		// We don't reset the from required time directly to avoid
-		// overwriting endpoint required times that are set separately.
-		EdgeArray<Number> required[NUM_TIMING_MODES];
-		for (const TimingTransition transition : allTimingTransitions()) {
-			required[EARLY][transition] = -UNINITVALUE;
-			required[LATE ][transition] = +UNINITVALUE;
-		} // end for
-
-		EdgeArray<Number> worstSpannedRequired[NUM_TIMING_MODES];
-		for (const TimingTransition transition : allTimingTransitions()) {
-			worstSpannedRequired[EARLY][transition] = -UNINITVALUE;
-			worstSpannedRequired[LATE ][transition] = +UNINITVALUE;
-		} // end for
-
-		// Get the worst required time if any.
-		bool hasArcs = false;
-		for (Rsyn::SandboxArc arc : sink.allOutgoingArcs()) {
-			TimingArc &timingArc = getTimingArc(arc);
-			TimingPin &to = getToTimingPinOfArc(arc);
-
-			if (from.isClockPin() && to.isDataPin()) {
-				// Nothing to be done here... We should consider
-				// removing the constraint timing arc from the timing graph.
-			} else {
-				hasArcs = true;
-
-				for (const TimingMode mode : allTimingModes()) {
-					for (const TimingTransition oedge : allTimingTransitions()) {
-						const TimingTransition iedge = timingArc.state[mode].backtrack[oedge];
-						const Number q = to.state[mode].q[oedge] - timingArc.state[mode].delay[oedge];
-						if (TM_MODE_REVERSE_COMPARATORS[mode](q, required[mode][iedge])) {
-							required[mode][iedge] = q;
-							worstSpannedRequired[mode][iedge] = to.state[mode].wsq[oedge];
-						} // end if
-					} // end for
-				} // end for
-			} // end else
-		} // end for
-
-		// If we found arcs from this pin, update its required time.
-		// If no arcs were found, keep its required times untouched as they
-		// were set outside this function (e.g. data pins, primary outputs,
-		// floating pins).
-		if (hasArcs) {
-			for (const TimingMode mode : allTimingModes()) {
-				from.state[mode].q = required[mode];
-				from.state[mode].wsq = worstSpannedRequired[mode];
-			} // end for
-		} // end if
-
-		// Update required time.
-		// Note this depends on the required times just set above.
-		if (ENABLE_UITIMER_COMPATIBILITY_MODE && from.isClockPin()) {
-			// Note that when the update reaches this point, the data pin must
-			// already been processed.
-
-			const TimingPin &data = getTimingPin(sink.getInstance().getPinByIndex(from.getDataPinIndex()));
-			TimingPin &ck = from; // just an alias
-
-			ck.state[EARLY].q[RISE] = std::max(ck.state[EARLY].q[RISE],
-					ck.state[EARLY].a[RISE] - data.getWorstSlack(LATE));
-			ck.state[EARLY].q[FALL] = -UNINITVALUE;
-
-			ck.state[LATE ].q[RISE] = std::min(ck.state[LATE ].q[RISE],
-					data.getWorstSlack(EARLY) + ck.state[LATE].a[RISE]);
-			ck.state[LATE ].q[FALL] = +UNINITVALUE;
-		} // end else
-
-		if (ENABLE_UITIMER_COMPATIBILITY_MODE && from.isDataPin()) {
-			// Note that when the update reaches this point, the required time
-			//of the clock pin was not yet processed.
-
-			const TimingPin &data = from; // just an alias
-			TimingPin &ck =  getTimingPin(sink.getInstance().getPinByIndex(from.getClockPinIndex()));
-
-			ck.state[EARLY].q[RISE] =
-					ck.state[EARLY].a[RISE] - data.getWorstSlack(LATE);
-			ck.state[EARLY].q[FALL] = -UNINITVALUE;
-
-			ck.state[LATE ].q[RISE] =
-					data.getWorstSlack(EARLY) + ck.state[LATE].a[RISE];
-			ck.state[LATE ].q[FALL] = +UNINITVALUE;
-		} // end else
-
-		// Update required time of the driver.
-		for (const TimingMode mode : allTimingModes()) {
-			const EdgeArray<Number> wdelay = from.state[mode].wdelay;
-
-			for (const TimingTransition edge : allTimingTransitions()) {
-				const Number requred = from.state[mode].q[edge] - wdelay[edge];
-
-				if (TM_MODE_REVERSE_COMPARATORS[mode](requred, driverTimingPin.state[mode].q[edge])) {
-					driverTimingPin.state[mode].q[edge] = from.state[mode].q[edge] - wdelay[edge];
-					driverTimingPin.state[mode].wsq[edge] = from.state[mode].wsq[edge];
-				}  // end if
-			} // end for
-		} // end for
-	} // end for each
+	// Required times do not depend on the timing model.
+	GenericPropagation(*this, *timingModel).updateRequiredTimes(net);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -1047,7 +881,8 @@ void SandboxTimer::updateTiming_CriticalEndpoints() {
 // -----------------------------------------------------------------------------
 
 void SandboxTimer::updateTimingFull() {
-	timingModel->beforeTimingUpdate(); // don't count this in the runtime
+	if (!clsSkipBeforeTimingUpdate)
+		timingModel->beforeTimingUpdate(); // don't count this in the runtime
 
 	clsStopwatchUpdateTiming.start();
 
@@ -1176,7 +1011,8 @@ void SandboxTimer::updateTimingIncremental() {
 		std::cout << "[INFO] Forcing full timing update.\n";
 		updateTimingFull();
 	} else {
-		timingModel->beforeTimingUpdate(); // don't count this in the runtime
+		if (!clsSkipBeforeTimingUpdate)
+			timingModel->beforeTimingUpdate(); // don't count this in the runtime
 
 		clsStopwatchUpdateTiming.start();
 		for (Rsyn::SandboxInstance cell : clsDirtyTimingCells) {
@@ -1616,8 +1452,7 @@ void SandboxTimer::queryTopCriticalPaths_Queue_AddCriticalEndpoint(CriticalPathQ
 		Rsyn::SandboxPin endpoint,
 		const TimingMode mode,
 		const Number slackThreshold,
-		const bool checkSign,
-		const int sign,
+		const VisitationMarker *filter,
 		const bool debug
 ) {
 	Rsyn::SandboxNet net = endpoint.getNet();
@@ -1630,7 +1465,7 @@ void SandboxTimer::queryTopCriticalPaths_Queue_AddCriticalEndpoint(CriticalPathQ
 	const TimingTransition transition = std::get<1>(slackTransitionPair);
 	const Number required = getPinRequiredTime(timingPin, mode, transition);
 
-	if (slack < slackThreshold && (!checkSign || (net && getTimingNet(net).sign == sign))) {
+	if (slack < slackThreshold && (!filter || (net && sandbox.isVisited(*filter, net)))) {
 		Reference reference(endpoint, nullptr, nullptr, required, slack, transition, -1, transition);
 		queue.push(reference);
 		if (debug) {
@@ -1644,8 +1479,7 @@ void SandboxTimer::queryTopCriticalPaths_Queue_AddCriticalEndpoint(CriticalPathQ
 void SandboxTimer::queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(CriticalPathQueue &queue,
 		const TimingMode mode,
 		const Number slackThreshold,
-		const bool checkSign,
-		const int sign,
+		const VisitationMarker *filter,
 		const bool debug
 ) {
 	// Insert the all critical endpoints in the queue. Note that even if we
@@ -1653,7 +1487,7 @@ void SandboxTimer::queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(CriticalP
 	// critical endpoints as they need to be sorted.
 
 	for (Rsyn::SandboxPin endpoint : allEndpoints()) {
-		queryTopCriticalPaths_Queue_AddCriticalEndpoint(queue, endpoint, mode, slackThreshold, checkSign, sign, debug);
+		queryTopCriticalPaths_Queue_AddCriticalEndpoint(queue, endpoint, mode, slackThreshold, filter, debug);
 	} // end for
 } // end method
 
@@ -1664,8 +1498,7 @@ bool SandboxTimer::queryTopCriticalPaths_Internal(CriticalPathQueue &queue,
 		const int maxNumPaths,
 		std::vector<std::vector<SandboxTimer::PathHop>> &paths,
 		const Number slackThreshold,
-		const bool checkSign,
-		const int sign,
+		const VisitationMarker *filter,
 		const bool debug
 ) {
 
@@ -1702,7 +1535,7 @@ bool SandboxTimer::queryTopCriticalPaths_Internal(CriticalPathQueue &queue,
 		if (getPinSlack(currentPin, mode, currentTransition) >= slackThreshold)
 			continue;
 
-		if (checkSign && (currentNet && getTimingNet(currentNet).sign != sign))
+		if (filter && (currentNet && !sandbox.isVisited(*filter, currentNet)))
 			continue;
 
 		partialPaths.push_back(currentReference);
@@ -1848,8 +1681,8 @@ bool SandboxTimer::queryTopCriticalPaths(
 	const bool debug = false;
 
 	CriticalPathQueue queue;
-	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode, slackThreshold, false, -1, debug);
-	return queryTopCriticalPaths_Internal(queue, mode, maxNumPaths, paths, slackThreshold, false, -1, debug);
+	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode, slackThreshold, nullptr, debug);
+	return queryTopCriticalPaths_Internal(queue, mode, maxNumPaths, paths, slackThreshold, nullptr, debug);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -1894,11 +1727,10 @@ int SandboxTimer::queryTopCriticalPathFromTopCriticalEndpoints(
 				std::get<1>(sortedEndpoint[i]),
 				mode,
 				slackThreshold,
-				false,
-				-1,
+				nullptr,
 				debug);
 
-		if (queryTopCriticalPaths_Internal(queue, mode, 1, endpointPaths, slackThreshold, false, -1, debug)) {
+		if (queryTopCriticalPaths_Internal(queue, mode, 1, endpointPaths, slackThreshold, nullptr, debug)) {
 			paths[i].swap(endpointPaths[0]);
 		} // end if
 	} // end for
@@ -1950,11 +1782,10 @@ int SandboxTimer::queryTopCriticalPathsFromTopCriticalEndpoints(
 				std::get<1>(sortedEndpoint[i]),
 				mode,
 				slackThreshold,
-				false,
-				-1,
+				nullptr,
 				debug);
 
-		if (queryTopCriticalPaths_Internal(queue, mode, maxNumPathsPerEndpoint, endpointPaths, slackThreshold, false, -1, debug)) {
+		if (queryTopCriticalPaths_Internal(queue, mode, maxNumPathsPerEndpoint, endpointPaths, slackThreshold, nullptr, debug)) {
 			const int numEndpointPaths = endpointPaths.size();
 			paths[i].resize(numEndpointPaths);
 			for (int k = 0; k < numEndpointPaths; k++) {
@@ -1983,10 +1814,10 @@ int SandboxTimer::queryTopCriticalPathsFromEndpoint(
 	CriticalPathQueue queue;
 
 	queryTopCriticalPaths_Queue_AddCriticalEndpoint(queue, endpoint, mode,
-			slackThreshold, false, -1, debug);
+			slackThreshold, nullptr, debug);
 
 	queryTopCriticalPaths_Internal(queue, mode, maxNumPaths, paths,
-			slackThreshold, false, -1, debug);
+			slackThreshold, nullptr, debug);
 
 	return paths.size();
 } // end method
@@ -2001,26 +1832,26 @@ int SandboxTimer::queryTopCriticalPathsPassingThruPin(
 		const Number slackThreshold
 ) {
 	const bool debug = false;
-	const int sign = generateNextSign();
+	VisitationMarker cone;
 
 	// Mark nets in the fan-in of the reference pin.
 	for (Rsyn::SandboxNet net : sandbox.getFaninConeNetsInBreadthFirstOrder(referencePin)) {
-		getTimingNet(net).sign = sign;
+		sandbox.visit(cone, net);
 	} // end for
 
 	// Mark nets in the fan-out of the reference pin.
 	for (Rsyn::SandboxNet net : sandbox.getFanoutConeNetsInBreadthFirstOrder(referencePin)) {
-		getTimingNet(net).sign = sign;
+		sandbox.visit(cone, net);
 	} // end for
 
 	// Generate paths.
 	CriticalPathQueue queue;
 
 	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode,
-			slackThreshold, true, sign, debug);
+			slackThreshold, &cone, debug);
 
 	queryTopCriticalPaths_Internal(queue, mode, maxNumPaths, paths,
-			slackThreshold, true, sign, debug);
+			slackThreshold, &cone, debug);
 
 	return paths.size();
 } // end method
@@ -2281,7 +2112,7 @@ bool SandboxTimer::queryTopCriticalEndpoints(
 	const bool debug = false;
 
 	CriticalPathQueue queue;
-	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode, slackThreshold, false, -1, debug);
+	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode, slackThreshold, nullptr, debug);
 
 	endpoints.clear();
 	endpoints.reserve(maxNumEndpoints);
@@ -2298,72 +2129,84 @@ bool SandboxTimer::queryTopCriticalEndpoints(
 ////////////////////////////////////////////////////////////////////////////////
 
 void SandboxTimer::setInputDriver(Rsyn::SandboxInstance port, InputDriver driver) {
-	clsInputDrivers[port] = driver;
+	PortConstraints &constraints = clsPortConstraints[port];
+	constraints.inputDriver = driver;
+	constraints.hasInputDriver = true;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 void SandboxTimer::setInputDelay(Rsyn::SandboxInstance port, const TimingMode &mode, const EdgeArray<Number> &value) {
-	clsInputDelays[mode][port] = value;
+	PortConstraints &constraints = clsPortConstraints[port];
+	constraints.inputDelay[mode] = value;
+	constraints.hasInputDelay[mode] = true;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 void SandboxTimer::setInputTransition(Rsyn::SandboxInstance port, const TimingMode &mode, const EdgeArray<Number> &value) {
-	clsInputTransitions[mode][port] = value;
+	PortConstraints &constraints = clsPortConstraints[port];
+	constraints.inputTransition[mode] = value;
+	constraints.hasInputTransition[mode] = true;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 void SandboxTimer::setOutputRequiredTime(Rsyn::SandboxInstance port, const TimingMode &mode, const EdgeArray<Number> &value) {
-	clsOutputRequiredTimes[mode][port] = value;
+	PortConstraints &constraints = clsPortConstraints[port];
+	constraints.outputRequiredTime[mode] = value;
+	constraints.hasOutputRequiredTime[mode] = true;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 void SandboxTimer::setOutputLoad(Rsyn::SandboxInstance port, const TimingMode &mode, const EdgeArray<Number> &value) {
-	clsOutputLoads[mode][port] = value;
+	PortConstraints &constraints = clsPortConstraints[port];
+	constraints.outputLoad[mode] = value;
+	constraints.hasOutputLoad[mode] = true;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 void SandboxTimer::setOutputDelay(Rsyn::SandboxInstance port, const TimingMode &mode, const EdgeArray<Number> &value) {
-	clsOutputDelays[mode][port] = value;
+	PortConstraints &constraints = clsPortConstraints[port];
+	constraints.outputDelay[mode] = value;
+	constraints.hasOutputDelay[mode] = true;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 EdgeArray<Number> SandboxTimer::getInputDelay(Rsyn::SandboxInstance port, const TimingMode &mode, const EdgeArray<Number> &defaultValue) const {
-	auto it = clsInputDelays[mode].find(port);
-	return it == clsInputDelays[mode].end() ? defaultValue : it->second;
+	const PortConstraints &constraints = clsPortConstraints[port];
+	return constraints.hasInputDelay[mode]? constraints.inputDelay[mode] : defaultValue;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 EdgeArray<Number> SandboxTimer::getInputTransition(Rsyn::SandboxInstance port, const TimingMode &mode, const EdgeArray<Number> &defaultValue) const {
-	auto it = clsInputTransitions[mode].find(port);
-	return it == clsInputTransitions[mode].end() ? defaultValue : it->second;
+	const PortConstraints &constraints = clsPortConstraints[port];
+	return constraints.hasInputTransition[mode]? constraints.inputTransition[mode] : defaultValue;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 EdgeArray<Number> SandboxTimer::getOutputRequiredTime(Rsyn::SandboxInstance port, const TimingMode &mode, const EdgeArray<Number> &defaultValue) const {
-	auto it = clsOutputRequiredTimes[mode].find(port);
-	return it == clsOutputRequiredTimes[mode].end()? defaultValue : it->second;
+	const PortConstraints &constraints = clsPortConstraints[port];
+	return constraints.hasOutputRequiredTime[mode]? constraints.outputRequiredTime[mode] : defaultValue;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 EdgeArray<Number> SandboxTimer::getOutputLoad(Rsyn::SandboxInstance port, const TimingMode &mode, const EdgeArray<Number> &defaultValue) const {
-	auto it = clsOutputLoads[mode].find(port);
-	return it == clsOutputLoads[mode].end() ? defaultValue : it->second;
+	const PortConstraints &constraints = clsPortConstraints[port];
+	return constraints.hasOutputLoad[mode]? constraints.outputLoad[mode] : defaultValue;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 const SandboxTimer::InputDriver *SandboxTimer::getInputDriver(Rsyn::SandboxPort port) const {
-	auto it = clsInputDrivers.find(port);
-	return (it == clsInputDrivers.end())? nullptr : &it->second;
+	const PortConstraints &constraints = clsPortConstraints[port];
+	return constraints.hasInputDriver? &constraints.inputDriver : nullptr;
 } // end method
 
 
@@ -59,6 +59,8 @@ class Scenario;
 ////////////////////////////////////////////////////////////////////////////////
 
 class SandboxTimer {
+	template<class TimerType, class View, class Model>
+	friend class TimingPropagation;
 public:
 
 	enum InputDriverDelayMode {
@@ -80,6 +82,34 @@ private:
 		EdgeArray<Number> inputSlew;
 	};	// end struct
 
+	// Constraints of a sandbox port. Stored in a sandbox attribute so that the
+	// storage is reused when the timer is reset to another sandbox.
+	struct PortConstraints {
+		EdgeArray<Number> inputDelay[NUM_TIMING_MODES];
+		EdgeArray<Number> inputTransition[NUM_TIMING_MODES];
+		EdgeArray<Number> outputDelay[NUM_TIMING_MODES];
+		EdgeArray<Number> outputRequiredTime[NUM_TIMING_MODES];
+		EdgeArray<Number> outputLoad[NUM_TIMING_MODES];
+		InputDriver inputDriver;
+
+		bool hasInputDelay[NUM_TIMING_MODES];
+		bool hasInputTransition[NUM_TIMING_MODES];
+		bool hasOutputDelay[NUM_TIMING_MODES];
+		bool hasOutputRequiredTime[NUM_TIMING_MODES];
+		bool hasOutputLoad[NUM_TIMING_MODES];
+		bool hasInputDriver;
+
+		PortConstraints() : hasInputDriver(false) {
+			for (int mode = 0; mode < NUM_TIMING_MODES; mode++) {
+				hasInputDelay[mode] = false;
+				hasInputTransition[mode] = false;
+				hasOutputDelay[mode] = false;
+				hasOutputRequiredTime[mode] = false;
+				hasOutputLoad[mode] = false;
+			} // end for
+		} // end constructor
+	}; // end struct
+
 	Rsyn::Engine engine;
 	Rsyn::Design design;
 	Rsyn::Sandbox sandbox;
@@ -88,17 +118,13 @@ private:
 	Timer *clsTimer;
 
 	TimingModel *timingModel;
+	DefaultTimingModel *clsDefaultTimingModel = nullptr; // same as timingModel when it is a default model
 	InputDriverDelayMode inputDriverDelayMode = INPUT_DRIVER_DELAY_MODE_UI_TIMER;
 
 
 	Rsyn::SandboxNet clsClockNet;
 	Rsyn::SandboxPort clsClockPort;
-	std::map<Rsyn::SandboxInstance, EdgeArray<Number>> clsInputDelays[NUM_TIMING_MODES];
-	std::map<Rsyn::SandboxInstance, EdgeArray<Number>> clsInputTransitions[NUM_TIMING_MODES];
-	std::map<Rsyn::SandboxInstance, EdgeArray<Number>> clsOutputDelays[NUM_TIMING_MODES];
-	std::map<Rsyn::SandboxInstance, EdgeArray<Number>> clsOutputRequiredTimes[NUM_TIMING_MODES];
-	std::map<Rsyn::SandboxInstance, EdgeArray<Number>> clsOutputLoads[NUM_TIMING_MODES];
-	std::map<Rsyn::SandboxInstance, InputDriver> clsInputDrivers;
+	Rsyn::SandboxAttribute<Rsyn::SandboxInstance, PortConstraints> clsPortConstraints;
 
 public:
 
@@ -139,6 +165,9 @@ private:
 	void initializeTimingCell(
 			Rsyn::SandboxCell rsynCell);
 
+	bool isLoadCompatible(Rsyn::Net net, const EdgeArray<Number> (&load)[NUM_TIMING_MODES]);
+	void seedDesignTimer();
+
 	void uninitializeTimingCell(
 			Rsyn::SandboxCell rsynCell);
 
@@ -184,6 +213,7 @@ private:
 	////////////////////////////////////////////////////////////////////////////
 
 	bool clsForceFullTimingUpdate;
+	bool clsSkipBeforeTimingUpdate = false;
 
 	int clsSign;
 	int generateNextSign() { return ++clsSign; /*must be pre-increment*/ }
@@ -218,11 +248,11 @@ private:
 	// Update Timing
 	////////////////////////////////////////////////////////////////////////////
 
-	void updateTiming_Arc_NonUnate(const TimingMode mode, const EdgeArray<Number> islew, const EdgeArray<Number> load, Rsyn::SandboxArc arc);
+	// The timing propagation is implemented in TimingPropagation.h. These
+	// methods instantiate it for the timing model in use.
 	void updateTiming_Arc(const TimingMode mode, const EdgeArray<Number> islew, const EdgeArray<Number> load, const bool skip, Rsyn::SandboxArc arc, Rsyn::LibraryArc larc, TimingArcState &state);
 
 	void updateTiming_Net_InitDriver(Rsyn::SandboxPin driver, const TimingMode mode, const EdgeArray<Number> load);
-	void updateTiming_Net_TimingMode(const TimingMode mode, Rsyn::SandboxNet net, const EdgeArray<Number> load, Rsyn::SandboxArc arc);
 	void updateTiming_Net(Rsyn::SandboxNet net);
 
 	void updateTiming_HandleFloatingPins();
@@ -263,8 +293,32 @@ private:
 
 public:
 
+	//! @brief Initializes the timer for a sandbox. If beforeTimingUpdate() is
+	//!        skipped (see setSkipBeforeTimingUpdate()), the sandbox timer only
+	//!        reads the design and the design timer, so several sandbox timers
+	//!        may run concurrently as long as the design is not changed.
 	void init(Rsyn::Engine rsynEngine, Rsyn::Sandbox rsynSandbox);
 
+	//! @brief Reinitializes this timer for another sandbox (e.g. a sandbox
+	//!        acquired from a SandboxPool). The storage of the timing layers,
+	//!        port constraints and timing sets is reused. The timer must have
+	//!        been initialized with init() before.
+	void reset(Rsyn::Sandbox rsynSandbox);
+
+	//! @brief Commits the sandbox changes to the design (see Sandbox::commit())
+	//!        and, when the numbers computed in the sandbox are still valid in
+	//!        the design, copies them to the design timer. In this case only 
+	//!        the nets leaving the sandbox are marked as dirty in the design
+	//!        timer, so that the next incremental update only needs to
+	//!        propagate the timing of the boundary cone.
+	//! @note  The sandbox timing is valid in the design if it is up-to-date (no
+	//!        pending changes since the last timing update)
+	//!        and the loads seen by the drivers in the sandbox match the loads
+	//!        seen in the design (e.g. the design nets are ideal), including
+	//!        the loads of design nets driving the sandbox.
+	//! @return True if the design timer was seeded with the sandbox timing.
+	bool commit();
+
 	void setInputDriver(Rsyn::SandboxInstance port, InputDriver driver);
 	void setInputDelay(Rsyn::SandboxInstance port, const TimingMode &mode, const EdgeArray<Number> &value);
 	void setInputTransition(Rsyn::SandboxInstance port, const TimingMode &mode, const EdgeArray<Number> &value);
@@ -279,16 +333,21 @@ public:
 public:
 
 	// Setup timing model.
-	void setTimingModel(TimingModel &model) {
-		timingModel = &model;
-		clsForceFullTimingUpdate = true;
-	} // end method
+	void setTimingModel(TimingModel &model);
 
 	// Setup the input driver delay mode.
 	void setInputDriverDelayMode(const InputDriverDelayMode mode) {
 		inputDriverDelayMode = mode;
 	} // end method
 
+	//! @brief If set, timing updates do not call
+	//!        TimingModel::beforeTimingUpdate(), which updates the routing of
+	//!        design nets, so that several sandbox timers can run concurrently.
+	//!        The design routing must then be up-to-date (see SandboxTrials).
+	void setSkipBeforeTimingUpdate(const bool skip) {
+		clsSkipBeforeTimingUpdate = skip;
+	} // end method
+
 	// Update timing.
 	void updateTimingFull();
 
@@ -1072,15 +1131,13 @@ private:
 			Rsyn::SandboxPin endpoint,
 			const TimingMode mode,
 			const Number slackThreshold,
-			const bool checkSign,
-			const int sign,
+			const Rsyn::VisitationMarker *filter,
 			const bool debug);
 
 	void queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(CriticalPathQueue &queue,
 			const TimingMode mode,
 			const Number slackThreshold,
-			const bool checkSign,
-			const int sign,
+			const Rsyn::VisitationMarker *filter,
 			const bool debug);
 
 	bool queryTopCriticalPaths_Internal(CriticalPathQueue &queue,
@@ -1088,8 +1145,7 @@ private:
 			const int maxNumPaths,
 			std::vector<std::vector<PathHop>> &paths,
 			const Number slackThreshold,
-			const bool checkSign,
-			const int sign,
+			const Rsyn::VisitationMarker *filter,
 			const bool debug);
 
 public:
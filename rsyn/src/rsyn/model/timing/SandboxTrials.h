@@ -0,0 +1,158 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_SANDBOX_TRIALS_H
+#define RSYN_SANDBOX_TRIALS_H
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <functional>
+
+#include "rsyn/sandbox/Sandbox.h"
+#include "rsyn/model/timing/SandboxTimer.h"
+#include "rsyn/util/Parallel.h"
+
+namespace Rsyn {
+
+////////////////////////////////////////////////////////////////////////////////
+// Evaluates several changes (trials) around a seed cell in parallel. Each trial
+// runs on its own sandbox created around the seed and is timed by its own
+// sandbox timer. Sandboxes and sandbox timers are reused across trials and
+// across calls.
+//
+// Example (gate sizing)
+// ---------------------
+//
+//    Rsyn::SandboxTrials trials(engine);
+//    std::vector<Rsyn::SandboxTrials::Result> results =
+//            trials.runRemaps(cell, candidateLibraryCells);
+//    for (int i = 0; i < results.size(); i++) {
+//        if (results[i].valid && results[i].wns[Rsyn::LATE] > bestWns) ...
+//    } // end for
+//
+// Trials only read the design, which must not be changed while trials are
+// running. The design timing and routing should be up-to-date before running
+// trials, as the sandbox timers do not call TimingModel::beforeTimingUpdate().
+////////////////////////////////////////////////////////////////////////////////
+
+class SandboxTrials {
+public:
+
+	struct Result {
+		// False if the trial was rejected (i.e. the trial function returned
+		// false or threw an exception). The timing values are undefined in this
+		// case.
+		bool valid = false;
+
+		Number wns[NUM_TIMING_MODES];
+		Number tns[NUM_TIMING_MODES];
+		Number maxArrivalTime[NUM_TIMING_MODES];
+	}; // end struct
+
+	//! @brief Applies the i-th change to the sandbox. Returns false to reject
+	//!        the trial. The function is called concurrently for different
+	//!        trials.
+	typedef std::function<bool(Rsyn::Sandbox sandbox, const int trial)> Trial;
+
+	SandboxTrials(Rsyn::Engine engine) : clsEngine(engine) {}
+
+	//! @brief Runs numTrials trials around the seed using the shared thread
+	//!        pool and returns the timing of each trial.
+	std::vector<Result> run(Rsyn::Cell seed, const int numTrials, const Trial &trial) {
+		std::vector<Result> results(numTrials);
+
+		ParallelInternal::processChunks(getSharedThreadPool(), numTrials,
+				[&](const int i) {
+			Rsyn::Sandbox sandbox = clsSandboxPool.acquire(seed);
+			std::unique_ptr<SandboxTimer> timer = acquireTimer();
+
+			// Any failure, including in the timing update, rejects the trial
+			// only. A timer that failed may be left in an inconsistent state,
+			// so it is discarded rather than reused.
+			Result &result = results[i];
+			try {
+				result.valid = trial(sandbox, i);
+
+				if (result.valid) {
+					if (timer) {
+						timer->reset(sandbox);
+					} else {
+						timer.reset(new SandboxTimer());
+						timer->setSkipBeforeTimingUpdate(true);
+						timer->init(clsEngine, sandbox);
+					} // end else
+
+					timer->updateTimingFull();
+					for (const TimingMode mode : {EARLY, LATE}) {
+						result.wns[mode] = timer->getWns(mode);
+						result.tns[mode] = timer->getTns(mode);
+						result.maxArrivalTime[mode] = timer->getMaxArrivalTime(mode);
+					} // end for
+				} // end if
+			} catch (...) {
+				result.valid = false;
+				timer.reset();
+			} // end catch
+
+			releaseTimer(std::move(timer));
+			clsSandboxPool.release(sandbox);
+		});
+
+		return results;
+	} // end method
+
+	//! @brief Evaluates remapping the seed to each library cell. Candidates
+	//!        not compatible with the seed (e.g. different pins) are returned as
+	//!        invalid.
+	std::vector<Result> runRemaps(Rsyn::Cell seed, const std::vector<Rsyn::LibraryCell> &candidates) {
+		return run(seed, (int) candidates.size(),
+				[&](Rsyn::Sandbox sandbox, const int i) {
+			Rsyn::SandboxCell cell = sandbox.getRelated(seed).asCell();
+			sandbox.remap(cell, candidates[i]);
+			return true;
+		});
+	} // end method
+
+private:
+
+	Rsyn::Engine clsEngine;
+	Rsyn::SandboxPool clsSandboxPool;
+
+	std::mutex clsTimersMutex;
+	std::vector<std::unique_ptr<SandboxTimer>> clsFreeTimers;
+
+	//! @brief Returns a timer used in a previous trial or null if none is
+	//!        available.
+	std::unique_ptr<SandboxTimer> acquireTimer() {
+		std::lock_guard<std::mutex> lock(clsTimersMutex);
+		if (clsFreeTimers.empty())
+			return nullptr;
+		std::unique_ptr<SandboxTimer> timer = std::move(clsFreeTimers.back());
+		clsFreeTimers.pop_back();
+		return timer;
+	} // end method
+
+	void releaseTimer(std::unique_ptr<SandboxTimer> timer) {
+		if (!timer)
+			return;
+		std::lock_guard<std::mutex> lock(clsTimersMutex);
+		clsFreeTimers.push_back(std::move(timer));
+	} // end method
+}; // end class
+
+} // end namespace
+
+#endif /* RSYN_SANDBOX_TRIALS_H */
@@ -22,6 +22,8 @@
 #include "rsyn/model/scenario/Scenario.h"
 
 #include "rsyn/model/timing/Timer.h"
+#include "rsyn/model/timing/TimingPropagation.h"
+#include "rsyn/model/timing/DefaultTimingModel.h"
 #include "rsyn/util/FloatingPoint.h"
 #include "rsyn/util/ThreadPool.h"
 #include "rsyn/util/MD5.h"
@@ -46,6 +48,11 @@ const bool Timer::ENABLE_UITIMER_COMPATIBILITY_MODE = true;
 
 // -----------------------------------------------------------------------------	
 
+typedef TimingPropagation<Timer, DesignTimingView, TimingModel> GenericPropagation;
+typedef TimingPropagation<Timer, DesignTimingView, DefaultTimingModel> DefaultPropagation;
+
+// -----------------------------------------------------------------------------	
+
 // [TODO] Use functors, not lambda.
 
 const std::function<bool(const Number a, const Number b)> 
@@ -133,6 +140,31 @@ void Timer::stop() {
 
 // -----------------------------------------------------------------------------
 
+void Timer::reportMemoryUsage(Rsyn::MemoryReport &report) {
+	report.add("nets", clsNetLayer->getMemoryUsage());
+	report.add("pins", clsPinLayer->getMemoryUsage());
+	report.add("arcs", clsArcLayer->getMemoryUsage());
+	report.add("library",
+			clsLibraryArcLayer->getMemoryUsage() +
+			clsLibraryPinLayer->getMemoryUsage() +
+			clsLibraryCellLayer->getMemoryUsage());
+
+	std::size_t criticalEndpoints = 0;
+	for (int mode = 0; mode < NUM_TIMING_MODES; mode++)
+		criticalEndpoints += MemoryReport::bytes(clsCriticalEndpoints[mode]);
+	report.add("critical endpoints", criticalEndpoints);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::setTimingModel(TimingModel *model) {
+	timingModel = model;
+	clsDefaultTimingModel = dynamic_cast<DefaultTimingModel *>(model);
+	clsForceFullTimingUpdate = true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void Timer::onPostInstanceCreate(Rsyn::Instance instance) {
 	if (instance.getType() == Rsyn::CELL) {
 		initializeTimingCell(instance.asCell());
@@ -152,6 +184,18 @@ void Timer::onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) {
 
 // -----------------------------------------------------------------------------
 
+void Timer::onPostTransactionCommit(const Rsyn::NetlistChanges &changes) {
+	for (Rsyn::Instance instance : changes.createdInstances) {
+		onPostInstanceCreate(instance);
+	} // end for
+
+	for (const std::pair<Rsyn::Cell, Rsyn::LibraryCell> &remap : changes.remappedCells) {
+		onPostCellRemap(remap.first, remap.second);
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
 bool Timer::isUnusualTimingArc(const ISPD13::LibParserTimingInfo &libArc) const {
 	if (libArc.timingSense != "non_unate" &&
 			libArc.timingSense != "positive_unate" &&
@@ -478,155 +522,22 @@ void Timer::timingBuildTimingArcs_SetupBacktrackEdge(TimingArc &arc, const Timin
 
 // -----------------------------------------------------------------------------
 
-void Timer::updateTiming_Arc_NonUnate(const TimingMode mode, const EdgeArray<Number> islew, const EdgeArray<Number> load, Rsyn::Arc arc) {
-	TimingArc &timingArc = getTimingArc(arc);
-	TimingPin &timingPinFrom = getTimingPin(arc.getFromPin());
-
-	TimingArcState &state = timingArc.state[mode];
-	Rsyn::LibraryArc larc = arc.getLibraryArc();
-	
-	if (ENABLE_IITIMER_COMPATIBILITY_MODE) {
-
-		// Compatibility mode enables our timer to match the timing reported by
-		// the evaluation script of ICCAD 2014 Contest, which uses IITimer. In
-		// this mode timing through non-unate arcs are calculated using the
-		// worst input slew. Since some arcs may recovery slew (negative
-		// coefficients in the library), this may lead to different results if
-		// one compute the four possibilities (e.g. R->R, R->F, F->R, F->F).
-		//
-		// Note that IITimer also does not use the triggering edge of flip-flops
-		// to compute the timing through sequential arcs. IITimer treats them
-		// as regular non-unate arcs. However, for setup and hold calculation,
-		// which is not done here, IITimer assumes rising triggered flip-flops.
-
-		TimingTransition iedge;
-		switch (mode) {
-			case LATE: iedge = islew.getMaxEdge();
-				break;
-			case EARLY: iedge = islew.getMinEdge();
-				break;
-			default:
-				assert(false);
-		} // end switch
-
-		for (const TimingTransition oedge : allTimingTransitions()) {
-			timingModel->calculateLibraryArcTiming(larc, mode, oedge, islew[iedge], load[oedge], state.delay[oedge], state.oslew[oedge]);
-		} // end for
-
-		// Define backtrack.
-		const auto &comparator = TM_MODE_COMPARATORS[mode];
-		if (comparator(timingPinFrom.state[mode].a[RISE], timingPinFrom.state[mode].a[FALL])) {
-			state.backtrack[RISE] = RISE;
-			state.backtrack[FALL] = RISE;
-		} else {
-			state.backtrack[RISE] = FALL;
-			state.backtrack[FALL] = FALL;
-		} // end else
-
-	} else {
-
-		if (timingPinFrom.clocked /*is sequential*/) {
-			// [TODO] For sequential timing arcs we should use the triggering edge
-			// to fetch the input slew.
-
-			// [NOTE] Assuming only rising edge-triggered flip-flops.
-
-			const TimingTransition iedge = RISE;
-			for (const TimingTransition oedge : allTimingTransitions()) {
-				timingModel->calculateLibraryArcTiming(larc, mode, oedge, islew[iedge], load[oedge], state.delay[oedge], state.oslew[oedge]);
-
-				state.backtrack[oedge] = iedge;
-			} // end for
-
-		} else {
-			// Transition direction cannot be inferred from a single input (take
-			// the worst, among rise/fall).
-
-			// Compute the four possibilities: input x output transitions.
-			Number delay[2][2]; // delay[transition at output][transition at input]
-			Number oslew[2][2]; // oslew[transition at output][transition at input]
-			for (const std::tuple<TimingTransition, TimingTransition> transitions : allTimingTransitionPairs()) {
-				const TimingTransition iedge = std::get<0>(transitions);
-				const TimingTransition oedge = std::get<1>(transitions);
-				timingModel->calculateLibraryArcTiming(larc, mode, oedge, islew[iedge], load[oedge], delay[oedge][iedge], oslew[oedge][iedge]);
-			} // end for
-
-			// Update delay, output slew and backtrack edge.
-			const auto &comparator = TM_MODE_COMPARATORS[mode];
-
-			for (const TimingTransition edge : allTimingTransitions()) {
-				// Delay and backtrack.
-				if (comparator(delay[edge][RISE], delay[edge][FALL])) {
-					state.delay[edge] = delay[edge][RISE];
-					state.backtrack[edge] = RISE;
-				} else {
-					state.delay[edge] = delay[edge][FALL];
-					state.backtrack[edge] = FALL;
-				} // end else
-
-				// Slew.
-				if (comparator(oslew[edge][RISE], oslew[edge][FALL])) {
-					state.oslew[edge] = oslew[edge][RISE];
-				} else {
-					state.oslew[edge] = oslew[edge][FALL];
-				} // end else
-			} // end for
-		} // end else
-	} // end else
-} // end method
-
-// -----------------------------------------------------------------------------
-
 void Timer::updateTiming_Arc(
-		const TimingMode mode, 
-		const EdgeArray<Number> islew, 
-		const EdgeArray<Number> load, 
-		const bool skip, 
-		Rsyn::Arc arc, 
+		const TimingMode mode,
+		const EdgeArray<Number> islew,
+		const EdgeArray<Number> load,
+		const bool skip,
+		Rsyn::Arc arc,
 		Rsyn::LibraryArc larc,
 		TimingArcState &state
 ) {
-	// [NOTE] By construction, ports do not have a timing arc... So we don't
-	// need to deal with ports here.
-
-	const TimingLibraryArc &libarc = getTimingLibraryArc(larc);	
-
-	switch (libarc.sense) {
-		case POSITIVE_UNATE:
-		{
-			// Transition direction is maintained from input to output:
-			// rise->rise and fall->fall.
-						
-			timingModel->calculateLibraryArcTiming(larc, mode, FALL, islew[FALL], load[FALL], state.delay[FALL], state.oslew[FALL]);
-			timingModel->calculateLibraryArcTiming(larc, mode, RISE, islew[RISE], load[RISE], state.delay[RISE], state.oslew[RISE]);
-
-			// Backtrack edge are constant for this timing sense.
-			break;
-		} // end case
-		case NEGATIVE_UNATE:
-		{
-			// Transition direction is reversed from input to output: rise->fall
-			// and fall->rise.
-			
-			timingModel->calculateLibraryArcTiming(larc, mode, FALL, islew[RISE], load[FALL], state.delay[FALL], state.oslew[FALL]);
-			timingModel->calculateLibraryArcTiming(larc, mode, RISE, islew[FALL], load[RISE], state.delay[RISE], state.oslew[RISE]);			
-
-			// Backtrack edge are constant for this timing sense.
-			break;
-		} // end case
-		case NON_UNATE:
-		{
-			updateTiming_Arc_NonUnate(mode, islew, load, arc);
-			break;
-		} // end case
-		default:
-			throw Exception("Invalid timing arc sense.");
-	} // end switch
-
-	if (skip) {
-		state.delay.setBoth(0);
-	} // end if
-	
+	if (clsDefaultTimingModel) {
+		DefaultPropagation(*this, *clsDefaultTimingModel).updateArc(
+				mode, islew, load, skip, arc, larc, state);
+	} else {
+		GenericPropagation(*this, *timingModel).updateArc(
+				mode, islew, load, skip, arc, larc, state);
+	} // end else
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -693,130 +604,11 @@ void Timer::updateTiming_Net_InitDriver(Rsyn::Pin driver, const TimingMode mode,
 } // end method
 // -----------------------------------------------------------------------------
 
-void Timer::updateTiming_Net_TimingMode(const TimingMode mode, Rsyn::Net net, const EdgeArray<Number> load, Rsyn::Arc arc) {
-	// Assumes the driver state has been initialized properly (i.e. driver's
-	// max arrival is set to -inf and min arrival is set to +inf and so on).
-
-	const auto &comparator = TM_MODE_COMPARATORS[mode];	
-	
-	TimingNet &timingNet = getTimingNet(net);
-	TimingArc &timingArc = getTimingArc(arc);
-	
-	TimingPin &timingPinFrom = getTimingPin(arc.getFromPin());
-	TimingPin &timingPinTo = getTimingPin(arc.getToPin());
-
-	TimingNetState &netState = timingNet.state[mode];
-	TimingArcState &arcState = timingArc.state[mode];
-	TimingPinState &toPinState = timingPinTo.state[mode];
-	const TimingPinState &fromPinState = timingPinFrom.state[mode];
-
-	updateTiming_Arc(mode, fromPinState.slew, load, timingPinFrom.skip, arc,
-			arc.getLibraryArc(), arcState);
-
-	for (const TimingTransition edge : allTimingTransitions()) {
-		const Number iarrival = fromPinState.a[arcState.backtrack[edge]];
-		const Number oarrival = iarrival + arcState.delay[edge];
-		
-		if (comparator(oarrival, toPinState.a[edge])) {
-			toPinState.a[edge] = oarrival;
-			netState.backtrackArc[edge] = &timingArc;
-		} // end if
-
-		if (comparator(arcState.oslew[edge], toPinState.slew[edge])) {
-			toPinState.slew[edge] = arcState.oslew[edge];
-		} // end if
-		
-	} // end for
-	
-} // end method
-
-// -----------------------------------------------------------------------------
-
 void Timer::updateTiming_Net(Rsyn::Net net) {
-	if (net.getNumPins() < 1) {
-//		std::cout << "[WARNING] Net without pins.\n";
-		return;
-	} // end if
-	
-	Rsyn::Pin driver = net.getAnyDriver();
-	TimingNet &timingNet = getTimingNet(net);
-	TimingPin &timingPin = getTimingPin(driver);
-	
-	// Effective load capacitance..
-	EdgeArray<Number> load[NUM_TIMING_MODES];
-
-	for (const TimingMode mode : allTimingModes()) {
-		// Compute effective capacitance loaded by the driver.
-		timingModel->calculateLoadCapacitance(driver, mode, load[mode]);
-
-		// Initialize the driver timing data with safe values (e.g. +inf, -inf).
-		updateTiming_Net_InitDriver(driver, mode, load[mode]);
-	} // end for
-
-	// Update  s delay and annotate the max and min timing data (e.g.
-	// arrival, slew).
-
-	const bool previousSkip = timingPin.skip;
-
-	int counter = 0;
-	timingPin.skip = true;
-	for (Rsyn::Arc arc : driver.allIncomingArcs()) {
-		updateTiming_Net_TimingMode(LATE , net, load[LATE ], arc);
-		updateTiming_Net_TimingMode(EARLY, net, load[EARLY], arc);
-		
-		timingPin.skip &= getTimingPin(arc.getFromPin()).skip;
-		counter++;
-	} // end for
-
-	if (counter == 0)
-		timingPin.skip = previousSkip;
-	
-	// Update nets and propagate the timing information
-	// to the net sinks.
-
-	for (const TimingMode mode : allTimingModes()) {
-		const TimingPinState &driverState = timingPin.state[mode];
-		timingModel->prepareNet(net, mode, driverState.slew);
-
-		for (Rsyn::Pin sink : net.allPins(Rsyn::SINK)) {
-			TimingPin &timingSinkPin = getTimingPin(sink);
-			timingSinkPin.skip = timingPin.skip;
-
-			EdgeArray<Number> delay;
-			EdgeArray<Number> slew;
-			timingModel->calculateNetArcTiming(driver, sink, mode, 
-					driverState.slew, delay, slew);
-
-			TimingPinState &sinkState = timingSinkPin.state[mode];	
-			sinkState.a = delay + driverState.a;
-			sinkState.slew = slew;
-			sinkState.wdelay = delay;		
-		} // end for
-	} // end for
-	
-	if (timingPin.skip) {
-		for (Rsyn::Pin pin : net.allPins(Rsyn::SINK)) {
-			for (const TimingMode mode : allTimingModes()) {
-				const TimingPinState &driverState = timingPin.state[mode];
-
-				TimingPin &timingSinkPin = getTimingPin(pin);
-				timingSinkPin.skip = timingPin.skip;
-
-				TimingPinState & sinkState = timingSinkPin.state[mode];
-				sinkState.a = driverState.a;
-				sinkState.wdelay.set(0, 0);
-
-				if (ENABLE_UITIMER_COMPATIBILITY_MODE) {
-					for (const TimingTransition edge : allTimingTransitions()) {
-						if (std::abs(driverState.slew[edge]) == UNINITVALUE) {
-							sinkState.slew[edge] = driverState.slew[edge];
-						} // end if
-					} // end for
-				} else {
-					sinkState.slew = driverState.slew;
-				} // end else
-			} // end for
-		} // end for	
+	if (clsDefaultTimingModel) {
+		DefaultPropagation(*this, *clsDefaultTimingModel).updateNet(net);
+	} else {
+		GenericPropagation(*this, *timingModel).updateNet(net);
 	} // end else
 } // end method
 
@@ -900,127 +692,8 @@ void Timer::updateTiming_UpdateTimingTests() {
 // -----------------------------------------------------------------------------
 
 void Timer::updateTiming_PropagateRequiredTimes_Net(Rsyn::Net net) {
-	// [NOTE] 16/Sep/2015 - Guilherme Flach
-	// A bug we found was that we were propagating the required time to 
-	// from pins of arcs driven the driver pin of the net. This is ok for most
-	// cases, but breaks down whenever a from pin has more than one arc from it
-	// (e.g. multiple output cells). Be aware of that :)	
-	
-	// [ASSUMPTION] Single driver net.
-	
-	// Update driver required time.
-	Rsyn::Pin driver = net.getAnyDriver();
-	if (!driver)
-		return; // [TODO] We should still process the sinks.
-
-	TimingPin &driverTimingPin = getTimingPin(driver);
-
-	// Initialize with safe values.
-	driverTimingPin.state[EARLY].q.set(-UNINITVALUE, -UNINITVALUE);
-	driverTimingPin.state[LATE ].q.set(+UNINITVALUE, +UNINITVALUE);		
-
-	for (Rsyn::Pin sink : net.allPins(Rsyn::SINK)) {
-		TimingPin &from = getTimingPin(sink);
-
-		// Initialize worst required times with safe values.
-		// We don't reset the from required time directly to avoid 
-		// overwriting endpoint required times that are set separately.
-		EdgeArray<Number> required[NUM_TIMING_MODES];
-		for (const TimingTransition transition : allTimingTransitions()) {
-			required[EARLY][transition] = -UNINITVALUE;
-			required[LATE ][transition] = +UNINITVALUE;
-		} // end for
-
-		EdgeArray<Number> worstSpannedRequired[NUM_TIMING_MODES];	
-		for (const TimingTransition transition : allTimingTransitions()) {
-			worstSpannedRequired[EARLY][transition] = -UNINITVALUE;
-			worstSpannedRequired[LATE ][transition] = +UNINITVALUE;
-		} // end for		
-		
-		// Get the worst required time if any.
-		bool hasArcs = false;
-		for (Rsyn::Arc arc : sink.allOutgoingArcs()) {
-			TimingArc &timingArc = getTimingArc(arc);
-			TimingPin &to = getToTimingPinOfArc(arc);
-
-			if (from.isClockPin() && to.isDataPin()) {
-				// Nothing to be done here... We should consider
-				// removing the constraint timing arc from the timing graph.
-			} else {
-				hasArcs = true;
-
-				for (const TimingMode mode : allTimingModes()) {
-					for (const TimingTransition oedge : allTimingTransitions()) {
-						const TimingTransition iedge = timingArc.state[mode].backtrack[oedge];
-						const Number q = to.state[mode].q[oedge] - timingArc.state[mode].delay[oedge];
-						if (TM_MODE_REVERSE_COMPARATORS[mode](q, required[mode][iedge])) {
-							required[mode][iedge] = q;
-							worstSpannedRequired[mode][iedge] = to.state[mode].wsq[oedge];
-						} // end if
-					} // end for
-				} // end for
-			} // end else
-		} // end for	
-
-		// If we found arcs from this pin, update its required time.
-		// If no arcs were found, keep its required times untouched as they
-		// were set outside this function (e.g. data pins, primary outputs,
-		// floating pins).
-		if (hasArcs) {
-			for (const TimingMode mode : allTimingModes()) {
-				from.state[mode].q = required[mode];
-				from.state[mode].wsq = worstSpannedRequired[mode];
-			} // end for
-		} // end if			
-
-		// Update required time.
-		// Note this depends on the required times just set above. 
-		if (ENABLE_UITIMER_COMPATIBILITY_MODE && from.isClockPin()) {
-			// Note that when the update reaches this point, the data pin must
-			// already been processed.
-			
-			const TimingPin &data = getTimingPin(sink.getInstance().getPinByIndex(from.getDataPinIndex()));
-			TimingPin &ck = from; // just an alias
-
-			ck.state[EARLY].q[RISE] = std::max(ck.state[EARLY].q[RISE],
-					ck.state[EARLY].a[RISE] - data.getWorstSlack(LATE));
-			ck.state[EARLY].q[FALL] = -UNINITVALUE;										
-
-			ck.state[LATE ].q[RISE] = std::min(ck.state[LATE ].q[RISE],
-					data.getWorstSlack(EARLY) + ck.state[LATE].a[RISE]);
-			ck.state[LATE ].q[FALL] = +UNINITVALUE;
-		} // end else
-		
-		if (ENABLE_UITIMER_COMPATIBILITY_MODE && from.isDataPin()) {
-			// Note that when the update reaches this point, the required time
-			//of the clock pin was not yet processed.
-			
-			const TimingPin &data = from; // just an alias
-			TimingPin &ck =  getTimingPin(sink.getInstance().getPinByIndex(from.getClockPinIndex()));
-
-			ck.state[EARLY].q[RISE] = 
-					ck.state[EARLY].a[RISE] - data.getWorstSlack(LATE);
-			ck.state[EARLY].q[FALL] = -UNINITVALUE;										
-
-			ck.state[LATE ].q[RISE] = 
-					data.getWorstSlack(EARLY) + ck.state[LATE].a[RISE];
-			ck.state[LATE ].q[FALL] = +UNINITVALUE;
-		} // end else		
-
-		// Update required time of the driver.
-		for (const TimingMode mode : allTimingModes()) {
-			const EdgeArray<Number> wdelay = from.state[mode].wdelay;
-
-			for (const TimingTransition edge : allTimingTransitions()) {
-				const Number requred = from.state[mode].q[edge] - wdelay[edge];
-				
-				if (TM_MODE_REVERSE_COMPARATORS[mode](requred, driverTimingPin.state[mode].q[edge])) {
-					driverTimingPin.state[mode].q[edge] = from.state[mode].q[edge] - wdelay[edge];
-					driverTimingPin.state[mode].wsq[edge] = from.state[mode].wsq[edge];
-				}  // end if
-			} // end for
-		} // end for
-	} // end for each
+	// Required times do not depend on the timing model.
+	GenericPropagation(*this, *timingModel).updateRequiredTimes(net);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -2099,8 +1772,7 @@ void Timer::queryTopCriticalPaths_Queue_AddCriticalEndpoint(CriticalPathQueue &q
 		Rsyn::Pin endpoint,
 		const TimingMode mode,
 		const Number slackThreshold,
-		const bool checkSign,
-		const int sign,
+		const VisitationMarker *filter,
 		const bool debug
 ) {
 	Rsyn::Net net = endpoint.getNet();
@@ -2113,7 +1785,7 @@ void Timer::queryTopCriticalPaths_Queue_AddCriticalEndpoint(CriticalPathQueue &q
 	const TimingTransition transition = std::get<1>(slackTransitionPair);
 	const Number required = getPinRequiredTime(timingPin, mode, transition);
 
-	if (slack < slackThreshold && (!checkSign || (net && getTimingNet(net).sign == sign))) {
+	if (slack < slackThreshold && (!filter || (net && design.isVisited(*filter, net)))) {
 		Reference reference(endpoint, nullptr, nullptr, required, slack, transition, -1, transition);
 		queue.push(reference);
 		if (debug) {
@@ -2127,8 +1799,7 @@ void Timer::queryTopCriticalPaths_Queue_AddCriticalEndpoint(CriticalPathQueue &q
 void Timer::queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(CriticalPathQueue &queue,
 		const TimingMode mode,
 		const Number slackThreshold,
-		const bool checkSign,
-		const int sign,
+		const VisitationMarker *filter,
 		const bool debug
 ) {
 	// Insert the all critical endpoints in the queue. Note that even if we
@@ -2136,7 +1807,7 @@ void Timer::queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(CriticalPathQueu
 	// critical endpoints as they need to be sorted.
 	
 	for (Rsyn::Pin endpoint : allEndpoints()) {
-		queryTopCriticalPaths_Queue_AddCriticalEndpoint(queue, endpoint, mode, slackThreshold, checkSign, sign, debug);
+		queryTopCriticalPaths_Queue_AddCriticalEndpoint(queue, endpoint, mode, slackThreshold, filter, debug);
 	} // end for
 } // end method
 
@@ -2147,8 +1818,7 @@ bool Timer::queryTopCriticalPaths_Internal(CriticalPathQueue &queue,
 		const int maxNumPaths,
 		std::vector<std::vector<Timer::PathHop>> &paths, 
 		const Number slackThreshold,
-		const bool checkSign,
-		const int sign,
+		const VisitationMarker *filter,
 		const bool debug
 ) {
 	
@@ -2185,7 +1855,7 @@ bool Timer::queryTopCriticalPaths_Internal(CriticalPathQueue &queue,
 		if (getPinSlack(currentPin, mode, currentTransition) >= slackThreshold)
 			continue;
 		
-		if (checkSign && (currentNet && getTimingNet(currentNet).sign != sign))
+		if (filter && (currentNet && !design.isVisited(*filter, currentNet)))
 			continue;
 		
 		partialPaths.push_back(currentReference);
@@ -2331,8 +2001,8 @@ bool Timer::queryTopCriticalPaths(
 	const bool debug = false;
 	
 	CriticalPathQueue queue;
-	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode, slackThreshold, false, -1, debug);
-	return queryTopCriticalPaths_Internal(queue, mode, maxNumPaths, paths, slackThreshold, false, -1, debug);
+	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode, slackThreshold, nullptr, debug);
+	return queryTopCriticalPaths_Internal(queue, mode, maxNumPaths, paths, slackThreshold, nullptr, debug);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -2377,11 +2047,10 @@ int Timer::queryTopCriticalPathFromTopCriticalEndpoints(
 				std::get<1>(sortedEndpoint[i]),
 				mode,
 				slackThreshold,
-				false,
-				-1,
+				nullptr,
 				debug);
 		
-		if (queryTopCriticalPaths_Internal(queue, mode, 1, endpointPaths, slackThreshold, false, -1, debug)) {
+		if (queryTopCriticalPaths_Internal(queue, mode, 1, endpointPaths, slackThreshold, nullptr, debug)) {
 			paths[i].swap(endpointPaths[0]);
 		} // end if
 	} // end for
@@ -2433,11 +2102,10 @@ int Timer::queryTopCriticalPathsFromTopCriticalEndpoints(
 				std::get<1>(sortedEndpoint[i]),
 				mode,
 				slackThreshold,
-				false,
-				-1,
+				nullptr,
 				debug);
 		
-		if (queryTopCriticalPaths_Internal(queue, mode, maxNumPathsPerEndpoint, endpointPaths, slackThreshold, false, -1, debug)) {
+		if (queryTopCriticalPaths_Internal(queue, mode, maxNumPathsPerEndpoint, endpointPaths, slackThreshold, nullptr, debug)) {
 			const int numEndpointPaths = endpointPaths.size();
 			paths[i].resize(numEndpointPaths);
 			for (int k = 0; k < numEndpointPaths; k++) {
@@ -2466,10 +2134,10 @@ int Timer::queryTopCriticalPathsFromEndpoint(
 	CriticalPathQueue queue;
 	
 	queryTopCriticalPaths_Queue_AddCriticalEndpoint(queue, endpoint, mode, 
-			slackThreshold, false, -1, debug);
+			slackThreshold, nullptr, debug);
 
 	queryTopCriticalPaths_Internal(queue, mode, maxNumPaths, paths, 
-			slackThreshold, false, -1, debug);
+			slackThreshold, nullptr, debug);
 
 	return paths.size();
 } // end method
@@ -2484,26 +2152,26 @@ int Timer::queryTopCriticalPathsPassingThruPin(
 		const Number slackThreshold
 ) {
 	const bool debug = false;
-	const int sign = generateNextSign();
+	VisitationMarker cone;
 	
 	// Mark nets in the fan-in of the reference pin.
 	for (Rsyn::Net net : module.getFaninConeNetsInBreadthFirstOrder(referencePin)) {
-		getTimingNet(net).sign = sign;
+		design.visit(cone, net);
 	} // end for
 	
 	// Mark nets in the fan-out of the reference pin.
 	for (Rsyn::Net net : module.getFanoutConeNetsInBreadthFirstOrder(referencePin)) {
-		getTimingNet(net).sign = sign;
+		design.visit(cone, net);
 	} // end for
 	
 	// Generate paths.
 	CriticalPathQueue queue;
 	
 	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode, 
-			slackThreshold, true, sign, debug);
+			slackThreshold, &cone, debug);
 
 	queryTopCriticalPaths_Internal(queue, mode, maxNumPaths, paths, 
-			slackThreshold, true, sign, debug);
+			slackThreshold, &cone, debug);
 	
 	return paths.size();
 } // end method
@@ -2764,7 +2432,7 @@ bool Timer::queryTopCriticalEndpoints(
 	const bool debug = false;
 	
 	CriticalPathQueue queue;
-	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode, slackThreshold, false, -1, debug);
+	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode, slackThreshold, nullptr, debug);
 	
 	endpoints.clear();
 	endpoints.reserve(maxNumEndpoints);
@@ -52,12 +52,18 @@ namespace Rsyn {
 	
 class Engine;
 class Scenario;
+class DefaultTimingModel;
+
+template<class TimerType, class View, class Model>
+class TimingPropagation;
 
 ////////////////////////////////////////////////////////////////////////////////
 // Static Timing Analysis
 ////////////////////////////////////////////////////////////////////////////////
 
 class Timer : public Service, public Rsyn::Observer {
+	template<class TimerType, class View, class Model>
+	friend class TimingPropagation;
 public:
 
 	enum InputDriverDelayMode {
@@ -77,6 +83,7 @@ private:
 	Scenario *clsScenario;
 	
 	TimingModel *timingModel;
+	DefaultTimingModel *clsDefaultTimingModel = nullptr; // same as timingModel when it is a default model
 	InputDriverDelayMode inputDriverDelayMode = INPUT_DRIVER_DELAY_MODE_UI_TIMER;
 
 	Rsyn::Message msgUnusualArcType;
@@ -86,12 +93,16 @@ public:
 	
 	virtual void start(Rsyn::Engine engine, const Json &params) override;
 	virtual void stop() override;
+	virtual void reportMemoryUsage(Rsyn::MemoryReport &report) override;
 
 	virtual void
 	onPostInstanceCreate(Rsyn::Instance instance) override;
 
 	virtual void
 	onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) override;
+
+	virtual void
+	onPostTransactionCommit(const Rsyn::NetlistChanges &changes) override;
 	
 	////////////////////////////////////////////////////////////////////////////
 	// Timing Properties
@@ -244,11 +255,11 @@ private:
 	// Update Timing
 	////////////////////////////////////////////////////////////////////////////
 	
-	void updateTiming_Arc_NonUnate(const TimingMode mode, const EdgeArray<Number> islew, const EdgeArray<Number> load, Rsyn::Arc arc);
+	// The timing propagation is implemented in TimingPropagation.h. These
+	// methods instantiate it for the timing model in use.
 	void updateTiming_Arc(const TimingMode mode, const EdgeArray<Number> islew, const EdgeArray<Number> load, const bool skip, Rsyn::Arc arc, Rsyn::LibraryArc larc, TimingArcState &state);
 	
 	void updateTiming_Net_InitDriver(Rsyn::Pin driver, const TimingMode mode, const EdgeArray<Number> load);
-	void updateTiming_Net_TimingMode(const TimingMode mode, Rsyn::Net net, const EdgeArray<Number> load, Rsyn::Arc arc);
 	void updateTiming_Net(Rsyn::Net net);
 
 	void updateTiming_HandleFloatingPins();
@@ -486,10 +497,7 @@ private:
 public:	
 
 	//! @brief Sets the timing model to be used for timing calculation.
-	void setTimingModel(TimingModel *model) {
-		timingModel = model;
-		clsForceFullTimingUpdate = true;
-	} // end method
+	void setTimingModel(TimingModel *model);
 
 	//! @brief Sets the input driver delay mode.
 	void setInputDriverDelayMode(const InputDriverDelayMode mode) {
@@ -504,6 +512,11 @@ public:
 	//!        the timer already handle that internally. A typical change that
 	//!        the timer is unaware of is a placement change.
 	void dirtyInstance(Rsyn::Instance instance) { clsDirtyTimingCells.insert(instance); }
+
+	//! @brief Removes an instance from the dirty instances. Used when the 
+	//!        timing of the instance was computed elsewhere and copied to this
+	//!        timer (see SandboxTimer::commit()).
+	void undirtyInstance(Rsyn::Instance instance) { clsDirtyTimingCells.erase(instance); }
 	
 	//! @brief Notifies the timer about a change in a net.
 	//! @note  If you mark an instance as dirty automatically all nets connected
@@ -1464,15 +1477,13 @@ private:
 			Rsyn::Pin endpoint,
 			const TimingMode mode,
 			const Number slackThreshold,
-			const bool checkSign,
-			const int sign,			
+			const Rsyn::VisitationMarker *filter,
 			const bool debug);
 
 	void queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(CriticalPathQueue &queue,
 			const TimingMode mode,
 			const Number slackThreshold,
-			const bool checkSign,
-			const int sign,
+			const Rsyn::VisitationMarker *filter,
 			const bool debug);
 	
 	bool queryTopCriticalPaths_Internal(CriticalPathQueue &queue,
@@ -1480,8 +1491,7 @@ private:
 			const int maxNumPaths,
 			std::vector<std::vector<PathHop>> &paths, 
 			const Number slackThreshold,
-			const bool checkSign,
-			const int sign,
+			const Rsyn::VisitationMarker *filter,
 			const bool debug);
 
 public:
@@ -0,0 +1,555 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_TIMING_PROPAGATION_H
+#define RSYN_TIMING_PROPAGATION_H
+
+#include <cassert>
+#include <cmath>
+#include <tuple>
+
+#include "rsyn/core/Rsyn.h"
+#include "rsyn/sandbox/Sandbox.h"
+#include "rsyn/model/timing/EdgeArray.h"
+
+#include "TimingNet.h"
+#include "TimingPin.h"
+#include "TimingArc.h"
+#include "TimingLibraryArc.h"
+#include "types.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Timing propagation core shared by Timer and SandboxTimer.
+//
+// The propagation of arrival times through cells and nets and of required
+// times through nets is written once against a netlist view (Design or
+// Sandbox) and a timing model type. The timers instantiate it for the timing
+// model they are using. When the model is DefaultTimingModel (declared final),
+// the model calls in the inner loops are resolved at compile time. For any
+// other model, TimingModel is used and calls go through the virtual interface.
+//
+// The timer type must provide getTimingPin(), getTimingNet(), getTimingArc(),
+// getTimingLibraryArc(), getToTimingPinOfArc(), updateTiming_Net_InitDriver()
+// and the ENABLE_*_COMPATIBILITY_MODE flags. Timers declare this class as a
+// friend.
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Rsyn {
+
+////////////////////////////////////////////////////////////////////////////////
+// Netlist Views
+////////////////////////////////////////////////////////////////////////////////
+
+struct DesignTimingView {
+	typedef Rsyn::Net Net;
+	typedef Rsyn::Pin Pin;
+	typedef Rsyn::Arc Arc;
+
+	static Pin getDriver(Net net) { return net.getAnyDriver(); }
+}; // end struct
+
+// -----------------------------------------------------------------------------
+
+struct SandboxTimingView {
+	typedef Rsyn::SandboxNet Net;
+	typedef Rsyn::SandboxPin Pin;
+	typedef Rsyn::SandboxArc Arc;
+
+	static Pin getDriver(Net net) { return net.getDriver(); }
+}; // end struct
+
+////////////////////////////////////////////////////////////////////////////////
+// Timing Propagation
+////////////////////////////////////////////////////////////////////////////////
+
+template<class TimerType, class View, class Model>
+class TimingPropagation {
+public:
+
+	typedef typename View::Net Net;
+	typedef typename View::Pin Pin;
+	typedef typename View::Arc Arc;
+
+	TimingPropagation(TimerType &timer, Model &model) :
+		clsTimer(timer), clsModel(model) {}
+
+	//! @brief Computes the delay and output slew of a timing arc. The arc may
+	//!        be null when timing an input driver.
+	void updateArc(
+			const TimingMode mode,
+			const EdgeArray<Number> islew,
+			const EdgeArray<Number> load,
+			const bool skip,
+			Arc arc,
+			Rsyn::LibraryArc larc,
+			TimingArcState &state);
+
+	//! @brief Propagates the arrival times and slews from the inputs of the
+	//!        driver cell to the net sinks.
+	void updateNet(Net net);
+
+	//! @brief Propagates the required times from the net sinks to the net
+	//!        driver.
+	void updateRequiredTimes(Net net);
+
+private:
+
+	TimerType &clsTimer;
+	Model &clsModel;
+
+	// Returns true if a is worse than b (e.g. later arrival for LATE mode).
+	static bool isWorse(const TimingMode mode, const Number a, const Number b) {
+		return mode == LATE? a > b : a < b;
+	} // end method
+
+	// Returns true if a is a worse required time than b.
+	static bool isWorseRequired(const TimingMode mode, const Number a, const Number b) {
+		return mode == LATE? a < b : a > b;
+	} // end method
+
+	void updateArc_NonUnate(
+			const TimingMode mode,
+			const EdgeArray<Number> islew,
+			const EdgeArray<Number> load,
+			Arc arc,
+			Rsyn::LibraryArc larc,
+			TimingArcState &state);
+
+	void updateNet_TimingMode(
+			const TimingMode mode,
+			Net net,
+			const EdgeArray<Number> load,
+			Arc arc);
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+template<class TimerType, class View, class Model>
+inline
+void TimingPropagation<TimerType, View, Model>::updateArc_NonUnate(
+		const TimingMode mode,
+		const EdgeArray<Number> islew,
+		const EdgeArray<Number> load,
+		Arc arc,
+		Rsyn::LibraryArc larc,
+		TimingArcState &state
+) {
+	TimingPin &timingPinFrom = clsTimer.getTimingPin(arc.getFromPin());
+
+	if (TimerType::ENABLE_IITIMER_COMPATIBILITY_MODE) {
+
+		// Compatibility mode enables our timer to match the timing reported by
+		// the evaluation script of ICCAD 2014 Contest, which uses IITimer. In
+		// this mode timing through non-unate arcs are calculated using the
+		// worst input slew. Since some arcs may recovery slew (negative
+		// coefficients in the library), this may lead to different results if
+		// one compute the four possibilities (e.g. R->R, R->F, F->R, F->F).
+		//
+		// Note that IITimer also does not use the triggering edge of flip-flops
+		// to compute the timing through sequential arcs. IITimer treats them
+		// as regular non-unate arcs. However, for setup and hold calculation,
+		// which is not done here, IITimer assumes rising triggered flip-flops.
+
+		TimingTransition iedge;
+		switch (mode) {
+			case LATE: iedge = islew.getMaxEdge();
+				break;
+			case EARLY: iedge = islew.getMinEdge();
+				break;
+			default:
+				assert(false);
+		} // end switch
+
+		for (const TimingTransition oedge : clsTimer.allTimingTransitions()) {
+			clsModel.calculateLibraryArcTiming(larc, mode, oedge, islew[iedge], load[oedge], state.delay[oedge], state.oslew[oedge]);
+		} // end for
+
+		// Define backtrack.
+		if (isWorse(mode, timingPinFrom.state[mode].a[RISE], timingPinFrom.state[mode].a[FALL])) {
+			state.backtrack[RISE] = RISE;
+			state.backtrack[FALL] = RISE;
+		} else {
+			state.backtrack[RISE] = FALL;
+			state.backtrack[FALL] = FALL;
+		} // end else
+
+	} else {
+
+		if (timingPinFrom.clocked /*is sequential*/) {
+			// [TODO] For sequential timing arcs we should use the triggering edge
+			// to fetch the input slew.
+
+			// [NOTE] Assuming only rising edge-triggered flip-flops.
+
+			const TimingTransition iedge = RISE;
+			for (const TimingTransition oedge : clsTimer.allTimingTransitions()) {
+				clsModel.calculateLibraryArcTiming(larc, mode, oedge, islew[iedge], load[oedge], state.delay[oedge], state.oslew[oedge]);
+
+				state.backtrack[oedge] = iedge;
+			} // end for
+
+		} else {
+			// Transition direction cannot be inferred from a single input (take
+			// the worst, among rise/fall).
+
+			// Compute the four possibilities: input x output transitions.
+			Number delay[2][2]; // delay[transition at output][transition at input]
+			Number oslew[2][2]; // oslew[transition at output][transition at input]
+			for (const auto &transitions : clsTimer.allTimingTransitionPairs()) {
+				const TimingTransition iedge = std::get<0>(transitions);
+				const TimingTransition oedge = std::get<1>(transitions);
+				clsModel.calculateLibraryArcTiming(larc, mode, oedge, islew[iedge], load[oedge], delay[oedge][iedge], oslew[oedge][iedge]);
+			} // end for
+
+			// Update delay, output slew and backtrack edge.
+			for (const TimingTransition edge : clsTimer.allTimingTransitions()) {
+				// Delay and backtrack.
+				if (isWorse(mode, delay[edge][RISE], delay[edge][FALL])) {
+					state.delay[edge] = delay[edge][RISE];
+					state.backtrack[edge] = RISE;
+				} else {
+					state.delay[edge] = delay[edge][FALL];
+					state.backtrack[edge] = FALL;
+				} // end else
+
+				// Slew.
+				if (isWorse(mode, oslew[edge][RISE], oslew[edge][FALL])) {
+					state.oslew[edge] = oslew[edge][RISE];
+				} else {
+					state.oslew[edge] = oslew[edge][FALL];
+				} // end else
+			} // end for
+		} // end else
+	} // end else
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<class TimerType, class View, class Model>
+inline
+void TimingPropagation<TimerType, View, Model>::updateArc(
+		const TimingMode mode,
+		const EdgeArray<Number> islew,
+		const EdgeArray<Number> load,
+		const bool skip,
+		Arc arc,
+		Rsyn::LibraryArc larc,
+		TimingArcState &state
+) {
+	// [NOTE] By construction, ports do not have a timing arc... So we don't
+	// need to deal with ports here.
+
+	const TimingLibraryArc &libarc = clsTimer.getTimingLibraryArc(larc);
+
+	switch (libarc.sense) {
+		case POSITIVE_UNATE:
+		{
+			// Transition direction is maintained from input to output:
+			// rise->rise and fall->fall.
+
+			clsModel.calculateLibraryArcTiming(larc, mode, FALL, islew[FALL], load[FALL], state.delay[FALL], state.oslew[FALL]);
+			clsModel.calculateLibraryArcTiming(larc, mode, RISE, islew[RISE], load[RISE], state.delay[RISE], state.oslew[RISE]);
+
+			// Backtrack edge are constant for this timing sense.
+			break;
+		} // end case
+		case NEGATIVE_UNATE:
+		{
+			// Transition direction is reversed from input to output: rise->fall
+			// and fall->rise.
+
+			clsModel.calculateLibraryArcTiming(larc, mode, FALL, islew[RISE], load[FALL], state.delay[FALL], state.oslew[FALL]);
+			clsModel.calculateLibraryArcTiming(larc, mode, RISE, islew[FALL], load[RISE], state.delay[RISE], state.oslew[RISE]);
+
+			// Backtrack edge are constant for this timing sense.
+			break;
+		} // end case
+		case NON_UNATE:
+		{
+			updateArc_NonUnate(mode, islew, load, arc, larc, state);
+			break;
+		} // end case
+		default:
+			throw Exception("Invalid timing arc sense.");
+	} // end switch
+
+	if (skip) {
+		state.delay.setBoth(0);
+	} // end if
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<class TimerType, class View, class Model>
+inline
+void TimingPropagation<TimerType, View, Model>::updateNet_TimingMode(
+		const TimingMode mode,
+		Net net,
+		const EdgeArray<Number> load,
+		Arc arc
+) {
+	// Assumes the driver state has been initialized properly (i.e. driver's
+	// max arrival is set to -inf and min arrival is set to +inf and so on).
+
+	TimingNet &timingNet = clsTimer.getTimingNet(net);
+	TimingArc &timingArc = clsTimer.getTimingArc(arc);
+
+	TimingPin &timingPinFrom = clsTimer.getTimingPin(arc.getFromPin());
+	TimingPin &timingPinTo = clsTimer.getTimingPin(arc.getToPin());
+
+	TimingNetState &netState = timingNet.state[mode];
+	TimingArcState &arcState = timingArc.state[mode];
+	TimingPinState &toPinState = timingPinTo.state[mode];
+	const TimingPinState &fromPinState = timingPinFrom.state[mode];
+
+	updateArc(mode, fromPinState.slew, load, timingPinFrom.skip, arc,
+			arc.getLibraryArc(), arcState);
+
+	for (const TimingTransition edge : clsTimer.allTimingTransitions()) {
+		const Number iarrival = fromPinState.a[arcState.backtrack[edge]];
+		const Number oarrival = iarrival + arcState.delay[edge];
+
+		if (isWorse(mode, oarrival, toPinState.a[edge])) {
+			toPinState.a[edge] = oarrival;
+			netState.backtrackArc[edge] = &timingArc;
+		} // end if
+
+		if (isWorse(mode, arcState.oslew[edge], toPinState.slew[edge])) {
+			toPinState.slew[edge] = arcState.oslew[edge];
+		} // end if
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<class TimerType, class View, class Model>
+inline
+void TimingPropagation<TimerType, View, Model>::updateNet(Net net) {
+	if (net.getNumPins() < 1) {
+		return;
+	} // end if
+
+	Pin driver = View::getDriver(net);
+	TimingPin &timingPin = clsTimer.getTimingPin(driver);
+
+	// Effective load capacitance..
+	EdgeArray<Number> load[NUM_TIMING_MODES];
+
+	for (const TimingMode mode : clsTimer.allTimingModes()) {
+		// Compute effective capacitance loaded by the driver.
+		clsModel.calculateLoadCapacitance(driver, mode, load[mode]);
+
+		// Initialize the driver timing data with safe values (e.g. +inf, -inf).
+		clsTimer.updateTiming_Net_InitDriver(driver, mode, load[mode]);
+	} // end for
+
+	// Update  s delay and annotate the max and min timing data (e.g.
+	// arrival, slew).
+
+	const bool previousSkip = timingPin.skip;
+
+	int counter = 0;
+	timingPin.skip = true;
+	for (Arc arc : driver.allIncomingArcs()) {
+		updateNet_TimingMode(LATE , net, load[LATE ], arc);
+		updateNet_TimingMode(EARLY, net, load[EARLY], arc);
+
+		timingPin.skip &= clsTimer.getTimingPin(arc.getFromPin()).skip;
+		counter++;
+	} // end for
+
+	if (counter == 0)
+		timingPin.skip = previousSkip;
+
+	// Update nets and propagate the timing information
+	// to the net sinks.
+
+	for (const TimingMode mode : clsTimer.allTimingModes()) {
+		const TimingPinState &driverState = timingPin.state[mode];
+		clsModel.prepareNet(net, mode, driverState.slew);
+
+		for (Pin sink : net.allPins(Rsyn::SINK)) {
+			TimingPin &timingSinkPin = clsTimer.getTimingPin(sink);
+			timingSinkPin.skip = timingPin.skip;
+
+			EdgeArray<Number> delay;
+			EdgeArray<Number> slew;
+			clsModel.calculateNetArcTiming(driver, sink, mode,
+					driverState.slew, delay, slew);
+
+			TimingPinState &sinkState = timingSinkPin.state[mode];
+			sinkState.a = delay + driverState.a;
+			sinkState.slew = slew;
+			sinkState.wdelay = delay;
+		} // end for
+	} // end for
+
+	if (timingPin.skip) {
+		for (Pin pin : net.allPins(Rsyn::SINK)) {
+			for (const TimingMode mode : clsTimer.allTimingModes()) {
+				const TimingPinState &driverState = timingPin.state[mode];
+
+				TimingPin &timingSinkPin = clsTimer.getTimingPin(pin);
+				timingSinkPin.skip = timingPin.skip;
+
+				TimingPinState & sinkState = timingSinkPin.state[mode];
+				sinkState.a = driverState.a;
+				sinkState.wdelay.set(0, 0);
+
+				if (TimerType::ENABLE_UITIMER_COMPATIBILITY_MODE) {
+					for (const TimingTransition edge : clsTimer.allTimingTransitions()) {
+						if (std::abs(driverState.slew[edge]) == UNINITVALUE) {
+							sinkState.slew[edge] = driverState.slew[edge];
+						} // end if
+					} // end for
+				} else {
+					sinkState.slew = driverState.slew;
+				} // end else
+			} // end for
+		} // end for
+	} // end else
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<class TimerType, class View, class Model>
+inline
+void TimingPropagation<TimerType, View, Model>::updateRequiredTimes(Net net) {
+	// [NOTE] 16/Sep/2015 - Guilherme Flach
+	// A bug we found was that we were propagating the required time to
+	// from pins of arcs driven the driver pin of the net. This is ok for most
+	// cases, but breaks down whenever a from pin has more than one arc from it
+	// (e.g. multiple output cells). Be aware of that :)
+
+	// [ASSUMPTION] Single driver net.
+
+	// Update driver required time.
+	Pin driver = View::getDriver(net);
+	if (!driver)
+		return; // [TODO] We should still process the sinks.
+
+	TimingPin &driverTimingPin = clsTimer.getTimingPin(driver);
+
+	// Initialize with safe values.
+	driverTimingPin.state[EARLY].q.set(-UNINITVALUE, -UNINITVALUE);
+	driverTimingPin.state[LATE ].q.set(+UNINITVALUE, +UNINITVALUE);
+
+	for (Pin sink : net.allPins(Rsyn::SINK)) {
+		TimingPin &from = clsTimer.getTimingPin(sink);
+
+		// Initialize worst required times with safe values.
+		// We don't reset the from required time directly to avoid
+		// overwriting endpoint required times that are set separately.
+		EdgeArray<Number> required[NUM_TIMING_MODES];
+		for (const TimingTransition transition : clsTimer.allTimingTransitions()) {
+			required[EARLY][transition] = -UNINITVALUE;
+			required[LATE ][transition] = +UNINITVALUE;
+		} // end for
+
+		EdgeArray<Number> worstSpannedRequired[NUM_TIMING_MODES];
+		for (const TimingTransition transition : clsTimer.allTimingTransitions()) {
+			worstSpannedRequired[EARLY][transition] = -UNINITVALUE;
+			worstSpannedRequired[LATE ][transition] = +UNINITVALUE;
+		} // end for
+
+		// Get the worst required time if any.
+		bool hasArcs = false;
+		for (Arc arc : sink.allOutgoingArcs()) {
+			TimingArc &timingArc = clsTimer.getTimingArc(arc);
+			TimingPin &to = clsTimer.getToTimingPinOfArc(arc);
+
+			if (from.isClockPin() && to.isDataPin()) {
+				// Nothing to be done here... We should consider
+				// removing the constraint timing arc from the timing graph.
+			} else {
+				hasArcs = true;
+
+				for (const TimingMode mode : clsTimer.allTimingModes()) {
+					for (const TimingTransition oedge : clsTimer.allTimingTransitions()) {
+						const TimingTransition iedge = timingArc.state[mode].backtrack[oedge];
+						const Number q = to.state[mode].q[oedge] - timingArc.state[mode].delay[oedge];
+						if (isWorseRequired(mode, q, required[mode][iedge])) {
+							required[mode][iedge] = q;
+							worstSpannedRequired[mode][iedge] = to.state[mode].wsq[oedge];
+						} // end if
+					} // end for
+				} // end for
+			} // end else
+		} // end for
+
+		// If we found arcs from this pin, update its required time.
+		// If no arcs were found, keep its required times untouched as they
+		// were set outside this function (e.g. data pins, primary outputs,
+		// floating pins).
+		if (hasArcs) {
+			for (const TimingMode mode : clsTimer.allTimingModes()) {
+				from.state[mode].q = required[mode];
+				from.state[mode].wsq = worstSpannedRequired[mode];
+			} // end for
+		} // end if
+
+		// Update required time.
+		// Note this depends on the required times just set above.
+		if (TimerType::ENABLE_UITIMER_COMPATIBILITY_MODE && from.isClockPin()) {
+			// Note that when the update reaches this point, the data pin must
+			// already been processed.
+
+			const TimingPin &data = clsTimer.getTimingPin(sink.getInstance().getPinByIndex(from.getDataPinIndex()));
+			TimingPin &ck = from; // just an alias
+
+			ck.state[EARLY].q[RISE] = std::max(ck.state[EARLY].q[RISE],
+					ck.state[EARLY].a[RISE] - data.getWorstSlack(LATE));
+			ck.state[EARLY].q[FALL] = -UNINITVALUE;
+
+			ck.state[LATE ].q[RISE] = std::min(ck.state[LATE ].q[RISE],
+					data.getWorstSlack(EARLY) + ck.state[LATE].a[RISE]);
+			ck.state[LATE ].q[FALL] = +UNINITVALUE;
+		} // end else
+
+		if (TimerType::ENABLE_UITIMER_COMPATIBILITY_MODE && from.isDataPin()) {
+			// Note that when the update reaches this point, the required time
+			//of the clock pin was not yet processed.
+
+			const TimingPin &data = from; // just an alias
+			TimingPin &ck = clsTimer.getTimingPin(sink.getInstance().getPinByIndex(from.getClockPinIndex()));
+
+			ck.state[EARLY].q[RISE] =
+					ck.state[EARLY].a[RISE] - data.getWorstSlack(LATE);
+			ck.state[EARLY].q[FALL] = -UNINITVALUE;
+
+			ck.state[LATE ].q[RISE] =
+					data.getWorstSlack(EARLY) + ck.state[LATE].a[RISE];
+			ck.state[LATE ].q[FALL] = +UNINITVALUE;
+		} // end else
+
+		// Update required time of the driver.
+		for (const TimingMode mode : clsTimer.allTimingModes()) {
+			const EdgeArray<Number> wdelay = from.state[mode].wdelay;
+
+			for (const TimingTransition edge : clsTimer.allTimingTransitions()) {
+				const Number requred = from.state[mode].q[edge] - wdelay[edge];
+
+				if (isWorseRequired(mode, requred, driverTimingPin.state[mode].q[edge])) {
+					driverTimingPin.state[mode].q[edge] = requred;
+					driverTimingPin.state[mode].wsq[edge] = from.state[mode].wsq[edge];
+				}  // end if
+			} // end for
+		} // end for
+	} // end for each
+} // end method
+
+} // end namespace
+
+#endif /* RSYN_TIMING_PROPAGATION_H */
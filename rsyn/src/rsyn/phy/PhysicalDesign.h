@@ -44,10 +44,13 @@
 #include "rsyn/util/FloatingPoint.h"
 #include "rsyn/util/dbu.h"
 #include "rsyn/util/Proxy.h"
+#include "rsyn/util/Parallel.h"
+#include "rsyn/util/Span.h"
 #include "rsyn/phy/util/DefDescriptors.h"
 #include "rsyn/phy/util/LefDescriptors.h"
 #include "rsyn/phy/util/PhysicalTypes.h"
 #include "rsyn/phy/util/PhysicalUtil.h"
+#include "rsyn/phy/infra/RowOccupancy.h"
 #include "rsyn/util/Exception.h"
 #include "rsyn/3rdparty/json/json.hpp"
 
@@ -195,6 +198,9 @@ class PhysicalAttributeInitializerWithDefaultValue;
 #include "rsyn/phy/obj/impl/PhysicalWire.h"
 #include "rsyn/phy/obj/impl/PhysicalDesign.h"
 
+// Physical Infrastructure (depending on implementations)
+#include "rsyn/phy/infra/PlacementFork.h"
+
 
 
 
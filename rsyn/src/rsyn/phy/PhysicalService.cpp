@@ -32,6 +32,12 @@ void PhysicalService::stop() {
 
 // -----------------------------------------------------------------------------
 
+void PhysicalService::reportMemoryUsage(Rsyn::MemoryReport &report) {
+	clsPhysicalDesign.reportMemoryUsage(report);
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void PhysicalService::onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) {
 	PhysicalDesignData *data = clsPhysicalDesign.data;
 
@@ -48,8 +54,10 @@ void PhysicalService::onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibr
 	const DBU oldHeight = oldPhysicalLibraryCell.clsSize[Y];
 
 	// Update physical cell size.
+	clsPhysicalDesign.updateRowOccupancy(physicalCell, physicalCell.clsBounds, -1);
 	physicalCell.clsBounds.setLength(X, newWidth);
 	physicalCell.clsBounds.setLength(Y, newHeight);
+	clsPhysicalDesign.updateRowOccupancy(physicalCell, physicalCell.clsBounds, +1);
 
 	// Update area.
 	const DBU oldArea = oldWidth * oldHeight;
@@ -75,6 +83,9 @@ void PhysicalService::onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibr
 	} else {
 		data->clsTotalAreas[PHYSICAL_MOVABLE] += newArea;
 	} // end if-else
+
+	// Pin displacements depend on the library cell.
+	clsPhysicalDesign.updatePinPositionCache(cell);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -111,5 +122,15 @@ void PhysicalService::onPostInstanceCreate(Rsyn::Instance instance) {
 	
 	DBU area = width * height;
 	data->clsTotalAreas[PHYSICAL_MOVABLE] += area;
+
+	clsPhysicalDesign.updateRowOccupancy(physicalCell, physicalCell.clsBounds, +1);
+	clsPhysicalDesign.updatePinPositionCache(instance);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void PhysicalService::onPreInstanceRemove(Rsyn::Instance instance) {
+	// The pin ids of the removed instance may be reused by new pins.
+	clsPhysicalDesign.invalidatePinPositionCache(instance);
 } // end method
 } // end namespace
\ No newline at end of file
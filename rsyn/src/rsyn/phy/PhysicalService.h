@@ -40,6 +40,7 @@ public:
 	  stop method to the Rsyn::PhysicalDesign service
 	 */
 	virtual void stop();
+	virtual void reportMemoryUsage(Rsyn::MemoryReport &report) override;
 	
 	/*!
 	  Getting the Rsyn::PhysicalDesign object
@@ -53,6 +54,9 @@ public:
 	
 	virtual void 
 	onPostInstanceCreate(Rsyn::Instance instance) override;
+
+	virtual void
+	onPreInstanceRemove(Rsyn::Instance instance) override;
 }; // end class
 
 } // end namespace
@@ -0,0 +1,148 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rsyn/engine/Engine.h"
+#include "rsyn/phy/PhysicalService.h"
+#include "rsyn/phy/SpatialIndexService.h"
+
+namespace Rsyn {
+
+void SpatialIndexService::start(Rsyn::Engine engine, const Rsyn::Json &params) {
+	if (!engine.isServiceRunning("rsyn.physical")) {
+		std::cout << "Warning: rsyn.physical service must be running before start SpatialIndex service.\n"
+			<< "SpatialIndex was not initialized.\n";
+		return;
+	} // end if
+
+	Rsyn::PhysicalService *physical = engine.getService("rsyn.physical");
+
+	clsDesign = engine.getDesign();
+	clsPhysicalDesign = physical->getPhysicalDesign();
+
+	// Bin length in number of rows.
+	int numRows = 4;
+	numRows = params.value("numRows", numRows);
+
+	const Bounds &dieBounds = clsPhysicalDesign.getPhysicalDie().getBounds();
+	const DBU binSize = std::max(1, numRows) * clsPhysicalDesign.getRowHeight();
+	clsSpatialIndex.init(clsDesign, dieBounds, binSize);
+	clsInitialized = true;
+
+	rebuild();
+
+	// Observe changes in cell positions.
+	clsPostInstanceMovedCallbackHandler =
+			clsPhysicalDesign.addPostInstanceMovedCallback(0, [&](Rsyn::PhysicalInstance physicalInstance) {
+				Rsyn::Instance instance = physicalInstance.getInstance();
+				if (instance.getType() == Rsyn::CELL) {
+					clsSpatialIndex.update(instance, physicalInstance.getBounds());
+				} // end if
+	});
+
+	// Observe changes in the design.
+	clsDesign.registerObserver(this);
+
+	{ // reportNearestCells
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("reportNearestCells");
+		dscp.setDescription("Reports the placed cells nearest to a point.");
+
+		dscp.addPositionalParam("x",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_MANDATORY,
+			"Abscissa of the point in DBU.");
+
+		dscp.addPositionalParam("y",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_MANDATORY,
+			"Ordinate of the point in DBU.");
+
+		dscp.addNamedParam("k",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Number of cells to be reported.",
+			"10");
+
+		engine.registerCommand(dscp, [&](Rsyn::Engine engine, const ScriptParsing::Command &command) {
+			const int x = command.getParam("x");
+			const int y = command.getParam("y");
+			const int k = command.getParam("k");
+
+			std::vector<Rsyn::Instance> cells;
+			clsSpatialIndex.queryNearest(DBUxy(x, y), k, cells);
+			for (Rsyn::Instance instance : cells) {
+				const Bounds &bounds = clsPhysicalDesign.getPhysicalCell(instance.asCell()).getBounds();
+				std::cout << instance.getName() << " " << bounds << "\n";
+			} // end for
+		});
+	} // end block
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SpatialIndexService::stop() {
+	if (clsInitialized) {
+		clsPhysicalDesign.deletePostInstanceMovedCallback(clsPostInstanceMovedCallbackHandler);
+		clsDesign.unregisterObserver(this);
+		clsInitialized = false;
+	} // end if
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SpatialIndexService::indexCell(Rsyn::Cell cell) {
+	Rsyn::PhysicalCell physicalCell = clsPhysicalDesign.getPhysicalCell(cell);
+	if (physicalCell.isPlaced()) {
+		clsSpatialIndex.insert(cell, physicalCell.getBounds());
+	} // end if
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SpatialIndexService::rebuild() {
+	if (!clsInitialized)
+		return;
+
+	clsSpatialIndex.clear();
+	for (Rsyn::Instance instance : clsDesign.getTopModule().allInstances()) {
+		if (instance.getType() == Rsyn::CELL) {
+			indexCell(instance.asCell());
+		} // end if
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SpatialIndexService::onPostInstanceCreate(Rsyn::Instance instance) {
+	if (instance.getType() == Rsyn::CELL) {
+		indexCell(instance.asCell());
+	} // end if
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SpatialIndexService::onPreInstanceRemove(Rsyn::Instance instance) {
+	clsSpatialIndex.remove(instance);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SpatialIndexService::onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) {
+	// The physical service, which is started first, has already updated the
+	// cell bounds to the new library cell size.
+	indexCell(cell);
+} // end method
+
+} // end namespace
@@ -0,0 +1,62 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_SPATIAL_INDEX_SERVICE_H
+#define RSYN_SPATIAL_INDEX_SERVICE_H
+
+#include "rsyn/engine/Service.h"
+#include "rsyn/phy/PhysicalDesign.h"
+#include "rsyn/phy/infra/SpatialIndex.h"
+
+namespace Rsyn {
+
+//! @brief Keeps a spatial index of the placed cells of the top module
+//!        synchronized with the physical design.
+class SpatialIndexService : public Rsyn::Service, public Observer {
+private:
+
+	Rsyn::Design clsDesign;
+	Rsyn::PhysicalDesign clsPhysicalDesign;
+	Rsyn::SpatialIndex clsSpatialIndex;
+
+	Rsyn::PhysicalDesign::PostInstanceMovedCallbackHandler clsPostInstanceMovedCallbackHandler;
+	bool clsInitialized = false;
+
+	void indexCell(Rsyn::Cell cell);
+
+public:
+
+	virtual void start(Rsyn::Engine engine, const Rsyn::Json &params) override;
+	virtual void stop() override;
+
+	//! @brief Rebuilds the index from scratch.
+	void rebuild();
+
+	const Rsyn::SpatialIndex &getSpatialIndex() const { return clsSpatialIndex; }
+
+	// Events
+	virtual void
+	onPostInstanceCreate(Rsyn::Instance instance) override;
+
+	virtual void
+	onPreInstanceRemove(Rsyn::Instance instance) override;
+
+	virtual void
+	onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) override;
+}; // end class
+
+} // end namespace
+
+#endif /* RSYN_SPATIAL_INDEX_SERVICE_H */
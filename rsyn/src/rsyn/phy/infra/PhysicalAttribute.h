@@ -17,7 +17,7 @@
 #ifndef RSYN_PHYSICALDESIGN_ATTRIBUTE_H
 #define RSYN_PHYSICALDESIGN_ATTRIBUTE_H
 
-#include <deque>
+#include <rsyn/core/infra/ChunkedStorage.h>
 
 namespace Rsyn {
 
@@ -100,10 +100,13 @@ private:
 	List<_PhysicalObject> *clsListPtr;
 	_PhysicalObjectExtension clsDefaultValue;
 
-	typename List<_PhysicalObject>::CreateElementCallbackHandler clsHandlerOnCreate;
+	typename List<_PhysicalObject>::GrowthCallbackHandler clsHandlerOnGrowth;
 	typename List<_PhysicalObject>::DestructorCallbackHandler clsListDestructorCallbackHandler;
 
-	std::deque<_PhysicalObjectExtension> clsData;
+	// Data is stored in chunks matching the ones of the object list so that
+	// the extension of a chunk of objects is contiguous in memory.
+	typedef ChunkedStorage<_PhysicalObjectExtension, List<_PhysicalObject>::CHUNK_SIZE> Storage;
+	Storage clsData;
 
 	void accommodate(const Index index) {
 		if (index >= clsData.size()) {
@@ -114,8 +117,9 @@ private:
 protected:
 
 	void setupCallbacks() {
-		clsHandlerOnCreate = clsListPtr->addCreateCallback([&](const int index) {
-			accommodate(clsListPtr->largestId());
+		// Storage only needs to follow the list when it starts a new chunk.
+		clsHandlerOnGrowth = clsListPtr->addGrowthCallback([&](const int capacity) {
+			accommodate(capacity - 1);
 		}); // end method
 
 		clsListDestructorCallbackHandler = clsListPtr->addDestructorEventCallback([&]() {
@@ -128,7 +132,7 @@ protected:
 		clsPhysicalDesign = design;
 		clsListPtr = &list;
 		clsDefaultValue = defaultValue;
-		accommodate(clsListPtr->largestId());
+		accommodate(std::max(clsListPtr->largestId(), clsListPtr->getUsedCapacity() - 1));
 		setupCallbacks();
 	} // end method		
 
@@ -169,13 +173,12 @@ public:
 		} // end if
 
 		if (clsListPtr) {
-			clsListPtr->deleteCreateCallback(clsHandlerOnCreate);
+			clsListPtr->deleteGrowthCallback(clsHandlerOnGrowth);
 			clsListPtr->deleteDestructorCallback(clsListDestructorCallbackHandler);
 			clsListPtr = nullptr;
 		} // end if
 
 		clsData.clear();
-		clsData.shrink_to_fit();
 	} // end method	
 
 	inline _PhysicalObjectExtension &operator[](_PhysicalObjectReference obj) {
@@ -186,6 +189,20 @@ public:
 		return clsData[clsPhysicalDesign.getId(obj)];
 	}
 
+	//! @brief Returns the number of data chunks. The i-th chunk stores the
+	//!        data of the objects in the i-th chunk of the object list.
+	int getNumChunks() const { return clsData.getNumChunks(); }
+
+	//! @brief Returns the data of the objects in a chunk as a contiguous span.
+	//!        The span is indexed by object id minus span.getFirstIndex() and
+	//!        also includes entries of removed objects.
+	ChunkSpan<_PhysicalObjectExtension> getChunk(const int chunk) { return clsData.getChunk(chunk); }
+	ChunkSpan<const _PhysicalObjectExtension> getChunk(const int chunk) const { return clsData.getChunk(chunk); }
+
+	//! @brief Returns all data chunks.
+	std::vector<ChunkSpan<_PhysicalObjectExtension>> allChunks() { return clsData.allChunks(); }
+	std::vector<ChunkSpan<const _PhysicalObjectExtension>> allChunks() const { return clsData.allChunks(); }
+
 }; // end class	
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,137 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_PLACEMENT_FORK_H
+#define RSYN_PLACEMENT_FORK_H
+
+#include <vector>
+#include <limits>
+
+namespace Rsyn {
+
+//! @brief A copy-on-write fork of the cell placement of a physical design.
+//! @details Optimization trials move cells in their own fork and evaluate the
+//!          result using the positions seen by the fork, while the physical
+//!          design is left untouched. Cell data is shared with the physical
+//!          design until written, so memory grows with the number of cell
+//!          chunks a trial moves. commit() places the moved cells through
+//!          PhysicalDesign::placeCell(), so observers, the pin position cache,
+//!          the row occupancy and net bounds are updated as usual.
+//! @note    Forks can be used concurrently in different threads as long as
+//!          the design is not modified meanwhile. Commit from one thread at a
+//!          time.
+//! @note    Only the cell positions are forked. The timing seen by the fork
+//!          is the one of the design (see AttributeFork).
+class PlacementFork {
+public:
+
+	PlacementFork() {}
+
+	PlacementFork(Rsyn::PhysicalDesign physicalDesign) :
+		clsPhysicalDesign(physicalDesign),
+		clsInstances(physicalDesign.data->clsPhysicalInstances) {}
+
+	//! @brief Returns the position (lower-left corner) of the cell in this fork.
+	DBUxy getPosition(Rsyn::Cell cell) const {
+		return clsInstances.read(cell).clsBounds[LOWER];
+	} // end method
+
+	//! @brief Returns the bounds of the cell in this fork.
+	const Bounds &getBounds(Rsyn::Cell cell) const {
+		return clsInstances.read(cell).clsBounds;
+	} // end method
+
+	//! @brief Returns the pin position in this fork.
+	DBUxy getPinPosition(Rsyn::Pin pin) const;
+
+	//! @brief Returns the half-perimeter wirelength of the net in this fork.
+	DBUxy getNetHPWL(Rsyn::Net net) const;
+
+	//! @brief Moves the cell in this fork. The physical design is not changed.
+	void placeCell(Rsyn::Cell cell, const DBU x, const DBU y);
+	void placeCell(Rsyn::Cell cell, const DBUxy pos) { placeCell(cell, pos[X], pos[Y]); }
+
+	//! @brief Places the cells moved in this fork in the physical design. The
+	//!        fork is then empty and shares all data with the design again.
+	void commit();
+
+	//! @brief Discards all moves made in this fork.
+	void discard();
+
+	//! @brief Returns the number of cell moves made in this fork.
+	int getNumMoves() const { return (int) clsMovedCells.size(); }
+
+	//! @brief Returns the number of cell data chunks copied by this fork.
+	int getNumModifiedChunks() const { return clsInstances.getNumModifiedChunks(); }
+
+private:
+
+	Rsyn::PhysicalDesign clsPhysicalDesign;
+	AttributeFork<Rsyn::Instance, PhysicalInstanceData> clsInstances;
+	std::vector<Rsyn::Cell> clsMovedCells;
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+inline DBUxy PlacementFork::getPinPosition(Rsyn::Pin pin) const {
+	if (pin.getInstanceType() != Rsyn::CELL)
+		return clsPhysicalDesign.getPinPosition(pin);
+	return getPosition(pin.getInstance().asCell()) +
+			clsPhysicalDesign.getPinDisplacement(pin);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline DBUxy PlacementFork::getNetHPWL(Rsyn::Net net) const {
+	DBUxy lower(+std::numeric_limits<DBU>::max(), +std::numeric_limits<DBU>::max());
+	DBUxy upper(-std::numeric_limits<DBU>::max(), -std::numeric_limits<DBU>::max());
+	for (Rsyn::Pin pin : net.allPins()) {
+		const DBUxy pos = getPinPosition(pin);
+		lower[X] = std::min(lower[X], pos[X]);
+		lower[Y] = std::min(lower[Y], pos[Y]);
+		upper[X] = std::max(upper[X], pos[X]);
+		upper[Y] = std::max(upper[Y], pos[Y]);
+	} // end for
+	return net.getNumPins() > 0? upper - lower : DBUxy(0, 0);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void PlacementFork::placeCell(Rsyn::Cell cell, const DBU x, const DBU y) {
+	clsInstances[cell].clsBounds.moveTo(x, y);
+	clsMovedCells.push_back(cell);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void PlacementFork::commit() {
+	// Cells moved more than once are placed several times at their final
+	// position, which only notifies observers the first time.
+	for (Rsyn::Cell cell : clsMovedCells) {
+		clsPhysicalDesign.placeCell(cell, getPosition(cell));
+	} // end for
+	discard();
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void PlacementFork::discard() {
+	clsInstances.discard();
+	clsMovedCells.clear();
+} // end method
+
+} // end namespace
+
+#endif /* RSYN_PLACEMENT_FORK_H */
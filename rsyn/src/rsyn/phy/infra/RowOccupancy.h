@@ -0,0 +1,346 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_ROW_OCCUPANCY_H
+#define RSYN_ROW_OCCUPANCY_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+namespace Rsyn {
+
+//! @brief Site occupancy of a row.
+//! @details Keeps how many cells cover each site (cells may overlap during
+//!          global placement) and a segment tree summarizing the free runs of
+//!          sites. Each tree node stores the length of the free run at its
+//!          beginning, at its end and the longest free run inside it, which
+//!          allows answering free-gap queries in O(log n). Updating the
+//!          footprint of a cell spanning w sites costs O(w + log n).
+class RowOccupancy {
+public:
+
+	RowOccupancy() : clsNumSites(0), clsSize(0) {}
+
+	//! @brief Initializes an empty (all free) row with the given number of
+	//!        sites.
+	void init(const int numSites);
+
+	//! @brief Marks the sites [site, site + numSites) as covered by one more
+	//!        cell. Sites outside the row are ignored.
+	void occupy(const int site, const int numSites) { update(site, numSites, +1); }
+
+	//! @brief Undoes occupy().
+	void release(const int site, const int numSites) { update(site, numSites, -1); }
+
+	//! @brief Returns the number of sites in this row.
+	int getNumSites() const { return clsNumSites; }
+
+	//! @brief Returns the number of cells covering a site.
+	int getNumCells(const int site) const { return clsCount[site]; }
+
+	//! @brief Returns true if no cell covers the site.
+	bool isFree(const int site) const { return clsCount[site] == 0; }
+
+	//! @brief Returns true if all sites in [site, site + numSites) are inside
+	//!        the row and free.
+	bool isFree(const int site, const int numSites) const;
+
+	//! @brief Returns the length of the longest free run in the row.
+	int getLargestFreeRun() const { return clsNodes[1].best; }
+
+	//! @brief Returns the number of consecutive free sites starting at site
+	//!        towards the right (including site itself).
+	int countFreeSitesRight(const int site) const;
+
+	//! @brief Returns the number of consecutive free sites ending just before
+	//!        site towards the left (not including site itself).
+	int countFreeSitesLeft(const int site) const;
+
+	//! @brief Returns the leftmost site s >= site such that
+	//!        [s, s + numSites) is free or -1 if there is none.
+	int findFreeSitesRight(const int site, const int numSites) const;
+
+	//! @brief Returns the rightmost site s <= site such that
+	//!        [s, s + numSites) is free or -1 if there is none.
+	int findFreeSitesLeft(const int site, const int numSites) const;
+
+	//! @brief Returns the site s closest to site such that [s, s + numSites)
+	//!        is free or -1 if there is none.
+	int findNearestFreeSites(const int site, const int numSites) const;
+
+	//! @brief Returns the number of bytes allocated by this row.
+	std::size_t getMemoryUsage() const {
+		return clsCount.capacity() * sizeof(int) + clsNodes.capacity() * sizeof(Node);
+	} // end method
+
+private:
+
+	struct Node {
+		int pre; // free sites at the beginning
+		int suf; // free sites at the end
+		int best; // longest free run
+	}; // end struct
+
+	int clsNumSites;
+	int clsSize; // number of leaves (power of two)
+	std::vector<int> clsCount;
+	std::vector<Node> clsNodes;
+
+	void update(const int site, const int numSites, const int delta);
+	void setLeaf(const int site);
+	void merge(const int node, const int halfLength);
+
+	int findFirst(const int node, const int lower, const int upper,
+			const int site, const int numSites, int &carry) const;
+	int findLast(const int node, const int lower, const int upper,
+			const int site, const int numSites, int &carry) const;
+	int countRight(const int node, const int lower, const int upper,
+			const int site, bool &stop) const;
+	int countLeft(const int node, const int lower, const int upper,
+			const int site, bool &stop) const;
+}; // end class
+
+////////////////////////////////////////////////////////////////////////////////
+// Implementation
+////////////////////////////////////////////////////////////////////////////////
+
+inline void RowOccupancy::init(const int numSites) {
+	clsNumSites = std::max(0, numSites);
+	clsSize = 1;
+	while (clsSize < clsNumSites)
+		clsSize <<= 1;
+
+	clsCount.assign(clsNumSites, 0);
+	clsNodes.assign(2 * clsSize, Node());
+
+	// Padding leaves are considered occupied so that free runs never go
+	// beyond the row end.
+	for (int i = 0; i < clsSize; i++) {
+		Node &leaf = clsNodes[clsSize + i];
+		leaf.pre = leaf.suf = leaf.best = i < clsNumSites ? 1 : 0;
+	} // end for
+	for (int first = clsSize >> 1, halfLength = 1; first >= 1; first >>= 1, halfLength <<= 1) {
+		for (int node = first; node < 2 * first; node++) {
+			merge(node, halfLength);
+		} // end for
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void RowOccupancy::setLeaf(const int site) {
+	Node &leaf = clsNodes[clsSize + site];
+	leaf.pre = leaf.suf = leaf.best = clsCount[site] == 0 ? 1 : 0;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void RowOccupancy::merge(const int node, const int halfLength) {
+	const Node &left = clsNodes[2 * node];
+	const Node &right = clsNodes[2 * node + 1];
+	Node &parent = clsNodes[node];
+	parent.pre = left.pre == halfLength ? halfLength + right.pre : left.pre;
+	parent.suf = right.suf == halfLength ? halfLength + left.suf : right.suf;
+	parent.best = std::max(std::max(left.best, right.best), left.suf + right.pre);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void RowOccupancy::update(const int site, const int numSites, const int delta) {
+	const int lower = std::max(0, site);
+	const int upper = std::min(clsNumSites, site + numSites);
+	if (lower >= upper)
+		return;
+
+	bool changed = false;
+	for (int i = lower; i < upper; i++) {
+		const bool wasFree = clsCount[i] == 0;
+		clsCount[i] += delta;
+		if (wasFree != (clsCount[i] == 0)) {
+			setLeaf(i);
+			changed = true;
+		} // end if
+	} // end for
+
+	if (!changed)
+		return;
+
+	// Refresh all ancestors of the touched leaves level by level.
+	int l = (clsSize + lower) >> 1;
+	int r = (clsSize + upper - 1) >> 1;
+	for (int halfLength = 1; l >= 1; halfLength <<= 1) {
+		for (int node = l; node <= r; node++) {
+			merge(node, halfLength);
+		} // end for
+		l >>= 1;
+		r >>= 1;
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline bool RowOccupancy::isFree(const int site, const int numSites) const {
+	if (site < 0 || site + numSites > clsNumSites)
+		return false;
+	return countFreeSitesRight(site) >= numSites;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline int RowOccupancy::countRight(const int node, const int lower,
+		const int upper, const int site, bool &stop) const {
+	if (stop || upper <= site)
+		return 0;
+
+	const Node &n = clsNodes[node];
+	if (lower >= site) {
+		if (n.pre != upper - lower)
+			stop = true;
+		return n.pre;
+	} // end if
+
+	const int mid = (lower + upper) / 2;
+	const int count = countRight(2 * node, lower, mid, site, stop);
+	return count + countRight(2 * node + 1, mid, upper, site, stop);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline int RowOccupancy::countLeft(const int node, const int lower,
+		const int upper, const int site, bool &stop) const {
+	if (stop || lower >= site)
+		return 0;
+
+	const Node &n = clsNodes[node];
+	if (upper <= site) {
+		if (n.suf != upper - lower)
+			stop = true;
+		return n.suf;
+	} // end if
+
+	const int mid = (lower + upper) / 2;
+	const int count = countLeft(2 * node + 1, mid, upper, site, stop);
+	return count + countLeft(2 * node, lower, mid, site, stop);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline int RowOccupancy::countFreeSitesRight(const int site) const {
+	if (site < 0 || site >= clsNumSites)
+		return 0;
+	bool stop = false;
+	return countRight(1, 0, clsSize, site, stop);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline int RowOccupancy::countFreeSitesLeft(const int site) const {
+	if (site <= 0 || site > clsNumSites)
+		return 0;
+	bool stop = false;
+	return countLeft(1, 0, clsSize, site, stop);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+// The carry holds the length of the free run ending just before lower (and
+// starting at or after site) gathered from the nodes already visited.
+
+inline int RowOccupancy::findFirst(const int node, const int lower,
+		const int upper, const int site, const int numSites, int &carry) const {
+	if (upper <= site)
+		return -1;
+
+	const Node &n = clsNodes[node];
+	if (lower >= site) {
+		if (carry + n.pre >= numSites)
+			return lower - carry;
+		if (n.best < numSites) {
+			carry = n.pre == upper - lower ? carry + n.pre : n.suf;
+			return -1;
+		} // end if
+	} // end if
+
+	const int mid = (lower + upper) / 2;
+	const int result = findFirst(2 * node, lower, mid, site, numSites, carry);
+	if (result >= 0)
+		return result;
+	return findFirst(2 * node + 1, mid, upper, site, numSites, carry);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+// Mirror of findFirst(). Here site is an exclusive upper limit and the carry
+// holds the length of the free run starting at upper. Returns the end (one past
+// the last site) of the run.
+
+inline int RowOccupancy::findLast(const int node, const int lower,
+		const int upper, const int site, const int numSites, int &carry) const {
+	if (lower >= site)
+		return -1;
+
+	const Node &n = clsNodes[node];
+	if (upper <= site) {
+		if (carry + n.suf >= numSites)
+			return upper + carry;
+		if (n.best < numSites) {
+			carry = n.suf == upper - lower ? carry + n.suf : n.pre;
+			return -1;
+		} // end if
+	} // end if
+
+	const int mid = (lower + upper) / 2;
+	const int result = findLast(2 * node + 1, mid, upper, site, numSites, carry);
+	if (result >= 0)
+		return result;
+	return findLast(2 * node, lower, mid, site, numSites, carry);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline int RowOccupancy::findFreeSitesRight(const int site, const int numSites) const {
+	if (numSites <= 0 || numSites > clsNumSites)
+		return -1;
+	int carry = 0;
+	return findFirst(1, 0, clsSize, std::max(0, site), numSites, carry);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline int RowOccupancy::findFreeSitesLeft(const int site, const int numSites) const {
+	if (numSites <= 0 || numSites > clsNumSites || site < 0)
+		return -1;
+	const int limit = std::min(clsNumSites, site + numSites);
+	int carry = 0;
+	const int end = findLast(1, 0, clsSize, limit, numSites, carry);
+	return end < 0 ? -1 : end - numSites;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline int RowOccupancy::findNearestFreeSites(const int site, const int numSites) const {
+	const int right = findFreeSitesRight(site, numSites);
+	const int left = findFreeSitesLeft(site, numSites);
+	if (right < 0)
+		return left;
+	if (left < 0)
+		return right;
+	return std::abs(right - site) <= std::abs(site - left) ? right : left;
+} // end method
+
+} // end namespace
+
+#endif /* RSYN_ROW_OCCUPANCY_H */
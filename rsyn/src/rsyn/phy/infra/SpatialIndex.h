@@ -0,0 +1,450 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_SPATIAL_INDEX_H
+#define RSYN_SPATIAL_INDEX_H
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include "rsyn/core/Rsyn.h"
+#include "rsyn/util/Bounds.h"
+
+namespace Rsyn {
+
+//! @brief Uniform bucket grid indexing the bounds of instances.
+//! @note  Queries are const and do not touch any shared scratch state, so any
+//!        number of threads may query the index concurrently as long as no
+//!        thread is inserting, removing or updating instances.
+class SpatialIndex {
+public:
+
+	//! @brief An instance along with its bounds as stored in the bins.
+	struct Item {
+		Rsyn::Instance instance;
+		Bounds bounds;
+
+		Item() {}
+		Item(Rsyn::Instance instance, const Bounds &bounds) :
+				instance(instance), bounds(bounds) {}
+	}; // end struct
+
+	SpatialIndex() : clsBinSize(0), clsNumCols(0), clsNumRows(0), clsNumItems(0) {}
+
+	//! @brief Initializes an empty index covering the region using square bins
+	//!        of the given length.
+	void init(Rsyn::Design design, const Bounds &region, const DBU binSize);
+
+	//! @brief Removes all instances keeping the grid.
+	void clear();
+
+	//! @brief Inserts an instance. If the instance is already indexed, its
+	//!        bounds are updated.
+	void insert(Rsyn::Instance instance, const Bounds &bounds);
+
+	//! @brief Removes an instance. Does nothing if the instance is not indexed.
+	void remove(Rsyn::Instance instance);
+
+	//! @brief Updates the bounds of an indexed instance (e.g. after a move).
+	void update(Rsyn::Instance instance, const Bounds &bounds);
+
+	//! @brief Returns true if the instance is stored in this index.
+	bool contains(Rsyn::Instance instance) const;
+
+	//! @brief Returns the bounds stored for an indexed instance.
+	const Bounds &getBounds(Rsyn::Instance instance) const;
+
+	//! @brief Calls visitor(instance, bounds) once for each instance whose
+	//!        bounds overlap the rectangle. Touching rectangles are not
+	//!        considered overlapping (same semantics as Bounds::overlap()).
+	template<typename Visitor>
+	void visitRectangle(const Bounds &rect, Visitor visitor) const;
+
+	//! @brief Returns the instances whose bounds overlap the rectangle.
+	void queryRectangle(const Bounds &rect, std::vector<Rsyn::Instance> &result) const;
+
+	//! @brief Returns up to k instances closest to the point sorted by their
+	//!        Manhattan distance to the point (zero if the point is inside).
+	void queryNearest(const DBUxy p, const int k, std::vector<Rsyn::Instance> &result) const;
+
+	//! @brief Shoots an axis-aligned ray from origin along the dimension
+	//!        towards the lower (decreasing) or upper (increasing) side and
+	//!        returns the first instance hit within maxDistance. The distance
+	//!        to the hit instance is stored in distance. Instances containing
+	//!        the origin are ignored as well as the instance to be skipped.
+	//!        Returns a null instance if nothing is hit.
+	Rsyn::Instance queryRay(const DBUxy origin, const Dimension dim,
+			const Boundary direction, const DBU maxDistance, DBU &distance,
+			Rsyn::Instance skip = nullptr) const;
+
+	DBU getBinSize() const { return clsBinSize; }
+	int getNumCols() const { return clsNumCols; }
+	int getNumRows() const { return clsNumRows; }
+	int getNumBins() const { return clsNumCols * clsNumRows; }
+	int getNumItems() const { return clsNumItems; }
+	const Bounds &getRegion() const { return clsRegion; }
+
+private:
+
+	struct Entry {
+		Bounds bounds;
+		bool indexed = false;
+	}; // end struct
+
+	Rsyn::Attribute<Rsyn::Instance, Entry> clsEntries;
+	std::vector<std::vector<Item>> clsBins;
+	Bounds clsRegion;
+	DBU clsBinSize;
+	int clsNumCols;
+	int clsNumRows;
+	int clsNumItems;
+
+	int getCol(const DBU x) const {
+		const int col = (int) ((x - clsRegion[LOWER][X]) / clsBinSize);
+		return std::max(0, std::min(col, clsNumCols - 1));
+	} // end method
+
+	int getRow(const DBU y) const {
+		const int row = (int) ((y - clsRegion[LOWER][Y]) / clsBinSize);
+		return std::max(0, std::min(row, clsNumRows - 1));
+	} // end method
+
+	int getIndex(const int row, const int col) const {
+		return row * clsNumCols + col;
+	} // end method
+
+	// The upper corner is exclusive so that a cell abutting a bin boundary is
+	// not stored in the neighbor bin.
+	void getBinRange(const Bounds &bounds, int &row0, int &col0, int &row1, int &col1) const {
+		col0 = getCol(bounds[LOWER][X]);
+		row0 = getRow(bounds[LOWER][Y]);
+		col1 = getCol(std::max(bounds[LOWER][X], bounds[UPPER][X] - 1));
+		row1 = getRow(std::max(bounds[LOWER][Y], bounds[UPPER][Y] - 1));
+	} // end method
+
+	void addToBins(Rsyn::Instance instance, const Bounds &bounds);
+	void removeFromBins(Rsyn::Instance instance, const Bounds &bounds);
+
+	static DBU computeManhattanDistance(const Bounds &bounds, const DBUxy p) {
+		const DBUxy q = bounds.closestPoint(p);
+		return std::abs(q[X] - p[X]) + std::abs(q[Y] - p[Y]);
+	} // end method
+
+}; // end class
+
+////////////////////////////////////////////////////////////////////////////////
+// Implementation
+////////////////////////////////////////////////////////////////////////////////
+
+inline void SpatialIndex::init(Rsyn::Design design, const Bounds &region, const DBU binSize) {
+	clsEntries = design.createAttribute();
+	clsRegion = region;
+	clsBinSize = std::max(binSize, (DBU) 1);
+	clsNumCols = std::max(1, (int) roundedUpIntegralDivision(region.computeLength(X), clsBinSize));
+	clsNumRows = std::max(1, (int) roundedUpIntegralDivision(region.computeLength(Y), clsBinSize));
+	clsBins.clear();
+	clsBins.resize(getNumBins());
+	clsNumItems = 0;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void SpatialIndex::clear() {
+	for (std::vector<Item> &bin : clsBins) {
+		for (Item &item : bin) {
+			clsEntries[item.instance].indexed = false;
+		} // end for
+		bin.clear();
+	} // end for
+	clsNumItems = 0;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void SpatialIndex::addToBins(Rsyn::Instance instance, const Bounds &bounds) {
+	int row0, col0, row1, col1;
+	getBinRange(bounds, row0, col0, row1, col1);
+	for (int row = row0; row <= row1; row++) {
+		for (int col = col0; col <= col1; col++) {
+			clsBins[getIndex(row, col)].push_back(Item(instance, bounds));
+		} // end for
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void SpatialIndex::removeFromBins(Rsyn::Instance instance, const Bounds &bounds) {
+	int row0, col0, row1, col1;
+	getBinRange(bounds, row0, col0, row1, col1);
+	for (int row = row0; row <= row1; row++) {
+		for (int col = col0; col <= col1; col++) {
+			std::vector<Item> &bin = clsBins[getIndex(row, col)];
+			for (int i = 0; i < (int) bin.size(); i++) {
+				if (bin[i].instance == instance) {
+					bin[i] = bin.back();
+					bin.pop_back();
+					break;
+				} // end if
+			} // end for
+		} // end for
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void SpatialIndex::insert(Rsyn::Instance instance, const Bounds &bounds) {
+	Entry &entry = clsEntries[instance];
+	if (entry.indexed) {
+		update(instance, bounds);
+		return;
+	} // end if
+
+	entry.bounds = bounds;
+	entry.indexed = true;
+	addToBins(instance, bounds);
+	clsNumItems++;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void SpatialIndex::remove(Rsyn::Instance instance) {
+	Entry &entry = clsEntries[instance];
+	if (!entry.indexed)
+		return;
+
+	removeFromBins(instance, entry.bounds);
+	entry.indexed = false;
+	clsNumItems--;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void SpatialIndex::update(Rsyn::Instance instance, const Bounds &bounds) {
+	Entry &entry = clsEntries[instance];
+	if (!entry.indexed) {
+		insert(instance, bounds);
+		return;
+	} // end if
+
+	int oldRow0, oldCol0, oldRow1, oldCol1;
+	int newRow0, newCol0, newRow1, newCol1;
+	getBinRange(entry.bounds, oldRow0, oldCol0, oldRow1, oldCol1);
+	getBinRange(bounds, newRow0, newCol0, newRow1, newCol1);
+
+	if (oldRow0 == newRow0 && oldCol0 == newCol0 &&
+			oldRow1 == newRow1 && oldCol1 == newCol1) {
+		// Most moves are local, so just refresh the bounds in place.
+		for (int row = newRow0; row <= newRow1; row++) {
+			for (int col = newCol0; col <= newCol1; col++) {
+				for (Item &item : clsBins[getIndex(row, col)]) {
+					if (item.instance == instance) {
+						item.bounds = bounds;
+						break;
+					} // end if
+				} // end for
+			} // end for
+		} // end for
+	} else {
+		removeFromBins(instance, entry.bounds);
+		addToBins(instance, bounds);
+	} // end else
+
+	entry.bounds = bounds;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline bool SpatialIndex::contains(Rsyn::Instance instance) const {
+	return clsEntries[instance].indexed;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline const Bounds &SpatialIndex::getBounds(Rsyn::Instance instance) const {
+	return clsEntries[instance].bounds;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+template<typename Visitor>
+inline void SpatialIndex::visitRectangle(const Bounds &rect, Visitor visitor) const {
+	if (!clsNumItems || !rect.overlap(clsRegion))
+		return;
+
+	int qRow0, qCol0, qRow1, qCol1;
+	getBinRange(rect, qRow0, qCol0, qRow1, qCol1);
+
+	for (int row = qRow0; row <= qRow1; row++) {
+		for (int col = qCol0; col <= qCol1; col++) {
+			for (const Item &item : clsBins[getIndex(row, col)]) {
+				if (!item.bounds.overlap(rect))
+					continue;
+
+				// An instance spanning several bins is reported only by the
+				// first bin shared by the query and the instance. This avoids
+				// duplicates without marking, which keeps queries read-only.
+				int row0, col0, row1, col1;
+				getBinRange(item.bounds, row0, col0, row1, col1);
+				if (row != std::max(row0, qRow0) || col != std::max(col0, qCol0))
+					continue;
+
+				visitor(item.instance, item.bounds);
+			} // end for
+		} // end for
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void SpatialIndex::queryRectangle(const Bounds &rect, std::vector<Rsyn::Instance> &result) const {
+	result.clear();
+	visitRectangle(rect, [&](Rsyn::Instance instance, const Bounds &bounds) {
+		result.push_back(instance);
+	});
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void SpatialIndex::queryNearest(const DBUxy p, const int k, std::vector<Rsyn::Instance> &result) const {
+	result.clear();
+	if (k <= 0 || !clsNumItems)
+		return;
+
+	// Max-heap on distance holding the best k candidates found so far.
+	typedef std::pair<DBU, Rsyn::Instance> Candidate;
+	auto compare = [](const Candidate &a, const Candidate &b) {
+		return a.first < b.first;
+	};
+	std::vector<Candidate> heap;
+	heap.reserve(k + 1);
+
+	const int centerRow = getRow(p[Y]);
+	const int centerCol = getCol(p[X]);
+	const int maxRing = std::max(clsNumRows, clsNumCols);
+
+	for (int ring = 0; ring <= maxRing; ring++) {
+		// Any bin in this ring is at least (ring - 1) bins away from the
+		// point, so stop as soon as it can not improve the k-th candidate.
+		if ((int) heap.size() == k && (ring - 1) * clsBinSize > heap.front().first)
+			break;
+
+		const int row0 = centerRow - ring;
+		const int row1 = centerRow + ring;
+		const int col0 = centerCol - ring;
+		const int col1 = centerCol + ring;
+		if (row0 < 0 && col0 < 0 && row1 >= clsNumRows && col1 >= clsNumCols)
+			break;
+
+		for (int row = std::max(0, row0); row <= std::min(row1, clsNumRows - 1); row++) {
+			const bool fullRow = row == row0 || row == row1;
+			for (int col = std::max(0, col0); col <= std::min(col1, clsNumCols - 1); col++) {
+				if (!fullRow && col != col0 && col != col1)
+					continue;
+
+				for (const Item &item : clsBins[getIndex(row, col)]) {
+					const DBU distance = computeManhattanDistance(item.bounds, p);
+					if ((int) heap.size() == k && distance >= heap.front().first)
+						continue;
+
+					bool duplicate = false;
+					for (const Candidate &candidate : heap) {
+						if (candidate.second == item.instance) {
+							duplicate = true;
+							break;
+						} // end if
+					} // end for
+					if (duplicate)
+						continue;
+
+					heap.push_back(Candidate(distance, item.instance));
+					std::push_heap(heap.begin(), heap.end(), compare);
+					if ((int) heap.size() > k) {
+						std::pop_heap(heap.begin(), heap.end(), compare);
+						heap.pop_back();
+					} // end if
+				} // end for
+			} // end for
+		} // end for
+	} // end for
+
+	std::sort_heap(heap.begin(), heap.end(), compare);
+	result.reserve(heap.size());
+	for (const Candidate &candidate : heap) {
+		result.push_back(candidate.second);
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline Rsyn::Instance SpatialIndex::queryRay(const DBUxy origin,
+		const Dimension dim, const Boundary direction, const DBU maxDistance,
+		DBU &distance, Rsyn::Instance skip) const {
+	distance = std::numeric_limits<DBU>::max();
+	Rsyn::Instance hit = nullptr;
+
+	if (!clsNumItems || !clsRegion.inside(origin))
+		return hit;
+
+	const Dimension other = REVERSE_DIMENSION[dim];
+	const int step = direction == LOWER ? -1 : +1;
+	const int numSteps = dim == X ? clsNumCols : clsNumRows;
+	const int fixed = dim == X ? getRow(origin[Y]) : getCol(origin[X]);
+	int current = dim == X ? getCol(origin[X]) : getRow(origin[Y]);
+
+	for (; current >= 0 && current < numSteps; current += step) {
+		// Stop when the near side of the current bin is already farther than
+		// the best hit (or the maximum distance).
+		const DBU binLower = clsRegion[LOWER][dim] + current * clsBinSize;
+		const DBU binUpper = binLower + clsBinSize;
+		const DBU gap = direction == LOWER ?
+				origin[dim] - binUpper : binLower - origin[dim];
+		if (gap > std::min(distance, maxDistance))
+			break;
+
+		const int index = dim == X ?
+				getIndex(fixed, current) : getIndex(current, fixed);
+		for (const Item &item : clsBins[index]) {
+			if (item.instance == skip)
+				continue;
+
+			const Bounds &bounds = item.bounds;
+			if (origin[other] < bounds[LOWER][other] || origin[other] >= bounds[UPPER][other])
+				continue;
+
+			DBU d;
+			if (direction == LOWER) {
+				if (bounds[UPPER][dim] > origin[dim])
+					continue;
+				d = origin[dim] - bounds[UPPER][dim];
+			} else {
+				if (bounds[LOWER][dim] < origin[dim])
+					continue;
+				d = bounds[LOWER][dim] - origin[dim];
+			} // end else
+
+			if (d <= maxDistance && d < distance) {
+				distance = d;
+				hit = item.instance;
+			} // end if
+		} // end for
+	} // end for
+
+	return hit;
+} // end method
+
+} // end namespace
+
+#endif /* RSYN_SPATIAL_INDEX_H */
@@ -68,12 +68,30 @@ public:
 	int clsNumLayers[NUM_PHY_LAYER];
 
 	DBUxy clsHPWL;
+
+	// Absolute pin positions indexed by pin id and whether each entry is up to
+	// date. Only kept when clsEnablePinPositionCache is set.
+	std::vector<DBU> clsPinPositions[2];
+	std::vector<char> clsPinPositionValid;
+
+	// Site occupancy of rows indexed by row id and row ids sorted by their
+	// lower ordinate. Only kept when clsEnableRowOccupancy is set.
+	std::vector<RowOccupancy> clsRowOccupancy;
+	std::vector<PhysicalIndex> clsRowsSortedByY;
+	DBU clsMaxRowHeight = 0;
 	DBU clsDBUs[NUM_DBU]; // LEF and DEF data base units resolution and DEF/LEF multiplier factor
 
 	bool clsLoadDesign : 1;
 	bool clsEnablePhysicalPins : 1;
 	bool clsEnableMergeRectangles : 1;
 	bool clsEnableNetPinBoundaries : 1;
+	bool clsEnablePinPositionCache : 1;
+	bool clsEnableRowOccupancy : 1;
+
+	// Whether updateAllNetBounds() was called, so the net bounds can be
+	// updated incrementally as cells move, and whether it skipped the clock.
+	bool clsNetBoundsValid : 1;
+	bool clsSkipClockNetBound : 1;
 
 	Rsyn::Net clsClkNet;
 
@@ -88,6 +106,10 @@ public:
 		clsEnablePhysicalPins = false;
 		clsEnableMergeRectangles = false;
 		clsEnableNetPinBoundaries = false;
+		clsEnablePinPositionCache = false;
+		clsEnableRowOccupancy = false;
+		clsNetBoundsValid = false;
+		clsSkipClockNetBound = false;
 		for (int index = 0; index < NUM_DBU; index++) {
 			clsDBUs[index] = 0;
 		} // end for 
@@ -35,6 +35,7 @@ namespace Rsyn {
 
 class PhysicalDesign : public Proxy<PhysicalDesignData> {
 	friend class PhysicalService;
+	friend class PlacementFork;
 
 	template<typename _PhysicalObject, typename _PhysicalObjectReference, typename _PhysicalObjectExtension> friend class PhysicalAttributeBase;
 	template<typename _PhysicalObject, typename _PhysicalObjectExtension> friend class PhysicalAttributeImplementation;
@@ -77,7 +78,9 @@ public:
 	//! @brief	Initializes the Rsyn::PhysicalDesignData, the attributes to the Rsyn::Design elements and control parameters.
 	//! @param	Json &params may be: 1) "clsEnablePhysicalPins" true enables Rsyn::PhysicalPin, 
 	//! 2) "clsEnableMergeRectangles" true enables merging rectangle bounds to be merged. It does not work to bounds defined as polygon, and 
-	//! 3) "clsEnableNetPinBoundaries" true enables storing the pins (Rsyn::Pin) that defines the Bound box boundaries of the nets.
+	//! 3) "clsEnableNetPinBoundaries" true enables storing the pins (Rsyn::Pin) that defines the Bound box boundaries of the nets, and
+	//! 4) "clsEnablePinPositionCache" true enables keeping the absolute position of all pins in contiguous arrays, and
+	//! 5) "clsEnableRowOccupancy" true enables keeping the site occupancy of the rows.
 	void initPhysicalDesign(Rsyn::Design dsg, const Json &params = {});
 
 	//! @brief	Setting the net clock. Otherwise, it is defined as nullptr.
@@ -85,12 +88,25 @@ public:
 
 	//! @brief	Updating the Bound Box of all design nets. 
 	//! @param	skipClockNet default is value false. Otherwise, the Bound Box of the clock network is skipped to update and is not added to total HPWL.
+	//! @details	Large designs are split among threads. Afterwards, if "clsEnableNetPinBoundaries" is set,
+	//! placeCell() and updatePhysicalCell() keep the bounds of the nets of the moved cell up to date.
 	void updateAllNetBounds(const bool skipClockNet = false);
 
 	//! @brief	Updating the Bound box of method parameter net of the Design.
 	//! @param	net A valid net of the Design.
 	void updateNetBound(Rsyn::Net net);
 
+	//! @brief	Incrementally updates the Bound Box of the net connected to the pin after the pin has moved.
+	//! @details	Runs in constant time unless the pin was defining a boundary of the net and moved inward, 
+	//! in which case the whole net is rescanned. Requires "clsEnableNetPinBoundaries", otherwise the 
+	//! net is always rescanned.
+	//! @param	pin A valid pin of the Design. Nothing is done if the pin is not connected to a net.
+	void updateNetBound(Rsyn::Pin pin);
+
+	//! @brief	Incrementally updates the Bound Box of all nets connected to the instance after it has moved.
+	//! @see	updateNetBound(Rsyn::Pin pin)
+	void updateNetBounds(Rsyn::Instance instance);
+
 	//! @brief	Returns the Data base resolution. 
 	//! @param	type 
 	//! @details	type is an enum defined as: Rsyn::LIBRARY_DBU to technology library data base resolution, 
@@ -197,6 +213,36 @@ public:
 	//! @brief Returns the pin position. The position is the summation of pin displacement and its cell position.
 	DBU getPinPosition(Rsyn::Pin pin, const Dimension dim) const;
 
+	//! @brief Returns the pin position stored in the pin position cache.
+	//! @details Much cheaper than getPinPosition() as it is just two array reads. 
+	//! The cache is refreshed by placeCell(), updatePhysicalCell() and updateAllNetBounds().
+	//! Falls back to getPinPosition() if the pin has no up-to-date cache entry 
+	//! (e.g. the cache is disabled or the pin was created after the cache was built).
+	DBUxy getCachedPinPosition(Rsyn::Pin pin) const;
+	//! @brief Returns the pin position for abscissa or ordinate stored in the pin position cache.
+	//! @details Falls back to getPinPosition() as getCachedPinPosition(pin) does.
+	DBU getCachedPinPosition(Rsyn::Pin pin, const Dimension dim) const;
+	//! @brief Returns a view of the cached pin positions for abscissa or ordinate.
+	//! @details Intended for bulk consumers that stream over pin positions. The position of a pin is stored at 
+	//! getPinPositionCacheIndex(pin) if that index is smaller than the span size and isPinPositionCached(pin) 
+	//! is true. The view is invalidated when pins are created.
+	//! @warning Only valid if "clsEnablePinPositionCache" is true.
+	Span<DBU> allCachedPinPositions(const Dimension dim) const;
+	//! @brief Returns true if the pin has an up-to-date entry in the pin position cache.
+	bool isPinPositionCached(Rsyn::Pin pin) const;
+	//! @brief Returns the index of the pin in the arrays returned by allCachedPinPositions().
+	//! @details The index is stable while the pin exists, so consumers may compute it once.
+	Index getPinPositionCacheIndex(Rsyn::Pin pin) const;
+	//! @brief Returns true if the pin position cache is enabled.
+	bool isEnablePinPositionCache() const;
+	//! @brief Recomputes the cached position of all pins. Does nothing if the pin position cache is disabled.
+	void updatePinPositionCache();
+	//! @brief Recomputes the cached position of the instance pins. Does nothing if the pin position cache is disabled.
+	void updatePinPositionCache(Rsyn::Instance instance);
+	//! @brief Marks the cached position of the instance pins as out of date. Called before the instance is 
+	//! removed so that its pin ids are not read back as valid when they are reused.
+	void invalidatePinPositionCache(Rsyn::Instance instance);
+
 	//! @brief	Returns the Rsyn::PhysicalNet object related to the net parameter.
 	Rsyn::PhysicalNet getPhysicalNet(Rsyn::Net net) const;
 
@@ -287,9 +333,19 @@ protected:
 	void mergeBounds(const std::vector<Bounds> & source, std::vector<Bounds> & target, const Dimension dim = X);
 
 private:
+	//! @brief Recomputes the Bound Box of the net from scratch and returns the HPWL variation. 
+	//! @details Only touches data of the net, so different nets can be safely handled in parallel.
+	DBUxy computeNetBound(Rsyn::Net net);
+
+	//! @brief	Returns true if net bounds are updated as cells move.
+	bool isNetBoundIncremental() const;
+
 	//! @brief Returns the Rsyn::PhysicalRow unique identifier.
 	PhysicalIndex getId(Rsyn::PhysicalRow phRow) const;
 
+	//! @brief Adds (delta = +1) or removes (delta = -1) the bounds of a cell from the row occupancy. 
+	void updateRowOccupancy(const PhysicalInstanceData &physicalCell, const Bounds &bounds, const int delta);
+
 	//! @brief Returns the Rsyn::PhysicalLayer unique identifier.
 	PhysicalIndex getId(Rsyn::PhysicalLayer phLayer) const;
 
@@ -344,6 +400,45 @@ public:
 	//! @brief Notify observers that a cell was moved. Ignores to notify the observers passed in the parameter. 
 	void notifyObservers(Rsyn::PhysicalInstance instance, const PostInstanceMovedCallbackHandler &ignoreObserver);
 
+	////////////////////////////////////////////////////////////////////////////
+	// Row Occupancy
+	//--------------------------------------------------------------------------
+	// Keeps which row sites are covered by placed cells. It is updated by 
+	// placeCell() and answers legality queries in logarithmic time. A site is 
+	// considered occupied if any cell overlaps it even partially. Unlike Jezz, 
+	// which only tracks legalized cells, every placed cell marks its sites, 
+	// including cells overlapping others. 
+	// Only available if "clsEnableRowOccupancy" is true.
+	////////////////////////////////////////////////////////////////////////////
+
+	//! @brief Returns true if the row site occupancy is enabled.
+	bool isEnableRowOccupancy() const;
+	//! @brief Rebuilds the site occupancy of all rows from the current cell positions.
+	void updateRowOccupancy();
+	//! @brief Returns the site occupancy of the row.
+	const RowOccupancy &getRowOccupancy(Rsyn::PhysicalRow phRow) const;
+	//! @brief Returns the row containing the point or nullptr if there is none.
+	Rsyn::PhysicalRow getPhysicalRowAt(const DBUxy pos) const;
+	//! @brief Returns true if the row interval [x, x + width) does not overlap any placed cell.
+	bool isRowSpaceFree(Rsyn::PhysicalRow phRow, const DBU x, const DBU width) const;
+	//! @brief Finds the site-aligned position closest to x where the row interval [pos, pos + width) 
+	//! does not overlap any placed cell.
+	//! @return false if there is no such position in the row.
+	bool findNearestRowSpace(Rsyn::PhysicalRow phRow, const DBU x, const DBU width, DBU &pos) const;
+	//! @brief Returns the free space in the row at the left (LOWER) or right (UPPER) of x.
+	//! @details For LOWER, the free space ends at the site starting at or before x. For UPPER, 
+	//! it starts at the site ending at or after x. 
+	DBU getRowFreeSpace(Rsyn::PhysicalRow phRow, const DBU x, const Boundary side) const;
+
+	////////////////////////////////////////////////////////////////////////////
+	// Memory
+	////////////////////////////////////////////////////////////////////////////
+
+public:
+
+	//! @brief Adds the memory used by the physical layer to a report.
+	void reportMemoryUsage(MemoryReport &report);
+
 	////////////////////////////////////////////////////////////////////////////
 	// Notification
 	////////////////////////////////////////////////////////////////////////////		
@@ -354,7 +449,7 @@ public:
 	PostInstanceMovedCallbackHandler
 	addPostInstanceMovedCallback(const int priority, PostInstanceMovedCallback f);
 
-	//! @todo 
+	//! @brief unregisters a callback previously added by addPostInstanceMovedCallback().
 	void
 	deletePostInstanceMovedCallback(PostInstanceMovedCallbackHandler &handler);
 
@@ -151,6 +151,8 @@ inline void PhysicalDesign::loadDesign(const DefDscp & design) {
 
 	// only to keep coherence in the design;
 	data->clsNumElements[PHYSICAL_PORT] = data->clsDesign.getNumInstances(Rsyn::PORT);
+
+	updateRowOccupancy();
 } // end method 
 
 // -----------------------------------------------------------------------------
@@ -166,6 +168,8 @@ inline void PhysicalDesign::initPhysicalDesign(Rsyn::Design dsg, const Json &par
 		data->clsEnablePhysicalPins = params.value("clsEnablePhysicalPins", data->clsEnablePhysicalPins);
 		data->clsEnableMergeRectangles = params.value("clsEnableMergeRectangles", data->clsEnableMergeRectangles);
 		data->clsEnableNetPinBoundaries = params.value("clsEnableNetPinBoundaries", data->clsEnableNetPinBoundaries);
+		data->clsEnablePinPositionCache = params.value("clsEnablePinPositionCache", data->clsEnablePinPositionCache);
+		data->clsEnableRowOccupancy = params.value("clsEnableRowOccupancy", data->clsEnableRowOccupancy);
 	} // end if 
 
 	data->clsDesign = dsg;
@@ -192,30 +196,105 @@ inline void PhysicalDesign::updateAllNetBounds(const bool skipClockNet) {
 		data->clsHPWL -= phNet.getHPWL();
 	} // end if 
 
-	for (Rsyn::Net net : data->clsModule.allNets()) {
+	updatePinPositionCache();
+
+	// Each net only touches its own data, so nets can be processed in
+	// parallel. Partial wirelength variations are reduced in the order of the
+	// nets, so that the final HPWL does not depend on scheduling.
+	const Rsyn::Net clockNet = skipClockNet ? data->clsClkNet : nullptr;
+	data->clsHPWL += parallel_reduce(data->clsModule.allNets(), DBUxy(0, 0),
+			[this, clockNet](Rsyn::Net net) {
 		//skipping clock network
-		if (skipClockNet && (data->clsClkNet == net))
-			continue;
+		return net == clockNet ? DBUxy(0, 0) : computeNetBound(net);
+	}, std::plus<DBUxy>());
 
-		updateNetBound(net);
-	} // end for
+	data->clsNetBoundsValid = true;
+	data->clsSkipClockNetBound = skipClockNet;
 } // end method 
 
 // -----------------------------------------------------------------------------
 
 inline void PhysicalDesign::updateNetBound(Rsyn::Net net) {
+	data->clsHPWL += computeNetBound(net);
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void PhysicalDesign::updateNetBound(Rsyn::Pin pin) {
+	Rsyn::Net net = pin.getNet();
+	if (!net || (data->clsSkipClockNetBound && net == data->clsClkNet))
+		return;
+
+	PhysicalNetData &phNet = data->clsPhysicalNets[net];
+
+	// Without the pins defining the boundaries we can not tell whether the
+	// moved pin was an extreme one.
+	if (!data->clsEnableNetPinBoundaries || !phNet.clsBoundPins[LOWER][X]) {
+		updateNetBound(net);
+		return;
+	} // end if
+
+	Bounds &bound = phNet.clsBounds;
+	const DBUxy oldLength = bound.computeLength();
+	const DBUxy pos = getCachedPinPosition(pin);
+
+	// The pin is checked against both sides since it may be the extreme pin
+	// of either of them (e.g. two-pin nets).
+	bool rescan = false;
+	for (int dim = 0; dim < 2 && !rescan; dim++) {
+		// upper corner
+		if (pos[dim] >= bound[UPPER][dim]) {
+			bound[UPPER][dim] = pos[dim];
+			phNet.clsBoundPins[UPPER][dim] = pin;
+		} else if (phNet.clsBoundPins[UPPER][dim] == pin) {
+			rescan = true;
+		} // end else-if
+
+		// lower corner
+		if (pos[dim] <= bound[LOWER][dim]) {
+			bound[LOWER][dim] = pos[dim];
+			phNet.clsBoundPins[LOWER][dim] = pin;
+		} else if (phNet.clsBoundPins[LOWER][dim] == pin) {
+			rescan = true;
+		} // end else-if
+	} // end for
+
+	data->clsHPWL += bound.computeLength() - oldLength;
+
+	// An extreme pin moved inward, so the new extreme is unknown.
+	if (rescan)
+		updateNetBound(net);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void PhysicalDesign::updateNetBounds(Rsyn::Instance instance) {
+	for (Rsyn::Pin pin : instance.allPins()) {
+		updateNetBound(pin);
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline bool PhysicalDesign::isNetBoundIncremental() const {
+	return data->clsNetBoundsValid && data->clsEnableNetPinBoundaries;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline DBUxy PhysicalDesign::computeNetBound(Rsyn::Net net) {
 	// net has not pins. The boundaries are defined by default to 0.
 	if (net.getNumPins() == 0)
-		return;
+		return DBUxy(0, 0);
 
 	PhysicalNetData &phNet = data->clsPhysicalNets[net];
 	Bounds &bound = phNet.clsBounds;
-	data->clsHPWL -= bound.computeLength(); // remove old net wirelength
+	const DBUxy oldLength = bound.computeLength(); // old net wirelength
 	bound[UPPER].apply(-std::numeric_limits<DBU>::max());
 	bound[LOWER].apply(+std::numeric_limits<DBU>::max());
 	const bool updatePinBound = data->clsEnableNetPinBoundaries;
 	for (Rsyn::Pin pin : net.allPins()) {
-		DBUxy pos = getPinPosition(pin);
+		const DBUxy pos = getCachedPinPosition(pin);
 
 		// upper x corner pos
 		if (pos[X] >= bound[UPPER][X]) {
@@ -245,7 +324,7 @@ inline void PhysicalDesign::updateNetBound(Rsyn::Net net) {
 				phNet.clsBoundPins[LOWER][Y] = pin;
 		} // end if 
 	} // end for
-	data->clsHPWL += bound.computeLength(); // update hpwl 
+	return bound.computeLength() - oldLength; // hpwl variation
 } // end method 
 
 // -----------------------------------------------------------------------------
@@ -944,7 +1023,12 @@ inline void PhysicalDesign::updatePhysicalCell(Rsyn::Cell cell) {
 		data->clsTotalAreas[PHYSICAL_MOVABLE] += area;
 	} // end if-else 
 
+	updateRowOccupancy(phCell, phCell.clsBounds, -1);
 	phCell.clsBounds.updatePoints(pos, DBUxy(pos[X] + width, pos[Y] + height));
+	updateRowOccupancy(phCell, phCell.clsBounds, +1);
+	updatePinPositionCache(cell);
+	if (isNetBoundIncremental())
+		updateNetBounds(cell);
 } // end method 
 
 // -----------------------------------------------------------------------------
@@ -962,6 +1046,7 @@ inline void PhysicalDesign::removePhysicalCell(Rsyn::Cell cell) {
 	} else {
 		data->clsTotalAreas[PHYSICAL_MOVABLE] -= area;
 	} // end if-else 
+	updateRowOccupancy(physicalCell, physicalCell.clsBounds, -1);
 } // end method 
 
 // -----------------------------------------------------------------------------
@@ -1063,6 +1148,101 @@ inline DBU PhysicalDesign::getPinPosition(Rsyn::Pin pin, const Dimension dim) co
 
 // -----------------------------------------------------------------------------
 
+inline DBUxy PhysicalDesign::getCachedPinPosition(Rsyn::Pin pin) const {
+	if (!isPinPositionCached(pin))
+		return getPinPosition(pin);
+	const Index id = data->clsDesign.getId(pin);
+	return DBUxy(data->clsPinPositions[X][id], data->clsPinPositions[Y][id]);
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline DBU PhysicalDesign::getCachedPinPosition(Rsyn::Pin pin, const Dimension dim) const {
+	if (!isPinPositionCached(pin))
+		return getPinPosition(pin, dim);
+	return data->clsPinPositions[dim][data->clsDesign.getId(pin)];
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline Span<DBU> PhysicalDesign::allCachedPinPositions(const Dimension dim) const {
+	return Span<DBU>(data->clsPinPositions[dim]);
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline bool PhysicalDesign::isPinPositionCached(Rsyn::Pin pin) const {
+	if (!data->clsEnablePinPositionCache)
+		return false;
+	const Index id = data->clsDesign.getId(pin);
+	return id < data->clsPinPositionValid.size() && data->clsPinPositionValid[id];
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline Index PhysicalDesign::getPinPositionCacheIndex(Rsyn::Pin pin) const {
+	return data->clsDesign.getId(pin);
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline bool PhysicalDesign::isEnablePinPositionCache() const {
+	return data->clsEnablePinPositionCache;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void PhysicalDesign::updatePinPositionCache() {
+	if (!data->clsEnablePinPositionCache)
+		return;
+
+	const std::size_t size = data->clsDesign.getNumPins();
+	data->clsPinPositions[X].resize(std::max(data->clsPinPositions[X].size(), size));
+	data->clsPinPositions[Y].resize(std::max(data->clsPinPositions[Y].size(), size));
+	data->clsPinPositionValid.resize(data->clsPinPositions[X].size(), false);
+	for (Rsyn::Instance instance : data->clsModule.allInstances()) {
+		updatePinPositionCache(instance);
+	} // end for
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void PhysicalDesign::updatePinPositionCache(Rsyn::Instance instance) {
+	if (!data->clsEnablePinPositionCache)
+		return;
+
+	for (Rsyn::Pin pin : instance.allPins()) {
+		const Index id = data->clsDesign.getId(pin);
+		if (id >= data->clsPinPositions[X].size()) {
+			// Pins created after the cache was built.
+			const std::size_t size = std::max((std::size_t) id + 1, 
+					data->clsPinPositions[X].size() * 2);
+			data->clsPinPositions[X].resize(size);
+			data->clsPinPositions[Y].resize(size);
+			data->clsPinPositionValid.resize(size, false);
+		} // end if
+		const DBUxy pos = getPinPosition(pin);
+		data->clsPinPositions[X][id] = pos[X];
+		data->clsPinPositions[Y][id] = pos[Y];
+		data->clsPinPositionValid[id] = true;
+	} // end for
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void PhysicalDesign::invalidatePinPositionCache(Rsyn::Instance instance) {
+	if (!data->clsEnablePinPositionCache)
+		return;
+
+	for (Rsyn::Pin pin : instance.allPins()) {
+		const Index id = data->clsDesign.getId(pin);
+		if (id < data->clsPinPositionValid.size())
+			data->clsPinPositionValid[id] = false;
+	} // end for
+} // end method 
+
+// -----------------------------------------------------------------------------
+
 inline Rsyn::PhysicalNet PhysicalDesign::getPhysicalNet(Rsyn::Net net) const {
 	return PhysicalNet(&data->clsPhysicalNets[net]);
 } // end method 
@@ -1172,16 +1352,27 @@ inline void PhysicalDesign::placeCell(Rsyn::PhysicalCell physicalCell, const DBU
 	const double preivousX = physicalCell.getCoordinate(LOWER, X);
 	const double preivousY = physicalCell.getCoordinate(LOWER, Y);
 
-	physicalCell->clsBounds.moveTo(x, y);
+	if (data->clsEnableRowOccupancy) {
+		const PhysicalInstanceData &phCell = data->clsPhysicalInstances[physicalCell.getInstance()];
+		updateRowOccupancy(phCell, phCell.clsBounds, -1);
+		physicalCell->clsBounds.moveTo(x, y);
+		updateRowOccupancy(phCell, phCell.clsBounds, +1);
+	} else {
+		physicalCell->clsBounds.moveTo(x, y);
+	} // end if-else
+	updatePinPositionCache(physicalCell.getInstance());
 
 	// Only notify observers if the instance actually moved. We noted that many
 	// times the cell end up in the exactly same position.
-	if (!dontNotifyObservers) {
-		if (preivousX != physicalCell.getCoordinate(LOWER, X) || preivousY != physicalCell.getCoordinate(LOWER, Y)) {
-			// Notify observers...
-			for (auto &f : data->callbackPostInstanceMoved)
-				std::get<1>(f) (physicalCell);
-		} // end if
+	const bool moved = preivousX != physicalCell.getCoordinate(LOWER, X) ||
+			preivousY != physicalCell.getCoordinate(LOWER, Y);
+	if (moved && isNetBoundIncremental())
+		updateNetBounds(physicalCell.getInstance());
+
+	if (!dontNotifyObservers && moved) {
+		// Notify observers...
+		for (auto &f : data->callbackPostInstanceMoved)
+			std::get<1>(f) (physicalCell);
 	} // end if	
 } // end method
 
@@ -1224,6 +1415,179 @@ inline void PhysicalDesign::notifyObservers(Rsyn::PhysicalInstance instance, con
 } // end method
 // -----------------------------------------------------------------------------
 
+inline bool PhysicalDesign::isEnableRowOccupancy() const {
+	return data->clsEnableRowOccupancy;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void PhysicalDesign::updateRowOccupancy() {
+	if (!data->clsEnableRowOccupancy)
+		return;
+
+	data->clsRowOccupancy.clear();
+	data->clsRowOccupancy.resize(data->clsPhysicalRows.size());
+	data->clsRowsSortedByY.clear();
+	data->clsMaxRowHeight = 0;
+	for (Rsyn::PhysicalRow phRow : allPhysicalRows()) {
+		data->clsRowOccupancy[getId(phRow)].init(phRow.getNumSites(X));
+		data->clsRowsSortedByY.push_back(getId(phRow));
+		data->clsMaxRowHeight = std::max(data->clsMaxRowHeight, phRow.getHeight());
+	} // end for
+
+	std::sort(data->clsRowsSortedByY.begin(), data->clsRowsSortedByY.end(),
+		[&](const PhysicalIndex row0, const PhysicalIndex row1) {
+			return data->clsPhysicalRows.get(row0)->value.clsBounds[LOWER][Y] <
+				data->clsPhysicalRows.get(row1)->value.clsBounds[LOWER][Y];
+	});
+
+	for (Rsyn::Instance instance : data->clsModule.allInstances()) {
+		if (instance.getType() != Rsyn::CELL)
+			continue;
+		const PhysicalInstanceData &physicalCell = data->clsPhysicalInstances[instance];
+		updateRowOccupancy(physicalCell, physicalCell.clsBounds, +1);
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void PhysicalDesign::updateRowOccupancy(const PhysicalInstanceData &physicalCell, const Bounds &bounds, const int delta) {
+	if (!data->clsEnableRowOccupancy || !physicalCell.clsPlaced)
+		return;
+
+	// Skip the rows ending before the cell bottom. Rows are sorted by their
+	// lower ordinate, so use the tallest row to find the first candidate.
+	const std::vector<PhysicalIndex> &rows = data->clsRowsSortedByY;
+	const DBU yMin = bounds[LOWER][Y] - data->clsMaxRowHeight;
+	auto it = std::upper_bound(rows.begin(), rows.end(), yMin,
+		[&](const DBU y, const PhysicalIndex row) {
+			return y < data->clsPhysicalRows.get(row)->value.clsBounds[LOWER][Y];
+	});
+
+	for (; it != rows.end(); it++) {
+		const PhysicalRowData &phRow = data->clsPhysicalRows.get(*it)->value;
+		if (phRow.clsBounds[LOWER][Y] >= bounds[UPPER][Y])
+			break;
+		if (phRow.clsBounds[UPPER][Y] <= bounds[LOWER][Y] ||
+				phRow.clsBounds[UPPER][X] <= bounds[LOWER][X] ||
+				phRow.clsBounds[LOWER][X] >= bounds[UPPER][X])
+			continue;
+
+		// Any site partially covered by the cell is marked as occupied.
+		const DBU siteWidth = phRow.clsStep[X];
+		const DBU x0 = bounds[LOWER][X] - phRow.clsBounds[LOWER][X];
+		const DBU x1 = bounds[UPPER][X] - phRow.clsBounds[LOWER][X];
+		const int site0 = (int) std::max((DBU) 0, x0 / siteWidth);
+		const int site1 = (int) roundedUpIntegralDivision(x1, siteWidth);
+
+		RowOccupancy &occupancy = data->clsRowOccupancy[*it];
+		if (delta > 0)
+			occupancy.occupy(site0, site1 - site0);
+		else
+			occupancy.release(site0, site1 - site0);
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline const RowOccupancy &PhysicalDesign::getRowOccupancy(Rsyn::PhysicalRow phRow) const {
+	return data->clsRowOccupancy[getId(phRow)];
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline Rsyn::PhysicalRow PhysicalDesign::getPhysicalRowAt(const DBUxy pos) const {
+	const std::vector<PhysicalIndex> &rows = data->clsRowsSortedByY;
+	auto it = std::upper_bound(rows.begin(), rows.end(), pos[Y] - data->clsMaxRowHeight,
+		[&](const DBU y, const PhysicalIndex row) {
+			return y < data->clsPhysicalRows.get(row)->value.clsBounds[LOWER][Y];
+	});
+
+	for (; it != rows.end(); it++) {
+		PhysicalRowData &phRow = data->clsPhysicalRows.get(*it)->value;
+		if (phRow.clsBounds[LOWER][Y] > pos[Y])
+			break;
+		if (pos[Y] < phRow.clsBounds[UPPER][Y] &&
+				pos[X] >= phRow.clsBounds[LOWER][X] && pos[X] < phRow.clsBounds[UPPER][X])
+			return Rsyn::PhysicalRow(&phRow);
+	} // end for
+	return nullptr;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline bool PhysicalDesign::isRowSpaceFree(Rsyn::PhysicalRow phRow, const DBU x, const DBU width) const {
+	const DBU siteWidth = phRow.getSiteWidth();
+	const DBU x0 = x - phRow.getCoordinate(LOWER, X);
+	if (x0 < 0)
+		return false;
+	const int site0 = (int) (x0 / siteWidth);
+	const int site1 = (int) roundedUpIntegralDivision(x0 + width, siteWidth);
+	return getRowOccupancy(phRow).isFree(site0, site1 - site0);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline bool PhysicalDesign::findNearestRowSpace(Rsyn::PhysicalRow phRow, const DBU x, const DBU width, DBU &pos) const {
+	const DBU siteWidth = phRow.getSiteWidth();
+	const DBU lower = phRow.getCoordinate(LOWER, X);
+	const int site = (int) std::round((x - lower) / (double) siteWidth);
+	const int numSites = (int) roundedUpIntegralDivision(width, siteWidth);
+	const int freeSite = getRowOccupancy(phRow).findNearestFreeSites(site, numSites);
+	if (freeSite < 0)
+		return false;
+	pos = lower + freeSite * siteWidth;
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline DBU PhysicalDesign::getRowFreeSpace(Rsyn::PhysicalRow phRow, const DBU x, const Boundary side) const {
+	const DBU siteWidth = phRow.getSiteWidth();
+	const DBU x0 = x - phRow.getCoordinate(LOWER, X);
+	const RowOccupancy &occupancy = getRowOccupancy(phRow);
+	if (side == LOWER) {
+		const int site = (int) (x0 / siteWidth);
+		return occupancy.countFreeSitesLeft(site) * siteWidth;
+	} else {
+		const int site = (int) roundedUpIntegralDivision(x0, siteWidth);
+		return occupancy.countFreeSitesRight(site) * siteWidth;
+	} // end if-else
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline void PhysicalDesign::reportMemoryUsage(MemoryReport &report) {
+	report.add("library",
+			data->clsPhysicalLibraryPins->getMemoryUsage() +
+			data->clsPhysicalLibraryCells->getMemoryUsage());
+	report.add("instances", data->clsPhysicalInstances->getMemoryUsage());
+	if (data->clsEnablePhysicalPins)
+		report.add("pins", data->clsPhysicalPins->getMemoryUsage());
+	report.add("nets", data->clsPhysicalNets->getMemoryUsage());
+	report.add("floorplan",
+			data->clsPhysicalRows.getMemoryUsage() +
+			data->clsPhysicalLayers.getMemoryUsage() +
+			data->clsPhysicalSpacing.getMemoryUsage() +
+			MemoryReport::bytes(data->clsPhysicalRegions) +
+			MemoryReport::bytes(data->clsPhysicalGroups) +
+			MemoryReport::bytes(data->clsPhysicalSites) +
+			MemoryReport::bytes(data->clsPhysicalVias));
+	report.add("pin positions",
+			MemoryReport::bytes(data->clsPinPositions[X]) +
+			MemoryReport::bytes(data->clsPinPositions[Y]) +
+			MemoryReport::bytes(data->clsPinPositionValid));
+
+	std::size_t rowOccupancy =
+			MemoryReport::bytes(data->clsRowOccupancy) +
+			MemoryReport::bytes(data->clsRowsSortedByY);
+	for (const RowOccupancy &occupancy : data->clsRowOccupancy)
+		rowOccupancy += occupancy.getMemoryUsage();
+	report.add("row occupancy", rowOccupancy);
+} // end method
+
+// -----------------------------------------------------------------------------
+
 inline PhysicalDesign::PostInstanceMovedCallbackHandler
 PhysicalDesign::addPostInstanceMovedCallback(const int priority, PostInstanceMovedCallback f) {
 
@@ -1243,4 +1607,11 @@ PhysicalDesign::addPostInstanceMovedCallback(const int priority, PostInstanceMov
 	return handler;
 } // end method
 
+// -----------------------------------------------------------------------------
+
+inline void
+PhysicalDesign::deletePostInstanceMovedCallback(PostInstanceMovedCallbackHandler &handler) {
+	data->callbackPostInstanceMoved.erase(handler);
+} // end method
+
 } // end namespace 
@@ -97,4 +97,7 @@ using SandboxReferenceListCollection = GenericReferenceListCollection<Reference,
 #include "rsyn/sandbox/obj/impl/Port.h"
 #include "rsyn/sandbox/obj/impl/Sandbox.h"
 
+// Pool
+#include "rsyn/sandbox/SandboxPool.h"
+
 #endif
\ No newline at end of file
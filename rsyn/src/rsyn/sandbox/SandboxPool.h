@@ -0,0 +1,121 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_SANDBOX_POOL_H
+#define RSYN_SANDBOX_POOL_H
+
+#include <mutex>
+#include <vector>
+
+namespace Rsyn {
+
+////////////////////////////////////////////////////////////////////////////////
+// Keeps released sandboxes so that their storage (lists, name tables and
+// mappings) is reused by the next sandboxes instead of being allocated again.
+// This is useful for optimizations that create one sandbox per candidate
+// (e.g. one per cell).
+//
+// Example
+// -------
+//
+//    Rsyn::SandboxPool pool;
+//    for (Rsyn::Instance instance : module.allInstances()) {
+//        Rsyn::Sandbox sandbox = pool.acquire(instance.asCell());
+//        sandboxTimer.reset(sandbox);
+//        ...
+//        pool.release(sandbox);
+//    } // end for
+//
+// A released sandbox must not be used anymore. Sandbox attributes created on a
+// released sandbox need to be loaded again (e.g. SandboxAttribute::rebind())
+// once the sandbox is acquired since objects ids are reused.
+//
+// Acquire and release are thread safe. All sandboxes are deleted when the pool
+// is destroyed.
+////////////////////////////////////////////////////////////////////////////////
+
+class SandboxPool {
+public:
+
+	SandboxPool() {}
+	SandboxPool(const SandboxPool &) = delete;
+	SandboxPool &operator=(const SandboxPool &) = delete;
+
+	~SandboxPool() {
+		for (SandboxData *data : clsAllSandboxes) {
+			delete data;
+		} // end for
+	} // end destructor
+
+	//! @brief Returns an empty sandbox reusing a released one if available.
+	Sandbox acquire(Rsyn::Module module, const std::string &name = "") {
+		SandboxData *data = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(clsMutex);
+			if (!clsFreeSandboxes.empty()) {
+				data = clsFreeSandboxes.back();
+				clsFreeSandboxes.pop_back();
+			} else {
+				data = new SandboxData;
+				clsAllSandboxes.push_back(data);
+			} // end else
+		} // end block
+
+		data->module = module;
+		data->name = name;
+		return Sandbox(data);
+	} // end method
+
+	//! @brief Returns a sandbox holding the neighborhood of the seed cell. Same
+	//!        as Sandbox::create(seed).
+	Sandbox acquire(Rsyn::Cell seed) {
+		Sandbox sandbox = acquire(seed.getParent(), seed.getName());
+		sandbox.populate(seed);
+		return sandbox;
+	} // end method
+
+	//! @brief Returns a sandbox to the pool. Its storage is kept for reuse.
+	void release(Sandbox sandbox) {
+		if (!sandbox)
+			return;
+
+		sandbox.data->clear();
+
+		std::lock_guard<std::mutex> lock(clsMutex);
+		clsFreeSandboxes.push_back(sandbox.data);
+	} // end method
+
+	//! @brief Returns the number of sandboxes allocated by this pool.
+	int getNumSandboxes() const {
+		std::lock_guard<std::mutex> lock(clsMutex);
+		return (int) clsAllSandboxes.size();
+	} // end method
+
+	//! @brief Returns the number of released sandboxes waiting to be reused.
+	int getNumFreeSandboxes() const {
+		std::lock_guard<std::mutex> lock(clsMutex);
+		return (int) clsFreeSandboxes.size();
+	} // end method
+
+private:
+
+	mutable std::mutex clsMutex;
+	std::vector<SandboxData *> clsAllSandboxes;
+	std::vector<SandboxData *> clsFreeSandboxes;
+}; // end class
+
+} // end namespace
+
+#endif /* RSYN_SANDBOX_POOL_H */
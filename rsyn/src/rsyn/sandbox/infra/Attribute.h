@@ -63,6 +63,12 @@ public:
 	SandboxAttribute(SandboxAttributeInitializerWithDefaultValue<DefaultValueType> initializer) { operator=(initializer); }
 	template<typename DefaultValueType>
 	void operator=(SandboxAttributeInitializerWithDefaultValue<DefaultValueType> initializer);
+
+	//! @brief Same as operator=, but reuses the storage of the current 
+	//!        attribute, if any. All values are reset.
+	void rebind(SandboxAttributeInitializer initializer);
+	template<typename DefaultValueType>
+	void rebind(SandboxAttributeInitializerWithDefaultValue<DefaultValueType> initializer);
 	
 	RsynObjectExtension &operator[](RsynObject obj);
 	const RsynObjectExtension &operator[](RsynObject obj) const;
@@ -79,7 +85,7 @@ private:
 	List<_Object, RSYN_SANDBOX_LIST_CHUNCK_SIZE> *clsListPtr;
 	_ObjectExtension clsDefaultValue;
 	
-	typename List<_Object, RSYN_SANDBOX_LIST_CHUNCK_SIZE>::CreateElementCallbackHandler clsHandlerOnCreate;
+	typename List<_Object, RSYN_SANDBOX_LIST_CHUNCK_SIZE>::GrowthCallbackHandler clsHandlerOnGrowth;
 	typename List<_Object, RSYN_SANDBOX_LIST_CHUNCK_SIZE>::DestructorCallbackHandler clsListDestructorCallbackHandler;
 	
 	std::deque<_ObjectExtension> clsData;
@@ -93,8 +99,9 @@ private:
 protected:
 	
 	void setupCallbacks() {
-		clsHandlerOnCreate = clsListPtr->addCreateCallback([&](const int index) {
-			accommodate(clsListPtr->largestId());
+		// Storage only needs to follow the list when it starts a new chunk.
+		clsHandlerOnGrowth = clsListPtr->addGrowthCallback([&](const int capacity) {
+			accommodate(capacity - 1);
 		}); // end method
 		
 		clsListDestructorCallbackHandler = clsListPtr->addDestructorEventCallback([&]() {
@@ -104,23 +111,43 @@ protected:
 	} // end method
 	
 	void load(Sandbox sandbox, List<_Object, RSYN_SANDBOX_LIST_CHUNCK_SIZE> &list, _ObjectExtension defaultValue = _ObjectExtension()) {
+		// The attribute may be loaded again (e.g. for a pooled sandbox). In 
+		// this case the storage is kept, but all values are reset.
+		detach();
+
 		clsSandbox = sandbox;
 		clsListPtr = &list;
 		clsDefaultValue = defaultValue;
-		accommodate(clsListPtr->largestId());
+
+		const std::size_t size = std::max(clsListPtr->largestId(), clsListPtr->getUsedCapacity() - 1) + 1;
+		if (clsData.size() > size) {
+			clsData.resize(size);
+		} // end if
+		std::fill(clsData.begin(), clsData.end(), clsDefaultValue);
+		accommodate(size - 1);
 		setupCallbacks();
 	} // end method		
+
+	void detach() {
+		if (clsListPtr) {
+			clsListPtr->deleteGrowthCallback(clsHandlerOnGrowth);
+			clsListPtr->deleteDestructorCallback(clsListDestructorCallbackHandler);
+			clsListPtr = nullptr;
+		} // end if
+	} // end method
 	
 public:
 	
 	SandboxAttributeBase() : clsSandbox(nullptr), clsListPtr(nullptr) {
 	} // end constructor
 	
-	SandboxAttributeBase(const SandboxAttributeBase<_Object, _ObjectReference, _ObjectExtension> &other) {
+	SandboxAttributeBase(const SandboxAttributeBase<_Object, _ObjectReference, _ObjectExtension> &other) :
+			clsSandbox(nullptr), clsListPtr(nullptr) {
 		operator=(other);
 	} // end constructor
 	
-	SandboxAttributeBase(Sandbox sandbox, List<_Object, RSYN_SANDBOX_LIST_CHUNCK_SIZE> &list) {
+	SandboxAttributeBase(Sandbox sandbox, List<_Object, RSYN_SANDBOX_LIST_CHUNCK_SIZE> &list) :
+			clsSandbox(nullptr), clsListPtr(nullptr) {
 		load(sandbox, list);
 	} // end constructor
 
@@ -147,11 +174,7 @@ public:
 			clsSandbox = nullptr;
 		} // end if
 		
-		if (clsListPtr) {
-			clsListPtr->deleteCreateCallback(clsHandlerOnCreate);
-			clsListPtr->deleteDestructorCallback(clsListDestructorCallbackHandler);
-			clsListPtr = nullptr;
-		} // end if
+		detach();
 
 		clsData.clear();
 		clsData.shrink_to_fit();
@@ -286,6 +309,27 @@ void SandboxAttribute<RsynObject, RsynObjectExtension>::operator=(SandboxAttribu
 	this->reset(new SandboxAttributeImplementation<RsynObject, RsynObjectExtension>(initializer));
 } // end method
 
+template<typename RsynObject, typename RsynObjectExtension>
+inline
+void SandboxAttribute<RsynObject, RsynObjectExtension>::rebind(SandboxAttributeInitializer initializer) {
+	if (*this) {
+		(*this)->operator=(initializer);
+	} else {
+		operator=(initializer);
+	} // end else
+} // end method
+
+template<typename RsynObject, typename RsynObjectExtension>
+template<typename DefaultValueType>
+inline
+void SandboxAttribute<RsynObject, RsynObjectExtension>::rebind(SandboxAttributeInitializerWithDefaultValue<DefaultValueType> initializer) {
+	if (*this) {
+		(*this)->operator=(initializer);
+	} else {
+		operator=(initializer);
+	} // end else
+} // end method
+
 template<typename RsynObject, typename RsynObjectExtension>
 inline
 RsynObjectExtension &SandboxAttribute<RsynObject, RsynObjectExtension>::operator[](RsynObject obj) {
@@ -32,12 +32,8 @@ struct SandboxNetData : SandboxObjectData {
 
 	// Cache number of pins per direction.
 	std::array<int, NUM_PIN_DIRECTIONS> numPinsOfType;
-	
-	// Ussed in some netlist traversals.
-	int sign;
 
 	SandboxNetData() :
-		sign(-1),
 		driver(nullptr), 
 		numPinsOfType({0, 0, 0, 0}) {
 	} // end constructor	
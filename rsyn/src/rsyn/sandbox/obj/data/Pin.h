@@ -25,8 +25,6 @@ struct SandboxPinData : ObjectData {
 	                          // pins.
 	// <#
 	
-	int sign;
-	
 	SandboxInstance instance;
 	SandboxNet net;
 	std::vector<SandboxArc> arcs[NUM_TRAVERSE_TYPES];
@@ -37,7 +35,6 @@ struct SandboxPinData : ObjectData {
 		direction(UNKNOWN_DIRECTION),
 		type(UNKNOWN_INSTANCE_TYPE),
 		boundary(false),
-		sign(0),
 		instance(nullptr), 
 		net(nullptr), 
 		
@@ -33,9 +33,6 @@ struct SandboxData {
 	bool dirty;
 	bool initialized;
 
-	// Used for some netlist traversing (e.g. update topological ordering)...
-	int sign;
-	
 	std::unordered_map<std::string, SandboxInstance> instanceNameMapping;
 	std::unordered_map<std::string, SandboxNet> netMapping;
 	std::map<Instance, SandboxInstance> mappingInstance;
@@ -48,10 +45,40 @@ struct SandboxData {
 		initialized(false),
 		dirty(false),
 		anonymousInstanceId(0),
-		anonymousNetId(0),
-		sign(0) {
+		anonymousNetId(0) {
 	} // end constructor
 
+	//! @brief Removes all objects keeping the allocated storage so that this
+	//!        data can be reused by another sandbox (see SandboxPool).
+	void clear() {
+		module = nullptr;
+		name.clear();
+
+		pins.clear();
+		arcs.clear();
+		nets.clear();
+		instances.clear();
+
+		instanceNames.clear();
+		netNames.clear();
+
+		anonymousInstanceId = 0;
+		anonymousNetId = 0;
+
+		dirty = false;
+		initialized = false;
+
+		instanceNameMapping.clear();
+		netMapping.clear();
+		mappingInstance.clear();
+		mappingNet.clear();
+
+		ports.clear();
+		for (int i = 0; i < Rsyn::NUM_PIN_DIRECTIONS; i++) {
+			portsByDirection[i].clear();
+		} // end for
+	} // end method
+
 }; // end struct
 
 } // end namespace
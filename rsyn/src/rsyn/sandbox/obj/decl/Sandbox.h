@@ -18,6 +18,7 @@ namespace Rsyn {
 class Sandbox : public Proxy<SandboxData> {
 friend class SandboxInstance;
 friend class SandboxNet;
+friend class SandboxPool;
 
 template<typename _Object, typename _ObjectReference, typename _ObjectExtension> friend class SandboxAttributeBase;
 template<typename _Object, typename _ObjectExtension> friend class SandboxAttributeImplementation;
@@ -30,11 +31,12 @@ private:
 	std::string generateUniqueInstanceName(const std::string &prefix);
 	std::string generateUniqueNetName(const std::string &prefix);
 
-	int generateNextSign();
-	int getSign() const;	
-
 	void updateTopologicalIndex(SandboxPin pin);
 
+	//! @brief Creates the neighborhood of the seed cell in this (empty) 
+	//!        sandbox.
+	void populate(Rsyn::Cell seed);
+
 	////////////////////////////////////////////////////////////////////////////
 	// Unique Identifiers for Rsyn Objects
 	//--------------------------------------------------------------------------
@@ -56,6 +58,19 @@ private:
 
 public:
 
+	//! @brief Marks an object as visited in a traversal. Returns true if the
+	//!        object was not visited before.
+	template<typename Object>
+	bool visit(VisitationMarker &marker, Object object) const {
+		return marker.visit(getId(object));
+	} // end method
+
+	//! @brief Returns true if an object was visited in a traversal.
+	template<typename Object>
+	bool isVisited(const VisitationMarker &marker, Object object) const {
+		return marker.isVisited(getId(object));
+	} // end method
+
 	Sandbox() {}
 	Sandbox(std::nullptr_t) {}
 
@@ -88,6 +103,18 @@ public:
 	void remap(SandboxCell cell, LibraryCell newLibraryCell);
 	void remap(SandboxCell cell, const std::string &newLibraryCellName);
 
+	//! @brief Replays the changes made in this sandbox (remaps, new cells and
+	//!        nets and pin connections) onto the design as a single design
+	//!        transaction. Nets attached to virtual ports stand for the design
+	//!        nets of the attached pins. After the commit, new sandbox objects
+	//!        are related to the design objects created for them.
+	//! @note  If the commit fails (e.g. a remap is not compatible), pins are
+	//!        reconnected and cells remapped back before the exception is
+	//!        rethrown. As the design cannot remove objects, cells and nets
+	//!        already created are left unconnected and are not related to the
+	//!        sandbox.
+	void commit();
+
 	const std::string &getName() const;
 
 	SandboxPort getPortByIndex(const int index);
@@ -81,7 +81,7 @@ inline
 Pin
 SandboxPin::getRelated() const {
 	Instance relatedInstance = getInstance().getRelated();
-	return relatedInstance? relatedInstance.getPinByIndex(data->id) : nullptr;
+	return relatedInstance? relatedInstance.getPinByIndex(data->index) : nullptr;
 } // end method
 
 // -----------------------------------------------------------------------------
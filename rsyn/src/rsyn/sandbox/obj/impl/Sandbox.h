@@ -30,9 +30,15 @@ Sandbox::create(Rsyn::Module module, const std::string &name) {
 inline
 void
 Sandbox::create(Rsyn::Cell seed) {
-	Rsyn::Module module = seed.getParent();
-	create(module, seed.getName());
+	create(seed.getParent(), seed.getName());
+	populate(seed);
+} // end method
+
+// -----------------------------------------------------------------------------
 
+inline
+void
+Sandbox::populate(Rsyn::Cell seed) {
 	// Create instances and nets in the sandbox.
 	for (Rsyn::Pin pin : seed.allPins()) {
 		Rsyn::Net net = pin.getNet();
@@ -55,9 +61,10 @@ Sandbox::create(Rsyn::Cell seed) {
 		for (Rsyn::SandboxPin pin : instance.allPins()) {
 			Rsyn::Pin relatedPin = pin.getRelated();
 			Rsyn::Net relatedNet = relatedPin.getNet();
-			if (!relatedNet)
+			Rsyn::SandboxNet net = relatedNet? getRelated(relatedNet) : nullptr;
+			if (!net)
 				continue;
-			connectPin(pin, getRelated(relatedNet));
+			connectPin(pin, net);
 		} // end for
 	} // end for
 
@@ -141,22 +148,6 @@ Sandbox::generateUniqueNetName(const std::string &prefix) {
 
 // -----------------------------------------------------------------------------
 
-inline
-int
-Sandbox::generateNextSign() {
-	return ++data->sign; /*must be pre-increment*/
-} // end method
-
-// -----------------------------------------------------------------------------
-
-inline
-int
-Sandbox::getSign() const {
-	return data->sign;
-} // end method
-
-// -----------------------------------------------------------------------------
-
 inline
 SandboxInstance
 Sandbox::findInstanceByName(const std::string &name) const {
@@ -302,6 +293,7 @@ Sandbox::createInstance(const Rsyn::Instance instance) {
 
 	sandboxInstance->related = instance;
 	data->mappingInstance[instance] = sandboxInstance;
+	return sandboxInstance;
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -322,6 +314,7 @@ Sandbox::createNet(const Rsyn::Net net) {
 	sandboxNet = createNet(net.getName());
 	sandboxNet->related = net;
 	data->mappingNet[net] = sandboxNet;
+	return sandboxNet;
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -693,6 +686,147 @@ Sandbox::remap(SandboxCell cell, const std::string &newLibraryCellName) {
 
 // -----------------------------------------------------------------------------
 
+inline
+void
+Sandbox::commit() {
+	Rsyn::Design design = getDesign();
+	Rsyn::Module module = getModule();
+
+	// Design nets represented by sandbox nets connected to virtual ports. They
+	// need to be computed before any connection is changed in the design. The
+	// design net is null if the attached pin is not connected in the design.
+	std::map<SandboxNet, Net> boundaryNets;
+	for (Rsyn::SandboxPort port : allPorts()) {
+		Rsyn::SandboxNet net = port.getInnerPin().getNet();
+		if (!net || !port.isVirtual() || getRelated(net))
+			continue;
+
+		Rsyn::Pin relatedPin = port.getAttachedPin().getRelated();
+		Rsyn::Net relatedNet = relatedPin? relatedPin.getNet() : nullptr;
+		Rsyn::Net &boundaryNet = boundaryNets[net];
+		if (!boundaryNet) {
+			boundaryNet = relatedNet;
+		} // end if
+	} // end for
+
+	// Changes applied to the design so far, undone if the commit fails.
+	std::vector<std::pair<Rsyn::Cell, Rsyn::LibraryCell>> remappedCells;
+	std::vector<std::pair<Rsyn::Pin, Rsyn::Net>> reconnectedPins;
+	std::vector<Rsyn::SandboxInstance> createdInstances;
+	std::vector<Rsyn::SandboxNet> createdNets;
+
+	design.beginTransaction();
+	try {
+		// Remap and create cells.
+		for (Rsyn::SandboxInstance instance : allInstances()) {
+			if (instance.getType() != Rsyn::CELL)
+				continue;
+
+			Rsyn::SandboxCell cell = instance.asCell();
+			Rsyn::Cell relatedCell = cell.getRelated();
+			if (relatedCell) {
+				const Rsyn::LibraryCell oldLibraryCell = relatedCell.getLibraryCell();
+				if (oldLibraryCell != cell.getLibraryCell()) {
+					relatedCell.remap(cell.getLibraryCell());
+					remappedCells.push_back(std::make_pair(relatedCell, oldLibraryCell));
+				} // end if
+			} else {
+				const std::string &name = cell.getName();
+				relatedCell = module.createCell(cell.getLibraryCell(),
+						design.findInstanceByName(name)? "" : name);
+				instance->related = relatedCell;
+				data->mappingInstance[relatedCell] = instance;
+				createdInstances.push_back(instance);
+			} // end else
+		} // end for
+
+		// Create nets. A net attached to unconnected pins only is created if it
+		// connects at least two pins besides the virtual ports.
+		for (Rsyn::SandboxNet net : allNets()) {
+			if (getRelated(net))
+				continue;
+
+			auto it = boundaryNets.find(net);
+			if (it != boundaryNets.end()) {
+				if (it->second)
+					continue;
+
+				int numPins = 0;
+				for (Rsyn::SandboxPin pin : net.allPins()) {
+					if (pin.getRelated() || !pin.getInstance().isPort())
+						numPins++;
+				} // end for
+				if (numPins < 2)
+					continue;
+			} // end if
+
+			const std::string &name = net.getName();
+			Rsyn::Net relatedNet = module.createNet(
+					design.findNetByName(name)? "" : name);
+			net->related = relatedNet;
+			data->mappingNet[relatedNet] = net;
+			createdNets.push_back(net);
+		} // end for
+
+		// Connect pins.
+		for (Rsyn::SandboxPin pin : allPins()) {
+			Rsyn::Pin relatedPin = pin.getRelated();
+			if (!relatedPin)
+				continue; // e.g. inner pin of a virtual port
+
+			Rsyn::SandboxNet net = pin.getNet();
+			Rsyn::Net relatedNet = net? getRelated(net) : nullptr;
+			if (net && !relatedNet) {
+				auto it = boundaryNets.find(net);
+				if (it != boundaryNets.end())
+					relatedNet = it->second;
+			} // end if
+
+			if (relatedPin.getNet() != relatedNet) {
+				reconnectedPins.push_back(std::make_pair(relatedPin, relatedPin.getNet()));
+				if (relatedPin.isConnected())
+					relatedPin.disconnect();
+				if (relatedNet)
+					relatedPin.connect(relatedNet);
+			} // end if
+		} // end for
+	} catch (...) {
+		// Undo in reverse order so the design is left as before the commit,
+		// except for the created cells and nets, which cannot be removed.
+		for (auto it = reconnectedPins.rbegin(); it != reconnectedPins.rend(); ++it) {
+			Rsyn::Pin pin = it->first;
+			if (pin.getNet() == it->second)
+				continue;
+			if (pin.isConnected())
+				pin.disconnect();
+			if (it->second)
+				pin.connect(it->second);
+		} // end for
+
+		for (auto it = remappedCells.rbegin(); it != remappedCells.rend(); ++it) {
+			it->first.remap(it->second);
+		} // end for
+
+		for (Rsyn::SandboxInstance instance : createdInstances) {
+			data->mappingInstance.erase(instance->related);
+			instance->related = nullptr;
+		} // end for
+
+		for (Rsyn::SandboxNet net : createdNets) {
+			data->mappingNet.erase(net->related);
+			net->related = nullptr;
+		} // end for
+
+		design.commit();
+		throw;
+	} // end catch
+	design.commit();
+
+	data->dirty = false;
+} // end method
+
+// -----------------------------------------------------------------------------
+
 inline
 int
 Sandbox::getNumInstances() const {
@@ -760,8 +894,8 @@ Sandbox::updateTopologicalIndex(SandboxPin pin) {
 	static_assert(TOPOLOGICAL_SORTING_SMALL_GAP <=
 			TOPOLOGICAL_SORTING_LARGE_GAP, "small gap > large gap");
 
-	// Gets the signature for this update search.
-	const int sign = generateNextSign();
+	// Tracks the pins visited by this update search.
+	VisitationMarker visited;
 
 	// Gets the lower bound index.
 	TopologicalIndex lower =
@@ -834,8 +968,7 @@ Sandbox::updateTopologicalIndex(SandboxPin pin) {
 				} // end if
 
 				TopologicalIndex order;
-				if (current->sign != sign) {
-					current->sign = sign;
+				if (visited.visit(current->id)) {
 					order = (TopologicalIndex) std::floor(
 							(float((current->order - upper)*w1)/float(w0)) + left1);
 					if (order <= generatorOrder) {
@@ -983,23 +1116,22 @@ Sandbox::getFanoutConeNetsInBreadthFirstOrder(Rsyn::SandboxPin seed) {
 		open.push(net);
 
 	// Breadth-first search.
-	const int sign = generateNextSign();
+	VisitationMarker visited;
 
 	while (!open.empty()) {
 		Rsyn::SandboxNet currentNet = open.front();
 		open.pop();
 
-		if (currentNet->sign == sign)
+		if (!visited.visit(currentNet->id))
 			continue;
 
-		currentNet->sign = sign;
 		result.push_back(currentNet);
 
 		// Add neighbors.
 		for (Rsyn::SandboxPin sink : currentNet.allPins(SINK)) {
 			for (Rsyn::SandboxArc arc : sink.allOutgoingArcs()) {
 				Rsyn::SandboxNet net = arc.getToNet();
-				if (net && net->sign != sign)
+				if (net && !visited.isVisited(net->id))
 					open.push(net);
 			} // end for
 		} // end for
@@ -1023,23 +1155,22 @@ Sandbox::getFaninConeNetsInBreadthFirstOrder(Rsyn::SandboxPin seed) {
 		open.push(net);
 
 	// Breadth-first search.
-	const int sign = generateNextSign();
+	VisitationMarker visited;
 
 	while (!open.empty()) {
 		Rsyn::SandboxNet currentNet = open.front();
 		open.pop();
 
-		if (currentNet->sign == sign)
+		if (!visited.visit(currentNet->id))
 			continue;
 
-		currentNet->sign = sign;
 		result.push_back(currentNet);
 
 		// Add neighbors.
 		for (Rsyn::SandboxPin driver : currentNet.allPins(DRIVER)) {
 			for (Rsyn::SandboxArc arc : driver.allIncomingArcs()) {
 				Rsyn::SandboxNet net = arc.getFromNet();
-				if (net && net->sign != sign)
+				if (net && !visited.isVisited(net->id))
 					open.push(net);
 			} // end for
 		} // end for
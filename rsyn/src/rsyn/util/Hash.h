@@ -0,0 +1,61 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_HASH_H
+#define RSYN_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/utility/string_ref.hpp>
+
+namespace Rsyn {
+
+//! @brief 64-bit FNV-1a hashing used by hash tables (e.g. NameTable) and
+//!        digests (e.g. placement digests). Fast, but not meant for
+//!        cryptographic purposes (see MD5.h).
+class Hash {
+public:
+
+	static constexpr std::uint64_t FNV1A_OFFSET_BASIS = 14695981039346656037ull;
+	static constexpr std::uint64_t FNV1A_PRIME = 1099511628211ull;
+
+	//! @brief Hashes size bytes. A previous hash can be passed as seed to
+	//!        hash several fields in sequence.
+	static std::uint64_t fnv1a(const void *data, const std::size_t size,
+			std::uint64_t seed = FNV1A_OFFSET_BASIS) {
+		const unsigned char *bytes = static_cast<const unsigned char *>(data);
+		for (std::size_t i = 0; i < size; i++) {
+			seed ^= bytes[i];
+			seed *= FNV1A_PRIME;
+		} // end for
+		return seed;
+	} // end method
+
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+//! @brief Hashes string references in unordered containers (e.g. tokens of a
+//!        memory-mapped file), as boost::string_ref has no std::hash.
+struct StringRefHash {
+	std::size_t operator()(const boost::string_ref str) const {
+		return (std::size_t) Hash::fnv1a(str.data(), str.size());
+	} // end operator
+}; // end struct
+
+} // end namespace
+
+#endif
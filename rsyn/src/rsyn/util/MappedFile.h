@@ -0,0 +1,101 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_MAPPED_FILE_H
+#define RSYN_MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace Rsyn {
+
+//! @brief Maps a file into memory for reading. The file contents are loaded by
+//!        the operating system on demand, which avoids copying them through
+//!        stream buffers.
+class MappedFile {
+public:
+
+	MappedFile() : clsData(nullptr), clsSize(0) {}
+	MappedFile(const std::string &filename) : clsData(nullptr), clsSize(0) { open(filename); }
+	~MappedFile() { close(); }
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	//! @brief Maps a file. Returns false if the file could not be mapped.
+	bool open(const std::string &filename) {
+		close();
+
+		const int fd = ::open(filename.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat info;
+		if (fstat(fd, &info) != 0) {
+			::close(fd);
+			return false;
+		} // end if
+
+		clsSize = (std::size_t) info.st_size;
+		if (clsSize > 0) {
+			void *data = mmap(nullptr, clsSize, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data == MAP_FAILED) {
+				clsSize = 0;
+				::close(fd);
+				return false;
+			} // end if
+			clsData = static_cast<const char *>(data);
+
+			// Files are usually scanned from the beginning to the end.
+			madvise(data, clsSize, MADV_SEQUENTIAL);
+		} // end if
+
+		// The mapping remains valid after the descriptor is closed.
+		::close(fd);
+		clsOpen = true;
+		return true;
+	} // end method
+
+	//! @brief Unmaps the file.
+	void close() {
+		if (clsData)
+			munmap(const_cast<char *>(clsData), clsSize);
+		clsData = nullptr;
+		clsSize = 0;
+		clsOpen = false;
+	} // end method
+
+	bool isOpen() const { return clsOpen; }
+
+	const char *data() const { return clsData; }
+	const char *begin() const { return clsData; }
+	const char *end() const { return clsData + clsSize; }
+	std::size_t size() const { return clsSize; }
+
+private:
+
+	const char *clsData;
+	std::size_t clsSize;
+	bool clsOpen = false;
+}; // end class
+
+} // end namespace
+
+#endif /* RSYN_MAPPED_FILE_H */
@@ -0,0 +1,141 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_MEMORY_REPORT_H
+#define RSYN_MEMORY_REPORT_H
+
+#include <map>
+#include <deque>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+
+#include "rsyn/util/StreamStateSaver.h"
+
+namespace Rsyn {
+
+//! @brief Collects the memory used by data structures, in bytes, by category.
+//!        Categories are hierarchical with levels separated by '/' (e.g.
+//!        "rsyn.timer/pins").
+//! @note  Values are estimates of the heap memory owned by the data structures
+//!        and do not include allocator overhead.
+class MemoryReport {
+public:
+
+	//! @brief Adds bytes to a category.
+	void add(const std::string &category, const std::size_t bytes) {
+		clsEntries[category] += bytes;
+	} // end method
+
+	//! @brief Adds all entries of another report prefixing their categories.
+	void merge(const std::string &prefix, const MemoryReport &other) {
+		for (const auto &entry : other.clsEntries) {
+			add(prefix + "/" + entry.first, entry.second);
+		} // end for
+	} // end method
+
+	//! @brief Keeps, for each category and for the total, the maximum between
+	//!        the value in this report and the one in the other report.
+	void updatePeaks(const MemoryReport &other) {
+		for (const auto &entry : other.clsEntries) {
+			std::size_t &bytes = clsEntries[entry.first];
+			bytes = std::max(bytes, entry.second);
+		} // end for
+		clsPeakTotal = std::max(clsPeakTotal, other.getTotal());
+	} // end method
+
+	//! @brief Returns the bytes in a category or zero if the category is not
+	//!        present.
+	std::size_t getBytes(const std::string &category) const {
+		auto it = clsEntries.find(category);
+		return it != clsEntries.end() ? it->second : 0;
+	} // end method
+
+	//! @brief Returns the sum of all categories.
+	std::size_t getTotal() const {
+		std::size_t total = 0;
+		for (const auto &entry : clsEntries)
+			total += entry.second;
+		return total;
+	} // end method
+
+	//! @brief Returns the largest total seen by updatePeaks(). Note that the
+	//!        peaks of the categories may have happened at different times.
+	std::size_t getPeakTotal() const { return clsPeakTotal; }
+
+	bool isEmpty() const { return clsEntries.empty(); }
+
+	const std::map<std::string, std::size_t> &allEntries() const { return clsEntries; }
+
+	//! @brief Prints the report as a table. Peak values are printed in a second
+	//!        column if a report with peaks is given.
+	void print(std::ostream &out, const MemoryReport *peaks = nullptr) const {
+		StreamStateSaver sss(out);
+
+		out << std::left << std::setw(48) << "Category";
+		out << std::right << std::setw(12) << "Current(MB)";
+		if (peaks)
+			out << std::right << std::setw(12) << "Peak(MB)";
+		out << "\n";
+
+		out << std::fixed << std::setprecision(2);
+		for (const auto &entry : clsEntries) {
+			out << std::left << std::setw(48) << entry.first;
+			out << std::right << std::setw(12) << toMB(entry.second);
+			if (peaks)
+				out << std::right << std::setw(12) << toMB(peaks->getBytes(entry.first));
+			out << "\n";
+		} // end for
+
+		out << std::left << std::setw(48) << "Total";
+		out << std::right << std::setw(12) << toMB(getTotal());
+		if (peaks)
+			out << std::right << std::setw(12) << toMB(peaks->getPeakTotal());
+		out << "\n";
+	} // end method
+
+	static double toMB(const std::size_t bytes) {
+		return bytes / (1024.0 * 1024.0);
+	} // end method
+
+	// Helpers to estimate the memory owned by standard containers. The memory
+	// of the elements themselves (e.g. vectors of vectors) is not included.
+
+	template<typename T>
+	static std::size_t bytes(const std::vector<T> &v) {
+		return v.capacity() * sizeof(T);
+	} // end method
+
+	template<typename T>
+	static std::size_t bytes(const std::deque<T> &v) {
+		return v.size() * sizeof(T);
+	} // end method
+
+	static std::size_t bytes(const std::string &s) {
+		// Short strings are stored inside the object.
+		return s.capacity() > 15 ? s.capacity() + 1 : 0;
+	} // end method
+
+private:
+
+	std::map<std::string, std::size_t> clsEntries;
+	std::size_t clsPeakTotal = 0;
+}; // end class
+
+} // end namespace
+
+#endif /* RSYN_MEMORY_REPORT_H */
@@ -19,6 +19,8 @@
 #ifdef __linux__
 #include <sys/time.h>
 #include <sys/resource.h>
+#include <unistd.h>
+#include <fstream>
 
 class MemoryUsage {
 public:	
@@ -29,6 +31,16 @@ public:
 		ret = getrusage(RUSAGE_SELF, &usage);
 		return usage.ru_maxrss / 1000;		
 	} // end method
+	
+	// Retrieve the current resident set size in MB.
+	static int getCurrentMemoryUsage() {
+		std::ifstream file("/proc/self/statm");
+		long pages = 0;
+		long resident = 0;
+		if (!(file >> pages >> resident))
+			return 0;
+		return (int) ((resident * sysconf(_SC_PAGESIZE)) / (1024 * 1024));
+	} // end method
 }; // end class
 
 #else
@@ -36,6 +48,7 @@ public:
 class MemoryUsage {
 public:
 	static int getMemoryUsage() { return 0; }
+	static int getCurrentMemoryUsage() { return 0; }
 }; // end class
 
 #endif
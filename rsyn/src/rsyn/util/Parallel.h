@@ -0,0 +1,203 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_PARALLEL_H
+#define UTIL_PARALLEL_H
+
+////////////////////////////////////////////////////////////////////////////////
+// Parallel loops over partitionable collections, i.e. collections providing
+//
+//     1) int getNumChunks();
+//     2) Collection getChunks(const int firstChunk, const int lastChunk);
+//
+// where the second method returns the collection restricted to the objects in
+// the chunks [firstChunk, lastChunk). The netlist collections (e.g.
+// Module::allNets(), Module::allInstances()) are partitioned by the chunks of
+// the underlying list.
+//
+// Example
+// -------
+//
+//    parallel_for(module.allNets(), [&](Rsyn::Net net) {
+//        updateNet(net);
+//    });
+//
+//    const int numPins = parallel_reduce(module.allNets(), 0,
+//        [](Rsyn::Net net) { return net.getNumPins(); },
+//        std::plus<int>());
+//
+// Chunks are processed by the shared thread pool and by the calling thread. So
+// nested parallel loops do not deadlock, they just run with less parallelism.
+// The function must be safe to be called concurrently for different objects.
+// If it throws, the chunks not yet started are skipped and the first exception
+// is rethrown in the calling thread once all running chunks are done.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <deque>
+#include <condition_variable>
+#include <exception>
+
+#include "rsyn/util/ThreadPool.h"
+#include "rsyn/util/RangeBasedLoop.h"
+
+//! @brief Returns the thread pool shared by the parallel loops.
+inline ThreadPool &getSharedThreadPool() {
+	static ThreadPool pool;
+	return pool;
+} // end function
+
+// -----------------------------------------------------------------------------
+
+namespace ParallelInternal {
+
+//! @brief Calls process(chunk) for each chunk in [0, numChunks) using the pool
+//!        and the calling thread. Returns when all chunks were processed. If
+//!        process throws, the remaining chunks are skipped and the first
+//!        exception is rethrown.
+template<class Function>
+void processChunks(ThreadPool &pool, const int numChunks, const Function &process) {
+	if (numChunks <= 1 || pool.getNumThreads() == 0) {
+		for (int chunk = 0; chunk < numChunks; chunk++)
+			process(chunk);
+		return;
+	} // end if
+
+	// Helpers may start after the loop is done (e.g. when the pool is busy).
+	// So the state is shared with them and the function is only accessed after
+	// a chunk is claimed, which guarantees the caller is still waiting.
+	struct State {
+		std::atomic<int> nextChunk;
+		int numChunks;
+		int numProcessedChunks;
+		const Function *process;
+		std::atomic<bool> failed;
+		std::exception_ptr error;
+		std::mutex mutex;
+		std::condition_variable done;
+
+		void run() {
+			int chunk;
+			while ((chunk = nextChunk++) < numChunks) {
+				// A chunk is counted even if it fails or is skipped, otherwise
+				// the caller would wait forever.
+				std::exception_ptr chunkError;
+				if (!failed) {
+					try {
+						(*process)(chunk);
+					} catch (...) {
+						chunkError = std::current_exception();
+					} // end catch
+				} // end if
+
+				std::lock_guard<std::mutex> lock(mutex);
+				if (chunkError && !error) {
+					error = chunkError;
+					failed = true;
+				} // end if
+				if (++numProcessedChunks == numChunks)
+					done.notify_all();
+			} // end while
+		} // end method
+	}; // end struct
+
+	std::shared_ptr<State> state = std::make_shared<State>();
+	state->nextChunk = 0;
+	state->numChunks = numChunks;
+	state->numProcessedChunks = 0;
+	state->process = &process;
+	state->failed = false;
+
+	const int numHelpers = (int) std::min<std::size_t>(pool.getNumThreads(), numChunks - 1);
+	for (int i = 0; i < numHelpers; i++) {
+		pool.addTask([state]() { state->run(); });
+	} // end for
+
+	state->run();
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->done.wait(lock, [&state]() {
+		return state->numProcessedChunks == state->numChunks;
+	});
+
+	if (state->error)
+		std::rethrow_exception(state->error);
+} // end function
+
+} // end namespace
+
+// -----------------------------------------------------------------------------
+
+//! @brief Calls f(object) for all objects of a partitionable collection in
+//!        parallel.
+template<class Collection, class Function>
+void parallel_for(ThreadPool &pool, Range<Collection> range, Function f) {
+	Collection &collection = range.getCollection();
+	ParallelInternal::processChunks(pool, collection.getNumChunks(),
+			[&collection, &f](const int chunk) {
+		for (auto object : Range<Collection>(collection.getChunks(chunk, chunk + 1))) {
+			f(object);
+		} // end for
+	});
+} // end function
+
+// -----------------------------------------------------------------------------
+
+template<class Collection, class Function>
+void parallel_for(Range<Collection> range, Function f) {
+	parallel_for(getSharedThreadPool(), range, f);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+//! @brief Computes reduce(...reduce(reduce(identity, f(o0)), f(o1))..., f(oN))
+//!        for all objects of a partitionable collection in parallel. Partial
+//!        results are reduced in the order of the collection, so the result
+//!        does not depend on scheduling as long as reduce is associative.
+template<class Collection, class T, class Function, class Reduce>
+T parallel_reduce(ThreadPool &pool, Range<Collection> range, const T identity,
+		Function f, Reduce reduce) {
+	Collection &collection = range.getCollection();
+	const int numChunks = collection.getNumChunks();
+
+	// Note: std::deque is used since std::vector<bool> is not thread safe.
+	std::deque<T> partials(numChunks, identity);
+	ParallelInternal::processChunks(pool, numChunks,
+			[&collection, &partials, &f, &reduce](const int chunk) {
+		T &partial = partials[chunk];
+		for (auto object : Range<Collection>(collection.getChunks(chunk, chunk + 1))) {
+			partial = reduce(partial, f(object));
+		} // end for
+	});
+
+	T result = identity;
+	for (const T &partial : partials) {
+		result = reduce(result, partial);
+	} // end for
+	return result;
+} // end function
+
+// -----------------------------------------------------------------------------
+
+template<class Collection, class T, class Function, class Reduce>
+T parallel_reduce(Range<Collection> range, const T identity, Function f,
+		Reduce reduce) {
+	return parallel_reduce(getSharedThreadPool(), range, identity, f, reduce);
+} // end function
+
+#endif
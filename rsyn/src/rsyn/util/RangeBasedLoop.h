@@ -141,6 +141,10 @@ public:
 
 	RangeIterator begin() { return RangeIterator(collection); }
 	RangeIterator end() { return RangeIterator(); /*dummy, not used */}
+
+	// Access to the underlying collection (e.g. to partition it, see 
+	// Parallel.h).
+	Collection &getCollection() { return collection; }
 }; // end class	
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,51 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_SPAN_H
+#define RSYN_SPAN_H
+
+#include <cstddef>
+#include <vector>
+
+namespace Rsyn {
+
+//! @brief A read-only view of a contiguous sequence of objects (e.g. the
+//!        elements of a std::vector). The viewed objects must outlive the
+//!        span and the span is invalidated if they are reallocated.
+template<class T>
+class Span {
+public:
+
+	Span() : clsData(nullptr), clsSize(0) {}
+	Span(const T *data, const std::size_t size) : clsData(data), clsSize(size) {}
+	Span(const std::vector<T> &v) : clsData(v.data()), clsSize(v.size()) {}
+
+	const T *data() const { return clsData; }
+	const T *begin() const { return clsData; }
+	const T *end() const { return clsData + clsSize; }
+	std::size_t size() const { return clsSize; }
+	bool empty() const { return clsSize == 0; }
+
+	const T &operator[](const std::size_t index) const { return clsData[index]; }
+
+private:
+
+	const T *clsData;
+	std::size_t clsSize;
+}; // end class
+
+} // end namespace
+
+#endif /* RSYN_SPAN_H */
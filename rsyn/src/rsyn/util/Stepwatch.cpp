@@ -15,4 +15,4 @@
  
 #include "Stepwatch.h"
 
-int Stepwatch::clsDepth = 0;
+std::atomic<int> Stepwatch::clsDepth(0);
@@ -16,6 +16,7 @@
 #ifndef STEPWATCH_H
 #define	STEPWATCH_H
 
+#include <atomic>
 #include <iostream>
 
 #include "MemoryUsage.h"
@@ -23,7 +24,7 @@
 
 class Stepwatch {
 private:
-	static int clsDepth;
+	static std::atomic<int> clsDepth;
 	
 	Stopwatch clsStopwatch;
 	const std::string clsMsg;
@@ -1193,6 +1193,9 @@ bool Infrastructure::isLegalized(Rsyn::Cell cell) {
 // -----------------------------------------------------------------------------
 
 double Infrastructure::getAvailableFreespace(Rsyn::Cell cell) {
+	if (clsPhysicalDesign.isEnableRowOccupancy())
+		return getAvailableFreespaceLeft(cell) + getAvailableFreespaceRight(cell);
+
 	Rsyn::PhysicalCell ph = clsPhysicalDesign.getPhysicalCell(cell);
 	Jezz::JezzNode * jezzNode = clsJezz->getJezzNode(ph.getInstance());
 	return jezzNode? clsJezz->jezz_GetAvailableFreespace(jezzNode) : 0;
@@ -1203,6 +1206,17 @@ double Infrastructure::getAvailableFreespace(Rsyn::Cell cell) {
 double Infrastructure::getAvailableFreespaceRight(Rsyn::Cell cell) {
 	Rsyn::PhysicalCell ph = clsPhysicalDesign.getPhysicalCell(cell);
 	Jezz::JezzNode * jezzNode = clsJezz->getJezzNode(ph.getInstance());
+
+	// The row occupancy answers it without walking the Jezz rows. As in Jezz,
+	// cells that are not legalized have no free space around them since the
+	// occupancy does not tell which cells they overlap.
+	if (clsPhysicalDesign.isEnableRowOccupancy()) {
+		if (!jezzNode || !clsJezz->jezz_dp_IsLegalized(jezzNode))
+			return 0;
+		Rsyn::PhysicalRow phRow = clsPhysicalDesign.getPhysicalRowAt(ph.getPosition());
+		return phRow? clsPhysicalDesign.getRowFreeSpace(phRow, ph.getCoordinate(UPPER, X), UPPER) : 0;
+	} // end if
+
 	return jezzNode? clsJezz->jezz_GetAvailableFreespaceRight(jezzNode) : 0;
 } // end method 
 
@@ -1211,6 +1225,15 @@ double Infrastructure::getAvailableFreespaceRight(Rsyn::Cell cell) {
 double Infrastructure::getAvailableFreespaceLeft(Rsyn::Cell cell) {
 	Rsyn::PhysicalCell ph = clsPhysicalDesign.getPhysicalCell(cell);
 	Jezz::JezzNode * jezzNode = clsJezz->getJezzNode(ph.getInstance());
+
+	// See getAvailableFreespaceRight().
+	if (clsPhysicalDesign.isEnableRowOccupancy()) {
+		if (!jezzNode || !clsJezz->jezz_dp_IsLegalized(jezzNode))
+			return 0;
+		Rsyn::PhysicalRow phRow = clsPhysicalDesign.getPhysicalRowAt(ph.getPosition());
+		return phRow? clsPhysicalDesign.getRowFreeSpace(phRow, ph.getCoordinate(LOWER, X), LOWER) : 0;
+	} // end if
+
 	return jezzNode? clsJezz->jezz_GetAvailableFreespaceLeft(jezzNode) : 0;
 } // end method 
 
@@ -57,6 +57,11 @@ void ICCAD15Reader::openBenchmarkFromICCAD15()  {
 	Rsyn::PhysicalService *physicalService = engine.getService("rsyn.physical");
 	Rsyn::PhysicalDesign physicalDesign = physicalService->getPhysicalDesign();
 
+	// Neighbourhood queries of the detailed placement heuristics.
+	Stepwatch watchSpatialIndex("Starting spatial index");
+	engine.startService("rsyn.spatialIndex", {});
+	watchSpatialIndex.finish();
+
 	Stepwatch watchJezz("Starting Jezz");
 	engine.startService("rsyn.jezz", {});
 	watchJezz.finish();
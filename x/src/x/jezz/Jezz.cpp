@@ -171,6 +171,25 @@ void Jezz::stop() {
 
 // -----------------------------------------------------------------------------
 
+void Jezz::reportMemoryUsage(Rsyn::MemoryReport &report) {
+	std::size_t rows = Rsyn::MemoryReport::bytes(clsJezzRows);
+	for (const JezzRow &row : clsJezzRows)
+		rows += Rsyn::MemoryReport::bytes(row.slots);
+	report.add("rows", rows);
+
+	report.add("nodes",
+			Rsyn::MemoryReport::bytes(clsJezzNodes) +
+			Rsyn::MemoryReport::bytes(clsJezzObstacles) +
+			Rsyn::MemoryReport::bytes(clsJezzWhitespaces));
+
+	std::size_t storedSolutions = 0;
+	for (const auto &entry : clsJezzStoredSolution)
+		storedSolutions += Rsyn::MemoryReport::bytes(entry.second);
+	report.add("stored solutions", storedSolutions);
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void Jezz::onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) {
 	JezzNode *jezzNode = getJezzNode(cell);
 	jezz_dp_RemoveNode(jezzNode);
@@ -61,6 +61,7 @@ public:
 
 	virtual void start(Rsyn::Engine engine, const Rsyn::Json &params);
 	virtual void stop();
+	virtual void reportMemoryUsage(Rsyn::MemoryReport &report) override;
 
 	// Events
 	virtual void
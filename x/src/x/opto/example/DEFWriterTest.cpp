@@ -0,0 +1,152 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#include <cstdio>
+#include <vector>
+
+#include "rsyn/io/parser/lef_def/DEFControlParser.h"
+#include "rsyn/io/parser/lef_def/DEFWriter.h"
+#include "rsyn/phy/PhysicalService.h"
+#include "rsyn/phy/util/PhysicalUtil.h"
+#include "x/util/UnitTest.h"
+#include "DEFWriterTest.h"
+
+namespace Testing {
+
+bool DEFWriterTest::run(Rsyn::Engine engine, const Rsyn::Json &params) {
+	this->engine = engine;
+	this->design = engine.getDesign();
+	this->module = design.getTopModule();
+
+	Rsyn::PhysicalService *physical = engine.getService("rsyn.physical");
+	this->physicalDesign = physical->getPhysicalDesign();
+
+	try {
+		test();
+	} catch (const UnitTest::Exception &e) {
+		std::cout << "[ERROR] DEF writer test failed: " << e << "\n";
+		return false;
+	} // end catch
+
+	std::cout << "DEF writer test passed.\n";
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void DEFWriterTest::test() {
+	const std::string filename = design.getName() + "-def-writer-test.def";
+
+	Rsyn::DEFWriter writer(design, physicalDesign);
+	const bool written = writer.write(filename, true);
+	UnitTest::assertCondition(written, "Could not write the DEF file.");
+
+	DefDscp defDscp;
+	DEFControlParser parser;
+	parser.parseDEF(filename, defDscp);
+	std::remove(filename.c_str());
+
+	// Header
+	UnitTest::assertCondition(defDscp.clsDesignName == design.getName(),
+			"Design name differs.");
+	UnitTest::assertCondition(defDscp.clsDatabaseUnits ==
+			physicalDesign.getDatabaseUnits(Rsyn::DESIGN_DBU),
+			"Database units differ.");
+	const Bounds &die = physicalDesign.getPhysicalDie().getBounds();
+	UnitTest::assertCondition(defDscp.clsDieBounds[LOWER] == die[LOWER] &&
+			defDscp.clsDieBounds[UPPER] == die[UPPER], "Die area differs.");
+	UnitTest::assertCondition((int) defDscp.clsRows.size() ==
+			physicalDesign.getNumRows(), "Number of rows differs.");
+
+	// Components
+	int numCells = 0;
+	for (Rsyn::Instance instance : module.allInstances()) {
+		if (instance.getType() == Rsyn::CELL)
+			numCells++;
+	} // end for
+	UnitTest::assertCondition((int) defDscp.clsComps.size() == numCells,
+			"Number of components differs.");
+
+	for (const DefComponentDscp &component : defDscp.clsComps) {
+		Rsyn::Cell cell = design.findCellByName(component.clsName);
+		UnitTest::assertCondition(cell != nullptr,
+				"Component " + component.clsName + " is not in the design.");
+
+		Rsyn::PhysicalCell physicalCell = physicalDesign.getPhysicalCell(cell);
+		UnitTest::assertCondition(component.clsMacroName == cell.getLibraryCellName(),
+				"Macro of component " + component.clsName + " differs.");
+		UnitTest::assertCondition(component.clsPos == physicalCell.getPosition(),
+				"Position of component " + component.clsName + " differs.");
+		UnitTest::assertCondition(Rsyn::getPhysicalOrientation(component.clsOrientation) ==
+				physicalCell.getOrientation(),
+				"Orientation of component " + component.clsName + " differs.");
+		UnitTest::assertCondition(component.clsIsFixed == cell.isFixed(),
+				"Fixed status of component " + component.clsName + " differs.");
+	} // end for
+
+	// Pins
+	int numPorts = 0;
+	for (Rsyn::Port port : module.allPorts()) {
+		numPorts++;
+	} // end for
+	UnitTest::assertCondition((int) defDscp.clsPorts.size() == numPorts,
+			"Number of pins differs.");
+
+	for (const DefPortDscp &pin : defDscp.clsPorts) {
+		Rsyn::Port port = design.findPortByName(pin.clsName);
+		UnitTest::assertCondition(port != nullptr,
+				"Pin " + pin.clsName + " is not in the design.");
+		UnitTest::assertCondition(pin.clsPos ==
+				physicalDesign.getPhysicalPort(port).getPosition(),
+				"Position of pin " + pin.clsName + " differs.");
+	} // end for
+
+	// Nets
+	int numNets = 0;
+	for (Rsyn::Net net : module.allNets()) {
+		numNets++;
+	} // end for
+	UnitTest::assertCondition((int) defDscp.clsNets.size() == numNets,
+			"Number of nets differs.");
+
+	for (const DefNetDscp &defNet : defDscp.clsNets) {
+		Rsyn::Net net = design.findNetByName(defNet.clsName);
+		UnitTest::assertCondition(net != nullptr,
+				"Net " + defNet.clsName + " is not in the design.");
+		UnitTest::assertCondition((int) defNet.clsConnections.size() == net.getNumPins(),
+				"Number of connections of net " + defNet.clsName + " differs.");
+
+		for (const DefNetConnection &connection : defNet.clsConnections) {
+			Rsyn::Pin pin;
+			if (connection.clsComponentName == "PIN") {
+				Rsyn::Port port = design.findPortByName(connection.clsPinName);
+				if (port)
+					pin = port.getInnerPin();
+			} else {
+				Rsyn::Instance instance =
+						design.findInstanceByName(connection.clsComponentName);
+				if (instance)
+					pin = instance.getPinByName(connection.clsPinName);
+			} // end else
+
+			UnitTest::assertCondition(pin && pin.getNet() == net,
+					"Connection " + connection.clsComponentName + ":" +
+					connection.clsPinName + " of net " + defNet.clsName +
+					" differs.");
+		} // end for
+	} // end for
+} // end method
+
+} // end namespace
@@ -0,0 +1,44 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DEF_WRITER_TEST_H
+#define DEF_WRITER_TEST_H
+
+#include "rsyn/engine/Engine.h"
+#include "rsyn/phy/PhysicalDesign.h"
+
+namespace Testing {
+
+//! @brief Writes the design to a DEF file with the native DEF writer, parses
+//!        it back with the DEF parser and checks that the components, pins
+//!        and nets match the design.
+//! @note  Requires the physical service. The design is not changed.
+class DEFWriterTest : public Rsyn::Process {
+private:
+	Rsyn::Engine engine;
+	Rsyn::Design design;
+	Rsyn::Module module;
+	Rsyn::PhysicalDesign physicalDesign;
+
+	void test();
+
+public:
+
+	virtual bool run(Rsyn::Engine engine, const Rsyn::Json &params);
+}; // end class
+
+} // end namespace
+
+#endif
@@ -0,0 +1,150 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <stdexcept>
+
+#include "x/util/UnitTest.h"
+#include "ParallelTest.h"
+#include "rsyn/util/Parallel.h"
+
+namespace Testing {
+
+bool ParallelTest::run(Rsyn::Engine engine, const Rsyn::Json &params) {
+	this->design = engine.getDesign();
+	this->module = design.getTopModule();
+
+	try {
+		test();
+	} catch (const UnitTest::Exception &e) {
+		std::cout << "[ERROR] Parallel test failed: " << e << "\n";
+		return false;
+	} // end catch
+
+	std::cout << "Parallel test passed.\n";
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void ParallelTest::test() {
+	ThreadPool &pool = getSharedThreadPool();
+
+	// More chunks than threads, so threads claim several chunks each.
+	const int numChunks = 4 * ((int) pool.getNumThreads() + 1) + 3;
+
+	std::unique_ptr<std::atomic<int>[]> counts(new std::atomic<int>[numChunks]);
+	auto resetCounts = [&]() {
+		for (int i = 0; i < numChunks; i++) {
+			counts[i] = 0;
+		} // end for
+	};
+
+	// Every chunk is processed exactly once.
+	for (int round = 0; round < 8; round++) {
+		resetCounts();
+		ParallelInternal::processChunks(pool, numChunks, [&](const int chunk) {
+			counts[chunk]++;
+			std::this_thread::yield();
+		});
+		for (int i = 0; i < numChunks; i++) {
+			UnitTest::assertCondition(counts[i] == 1,
+					"A chunk was not processed exactly once.");
+		} // end for
+	} // end for
+
+	// An exception is rethrown in the caller and no chunk runs after that.
+	const int failingChunk = numChunks / 2;
+	resetCounts();
+	bool thrown = false;
+	try {
+		ParallelInternal::processChunks(pool, numChunks, [&](const int chunk) {
+			counts[chunk]++;
+			std::this_thread::yield();
+			if (chunk == failingChunk)
+				throw std::runtime_error("chunk failed");
+		});
+	} catch (const std::runtime_error &e) {
+		thrown = std::string(e.what()) == "chunk failed";
+	} // end catch
+	UnitTest::assertCondition(thrown,
+			"The exception thrown by a chunk was not rethrown.");
+	UnitTest::assertCondition(counts[failingChunk] == 1,
+			"The failing chunk was not processed exactly once.");
+
+	std::vector<int> countsAfterFailure(numChunks);
+	for (int i = 0; i < numChunks; i++) {
+		UnitTest::assertCondition(counts[i] <= 1,
+				"A chunk was processed more than once after a failure.");
+		countsAfterFailure[i] = counts[i];
+	} // end for
+
+	// The pool is still usable and late helpers of the failed loop do not
+	// call its function.
+	std::atomic<int> numProcessed(0);
+	ParallelInternal::processChunks(pool, numChunks, [&](const int chunk) {
+		numProcessed++;
+	});
+	UnitTest::assertCondition(numProcessed == numChunks,
+			"The pool lost chunks after a failure.");
+	for (int i = 0; i < numChunks; i++) {
+		UnitTest::assertCondition(counts[i] == countsAfterFailure[i],
+				"A chunk of a failed loop ran after the loop returned.");
+	} // end for
+
+	// Only one of many exceptions is rethrown.
+	int numCaught = 0;
+	try {
+		ParallelInternal::processChunks(pool, numChunks, [&](const int chunk) {
+			throw chunk;
+		});
+	} catch (const int chunk) {
+		numCaught++;
+		UnitTest::assertCondition(chunk >= 0 && chunk < numChunks,
+				"An unexpected exception was rethrown.");
+	} // end catch
+	UnitTest::assertCondition(numCaught == 1,
+			"The exceptions thrown by chunks were not rethrown.");
+
+	// Exceptions in nested loops reach the outermost caller.
+	thrown = false;
+	try {
+		ParallelInternal::processChunks(pool, numChunks, [&](const int outer) {
+			ParallelInternal::processChunks(pool, numChunks, [&](const int inner) {
+				if (outer == failingChunk && inner == failingChunk)
+					throw std::runtime_error("nested chunk failed");
+			});
+		});
+	} catch (const std::runtime_error &e) {
+		thrown = std::string(e.what()) == "nested chunk failed";
+	} // end catch
+	UnitTest::assertCondition(thrown,
+			"The exception thrown by a nested chunk was not rethrown.");
+
+	// Parallel loops over the netlist see all objects.
+	int numPins = 0;
+	for (Rsyn::Net net : module.allNets()) {
+		numPins += net.getNumPins();
+	} // end for
+	const int parallelNumPins = parallel_reduce(module.allNets(), 0,
+			[](Rsyn::Net net) { return net.getNumPins(); },
+			std::plus<int>());
+	UnitTest::assertCondition(parallelNumPins == numPins,
+			"Parallel reduction over the nets differs from the serial one.");
+} // end method
+
+} // end namespace
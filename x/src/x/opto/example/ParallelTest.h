@@ -0,0 +1,40 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARALLEL_TEST_H
+#define PARALLEL_TEST_H
+
+#include "rsyn/engine/Engine.h"
+
+namespace Testing {
+
+//! @brief Checks that parallel chunks are processed exactly once and that an
+//!        exception thrown by a chunk is rethrown to the caller after the
+//!        running chunks are done.
+class ParallelTest : public Rsyn::Process {
+private:
+	Rsyn::Design design;
+	Rsyn::Module module;
+
+	void test();
+
+public:
+
+	virtual bool run(Rsyn::Engine engine, const Rsyn::Json &params);
+}; // end class
+
+} // end namespace
+
+#endif
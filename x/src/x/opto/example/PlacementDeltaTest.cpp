@@ -0,0 +1,120 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#include <cstdio>
+#include <vector>
+
+#include "rsyn/io/Writer.h"
+#include "rsyn/phy/PhysicalService.h"
+#include "rsyn/util/Exception.h"
+#include "x/util/UnitTest.h"
+#include "PlacementDeltaTest.h"
+
+namespace Testing {
+
+bool PlacementDeltaTest::run(Rsyn::Engine engine, const Rsyn::Json &params) {
+	this->engine = engine;
+	this->design = engine.getDesign();
+	this->module = design.getTopModule();
+
+	Rsyn::PhysicalService *physical = engine.getService("rsyn.physical");
+	this->physicalDesign = physical->getPhysicalDesign();
+
+	try {
+		test();
+	} catch (const UnitTest::Exception &e) {
+		std::cout << "[ERROR] Placement delta test failed: " << e << "\n";
+		return false;
+	} // end catch
+
+	std::cout << "Placement delta test passed.\n";
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void PlacementDeltaTest::test() {
+	Rsyn::Writer *writer = engine.getService("rsyn.writer");
+
+	// Number of cells moved after the baseline is created.
+	const int MAX_MOVED_CELLS = 16;
+
+	std::vector<Rsyn::Cell> cells;
+	std::vector<DBUxy> original;
+	for (Rsyn::Instance instance : module.allInstances()) {
+		if (instance.getType() != Rsyn::CELL || instance.isFixed())
+			continue;
+		cells.push_back(instance.asCell());
+		original.push_back(physicalDesign.getPhysicalCell(instance.asCell()).getPosition());
+		if (cells.size() == MAX_MOVED_CELLS)
+			break;
+	} // end for
+	UnitTest::assertCondition(!cells.empty(), "The design has no movable cells.");
+
+	const std::string baseline = "testing.placementDelta";
+	const std::string filename = design.getName() + "-placement-delta-test.delta";
+	writer->createPlacementBaseline(baseline);
+
+	std::vector<DBUxy> moved(cells.size());
+	for (int i = 0; i < cells.size(); i++) {
+		moved[i] = original[i] + DBUxy(10 * (i + 1), 0);
+		physicalDesign.placeCell(cells[i], moved[i]);
+	} // end for
+
+	const bool written = writer->writePlacementDelta(baseline, filename);
+	UnitTest::assertCondition(written, "Could not write the placement delta.");
+
+	// The delta is applied on top of the baseline placement.
+	for (int i = 0; i < cells.size(); i++) {
+		physicalDesign.placeCell(cells[i], original[i]);
+	} // end for
+
+	bool applied = true;
+	try {
+		engine.runReader("loadDesignPosition", {{"path", filename}});
+	} catch (const Exception &e) {
+		applied = false;
+	} // end catch
+
+	for (int i = 0; i < cells.size() && applied; i++) {
+		const DBUxy position = physicalDesign.getPhysicalCell(cells[i]).getPosition();
+		if (position != moved[i]) {
+			applied = false;
+		} // end if
+	} // end for
+
+	// The placement now differs from the baseline, so applying the delta again
+	// must be refused.
+	bool refused = false;
+	if (applied) {
+		try {
+			engine.runReader("loadDesignPosition", {{"path", filename}});
+		} catch (const Exception &e) {
+			refused = true;
+		} // end catch
+	} // end if
+
+	std::remove(filename.c_str());
+	for (int i = 0; i < cells.size(); i++) {
+		physicalDesign.placeCell(cells[i], original[i]);
+	} // end for
+
+	UnitTest::assertCondition(applied,
+			"The placement delta was not applied on top of its baseline.");
+	UnitTest::assertCondition(refused,
+			"The placement delta was applied on top of a different placement.");
+} // end method
+
+} // end namespace
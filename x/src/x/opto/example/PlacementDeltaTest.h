@@ -0,0 +1,47 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PLACEMENT_DELTA_TEST_H
+#define PLACEMENT_DELTA_TEST_H
+
+#include "rsyn/engine/Engine.h"
+#include "rsyn/phy/PhysicalDesign.h"
+
+namespace Testing {
+
+//! @brief Moves some cells, writes a placement delta against a baseline taken
+//!        before the moves, restores the baseline placement and applies the
+//!        delta with the loadDesignPosition reader. Checks that the cells end
+//!        up at the moved positions and that the delta is refused once the
+//!        placement no longer matches the baseline.
+//! @note  Requires the physical service and the writer. The placement is
+//!        restored at the end.
+class PlacementDeltaTest : public Rsyn::Process {
+private:
+	Rsyn::Engine engine;
+	Rsyn::Design design;
+	Rsyn::Module module;
+	Rsyn::PhysicalDesign physicalDesign;
+
+	void test();
+
+public:
+
+	virtual bool run(Rsyn::Engine engine, const Rsyn::Json &params);
+}; // end class
+
+} // end namespace
+
+#endif
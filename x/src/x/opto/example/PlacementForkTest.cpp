@@ -0,0 +1,166 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#include <thread>
+
+#include "rsyn/phy/PhysicalService.h"
+#include "x/util/UnitTest.h"
+#include "PlacementForkTest.h"
+
+namespace Testing {
+
+bool PlacementForkTest::run(Rsyn::Engine engine, const Rsyn::Json &params) {
+	this->design = engine.getDesign();
+	this->module = design.getTopModule();
+
+	Rsyn::PhysicalService *physicalService = engine.getService("rsyn.physical");
+	this->physicalDesign = physicalService->getPhysicalDesign();
+
+	try {
+		test();
+	} catch (const UnitTest::Exception &e) {
+		std::cout << "[ERROR] Placement fork test failed: " << e << "\n";
+		return false;
+	} // end catch
+
+	std::cout << "Placement fork test passed.\n";
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void PlacementForkTest::test() {
+	const int numCells = 64;
+	const int numForks = 4;
+
+	// The last cells are the most likely to share a chunk with cells created
+	// later on.
+	std::vector<Rsyn::Cell> cells;
+	for (Rsyn::Instance instance : module.allInstances()) {
+		if (instance.getType() == Rsyn::CELL && instance.isMovable())
+			cells.push_back(instance.asCell());
+	} // end for
+	if (cells.size() > numCells)
+		cells.erase(cells.begin(), cells.end() - numCells);
+	UnitTest::assertCondition(!cells.empty(), "The design has no movable cells.");
+
+	std::vector<DBUxy> original;
+	for (Rsyn::Cell cell : cells) {
+		original.push_back(physicalDesign.getPhysicalCell(cell).getPosition());
+	} // end for
+
+	// Each fork moves the cells by a different offset in its own thread.
+	std::vector<Rsyn::PlacementFork> forks;
+	for (int i = 0; i < numForks; i++) {
+		forks.emplace_back(physicalDesign);
+	} // end for
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < numForks; i++) {
+		threads.emplace_back([&, i]() {
+			const DBUxy offset((i + 1) * 10, (i + 1) * 20);
+			for (std::size_t k = 0; k < cells.size(); k++) {
+				forks[i].placeCell(cells[k], original[k] + offset);
+			} // end for
+		});
+	} // end for
+	for (std::thread &thread : threads) {
+		thread.join();
+	} // end for
+
+	for (std::size_t k = 0; k < cells.size(); k++) {
+		UnitTest::assertCondition(
+				physicalDesign.getPhysicalCell(cells[k]).getPosition() == original[k],
+				"A fork changed the design before being committed.");
+		for (int i = 0; i < numForks; i++) {
+			const DBUxy offset((i + 1) * 10, (i + 1) * 20);
+			UnitTest::assertCondition(forks[i].getPosition(cells[k]) == original[k] + offset,
+					"A fork does not see its own moves.");
+		} // end for
+	} // end for
+
+	for (int i = 0; i < numForks; i++) {
+		UnitTest::assertCondition(forks[i].getNumModifiedChunks() <= (int) cells.size(),
+				"A fork copied more chunks than the cells it moved.");
+	} // end for
+
+	// Objects created after the fork copied a chunk are read from the design
+	// until written.
+	Rsyn::PlacementFork &last = forks.back();
+	Rsyn::Cell created = module.createCell(cells.back().getLibraryCell());
+	const DBUxy createdPos = physicalDesign.getPhysicalCell(created).getPosition();
+	UnitTest::assertCondition(last.getPosition(created) == createdPos,
+			"A fork does not see cells created after it.");
+	last.placeCell(created, createdPos + DBUxy(10, 10));
+	UnitTest::assertCondition(last.getPosition(created) == createdPos + DBUxy(10, 10),
+			"A fork does not see its own move of a created cell.");
+	UnitTest::assertCondition(physicalDesign.getPhysicalCell(created).getPosition() == createdPos,
+			"A fork changed a created cell in the design.");
+	UnitTest::assertCondition(
+			last.getPosition(cells.back()) == original.back() + DBUxy(numForks * 10, numForks * 20),
+			"A fork lost a move when a created cell was written.");
+
+	// Commits the first fork and checks that it went through placeCell().
+	std::vector<DBUxy> pinPositions;
+	for (Rsyn::Cell cell : cells) {
+		for (Rsyn::Pin pin : cell.allPins()) {
+			pinPositions.push_back(forks[0].getPinPosition(pin));
+		} // end for
+	} // end for
+
+	int numNotifications = 0;
+	Rsyn::PhysicalDesign::PostInstanceMovedCallbackHandler handler =
+			physicalDesign.addPostInstanceMovedCallback(0, [&](Rsyn::PhysicalInstance instance) {
+		numNotifications++;
+	});
+	forks[0].commit();
+	physicalDesign.deletePostInstanceMovedCallback(handler);
+
+	UnitTest::assertCondition(numNotifications == (int) cells.size(),
+			"Committing a fork did not notify the moves.");
+	UnitTest::assertCondition(forks[0].getNumMoves() == 0 && forks[0].getNumModifiedChunks() == 0,
+			"A committed fork still holds data.");
+
+	int index = 0;
+	for (std::size_t k = 0; k < cells.size(); k++) {
+		UnitTest::assertCondition(
+				physicalDesign.getPhysicalCell(cells[k]).getPosition() == original[k] + DBUxy(10, 20),
+				"Committing a fork did not move the cells.");
+		for (Rsyn::Pin pin : cells[k].allPins()) {
+			UnitTest::assertCondition(physicalDesign.getPinPosition(pin) == pinPositions[index] &&
+					physicalDesign.getCachedPinPosition(pin) == pinPositions[index],
+					"Pin positions after the commit differ from the ones seen by the fork.");
+			index++;
+		} // end for
+	} // end for
+
+	// Discarded forks share all data with the design again.
+	for (int i = 1; i < numForks; i++) {
+		forks[i].discard();
+		for (std::size_t k = 0; k < cells.size(); k++) {
+			UnitTest::assertCondition(forks[i].getPosition(cells[k]) == original[k] + DBUxy(10, 20),
+					"A discarded fork does not see the committed moves.");
+		} // end for
+	} // end for
+
+	// Restores the original placement.
+	Rsyn::PlacementFork restore(physicalDesign);
+	for (std::size_t k = 0; k < cells.size(); k++) {
+		restore.placeCell(cells[k], original[k]);
+	} // end for
+	restore.commit();
+} // end method
+
+} // end namespace
@@ -0,0 +1,42 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#ifndef PLACEMENT_FORK_TEST_H
+#define PLACEMENT_FORK_TEST_H
+
+#include "rsyn/engine/Engine.h"
+#include "rsyn/phy/PhysicalDesign.h"
+
+namespace Testing {
+
+//! @brief Checks that placement forks moved in parallel do not touch the
+//!        design until committed and that a commit goes through placeCell().
+//! @note  Creates an unconnected cell, so run it on a scratch design.
+class PlacementForkTest : public Rsyn::Process {
+private:
+	Rsyn::Design design;
+	Rsyn::Module module;
+	Rsyn::PhysicalDesign physicalDesign;
+
+	void test();
+
+public:
+
+	virtual bool run(Rsyn::Engine engine, const Rsyn::Json &params);
+}; // end class
+
+} // end namespace
+
+#endif
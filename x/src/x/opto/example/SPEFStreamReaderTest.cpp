@@ -0,0 +1,140 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "rsyn/io/Writer.h"
+#include "rsyn/io/parser/spef/SPEFStreamReader.h"
+#include "rsyn/model/routing/RoutingEstimator.h"
+#include "rsyn/model/timing/Timer.h"
+#include "x/util/UnitTest.h"
+#include "SPEFStreamReaderTest.h"
+
+namespace Testing {
+
+bool SPEFStreamReaderTest::run(Rsyn::Engine engine, const Rsyn::Json &params) {
+	this->engine = engine;
+	this->design = engine.getDesign();
+	this->module = design.getTopModule();
+
+	try {
+		test();
+	} catch (const UnitTest::Exception &e) {
+		std::cout << "[ERROR] SPEF stream reader test failed: " << e << "\n";
+		return false;
+	} // end catch
+
+	std::cout << "SPEF stream reader test passed.\n";
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SPEFStreamReaderTest::test() {
+	Rsyn::RoutingEstimator *routingEstimator = engine.getService("rsyn.routingEstimator");
+	Rsyn::Timer *timer = engine.getService("rsyn.timer");
+	Rsyn::Writer *writer = engine.getService("rsyn.writer");
+	routingEstimator->updateRouting();
+
+	// Parasitics of the nets written to the SPEF file. Nets without resistors
+	// (e.g. the clock net) are read back as a wire load.
+	struct Parasitics {
+		Rsyn::Net net;
+		bool hasResistors;
+		int numNodes;
+		Number wireCap;
+		Number resistance;
+	}; // end struct
+
+	std::vector<Parasitics> expected;
+	for (Rsyn::Net net : module.allNets()) {
+		if (net.getNumPins() < 2)
+			continue;
+
+		const Rsyn::RCTree &tree = routingEstimator->getRCTree(net);
+		Parasitics parasitics;
+		parasitics.net = net;
+		parasitics.hasResistors = tree.getNumNodes() > 1 && net != timer->getClockNet();
+		parasitics.numNodes = tree.getNumNodes();
+		parasitics.wireCap = tree.getTotalWireCap();
+		parasitics.resistance = 0;
+		for (int i = 1; i < tree.getNumNodes(); i++) {
+			parasitics.resistance += tree.getNode(i).propDrivingResistance;
+		} // end for
+		expected.push_back(parasitics);
+	} // end for
+	UnitTest::assertCondition(!expected.empty(), "The design has no nets to write.");
+
+	const std::string filename = design.getName() + "-spef-stream-reader-test.spef";
+	{
+		std::ofstream out(filename);
+		writer->writeSPEFFile(out);
+		UnitTest::assertCondition((bool) out, "Could not write the SPEF file.");
+	} // end block
+
+	Rsyn::SPEFStreamReader reader(design, routingEstimator);
+	const bool read = reader.read(filename);
+	std::remove(filename.c_str());
+	UnitTest::assertCondition(read, "Could not read the SPEF file.");
+	UnitTest::assertCondition(reader.getNumSkippedNets() == 0,
+			"Some nets written to the SPEF file were skipped.");
+	UnitTest::assertCondition(reader.getNumAnnotatedNets() == (int) expected.size(),
+			"Not all nets written to the SPEF file were annotated.");
+
+	// Values are written with the default precision of the stream.
+	const Number precision = 1e-4f;
+	for (const Parasitics &parasitics : expected) {
+		const Rsyn::RCTree &tree = routingEstimator->getRCTree(parasitics.net);
+		const std::string name = parasitics.net.getName();
+		if (!parasitics.hasResistors) {
+			UnitTest::assertCondition(tree.hasUserSpecifiedWireLoad(),
+					"Net " + name + " was not read as a wire load.");
+			UnitTest::assertApproximatelyEqual<Number>(parasitics.wireCap,
+					tree.getUserSpecifiedWireLoad(),
+					"Wire load of net " + name + " differs.", precision);
+			continue;
+		} // end if
+
+		Number resistance = 0;
+		for (int i = 1; i < tree.getNumNodes(); i++) {
+			resistance += tree.getNode(i).propDrivingResistance;
+		} // end for
+
+		UnitTest::assertCondition(tree.hasUserSpecifiedRouting(),
+				"Net " + name + " was not read as user-specified routing.");
+		UnitTest::assertCondition(tree.getNumNodes() == parasitics.numNodes,
+				"Number of RC nodes of net " + name + " differs.");
+		UnitTest::assertApproximatelyEqual<Number>(parasitics.wireCap,
+				tree.getTotalWireCap(),
+				"Wire capacitance of net " + name + " differs.", precision);
+		UnitTest::assertApproximatelyEqual<Number>(parasitics.resistance,
+				resistance, "Resistance of net " + name + " differs.", precision);
+	} // end for
+
+	// Restores the estimated routing.
+	for (Rsyn::Net net : reader.getAnnotatedNets()) {
+		Rsyn::RCTree &tree = routingEstimator->getRCTree(net);
+		if (tree.hasUserSpecifiedWireLoad()) {
+			tree.resetUserSpecifiedWireLoad();
+			routingEstimator->dirtyNet(net);
+		} // end if
+		routingEstimator->clearUserSpecifiedRouting(net);
+	} // end for
+	routingEstimator->updateRouting();
+} // end method
+
+} // end namespace
@@ -0,0 +1,42 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SPEF_STREAM_READER_TEST_H
+#define SPEF_STREAM_READER_TEST_H
+
+#include "rsyn/engine/Engine.h"
+
+namespace Testing {
+
+//! @brief Writes the parasitics of the design to a SPEF file, reads them back
+//!        with the SPEF stream reader and checks that the RC trees match.
+//! @note  Requires the timer and the routing estimator. The estimated routing
+//!        is restored at the end.
+class SPEFStreamReaderTest : public Rsyn::Process {
+private:
+	Rsyn::Engine engine;
+	Rsyn::Design design;
+	Rsyn::Module module;
+
+	void test();
+
+public:
+
+	virtual bool run(Rsyn::Engine engine, const Rsyn::Json &params);
+}; // end class
+
+} // end namespace
+
+#endif
@@ -0,0 +1,150 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#include <utility>
+#include <vector>
+
+#include "rsyn/sandbox/Sandbox.h"
+#include "rsyn/model/timing/SandboxTimer.h"
+#include "rsyn/model/timing/Timer.h"
+#include "x/util/UnitTest.h"
+#include "SandboxCommitTest.h"
+
+namespace Testing {
+
+bool SandboxCommitTest::run(Rsyn::Engine engine, const Rsyn::Json &params) {
+	this->engine = engine;
+	this->design = engine.getDesign();
+	this->module = design.getTopModule();
+
+	try {
+		test();
+	} catch (const UnitTest::Exception &e) {
+		std::cout << "[ERROR] Sandbox commit test failed: " << e << "\n";
+		return false;
+	} // end catch
+
+	std::cout << "Sandbox commit test passed.\n";
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SandboxCommitTest::test() {
+	Rsyn::Timer *timer = engine.getService("rsyn.timer");
+	timer->updateTimingIncremental();
+
+	// Uses a cell driving and driven by other cells that can be remapped to
+	// another library cell.
+	Rsyn::Cell seed;
+	Rsyn::LibraryCell target;
+	for (Rsyn::Instance instance : module.allInstances()) {
+		if (instance.getType() != Rsyn::CELL || instance.getNumInputPins() == 0 ||
+				instance.getNumOutputPins() == 0)
+			continue;
+
+		for (Rsyn::LibraryCell lcell : design.allLibraryCells()) {
+			if (lcell == instance.asCell().getLibraryCell())
+				continue;
+
+			Rsyn::Sandbox probe;
+			probe.create(instance.asCell());
+			try {
+				probe.remap(probe.getRelated(instance).asCell(), lcell);
+			} catch (const Rsyn::IncompatibleLibraryCellForRemapping &) {
+				continue;
+			} // end catch
+
+			seed = instance.asCell();
+			target = lcell;
+			break;
+		} // end for
+
+		if (seed)
+			break;
+	} // end for
+	UnitTest::assertCondition(seed != nullptr, "The design has no remappable cell.");
+
+	std::vector<std::pair<Rsyn::Pin, Rsyn::Net>> connections;
+	for (Rsyn::Pin pin : seed.allPins()) {
+		connections.push_back(std::make_pair(pin, pin.getNet()));
+	} // end for
+
+	// Evaluates the remap in a sandbox and commits it.
+	Rsyn::Sandbox sandbox;
+	sandbox.create(seed);
+	Rsyn::SandboxCell sandboxCell = sandbox.getRelated(seed).asCell();
+	sandbox.remap(sandboxCell, target);
+
+	Rsyn::SandboxTimer sandboxTimer;
+	sandboxTimer.init(engine, sandbox);
+	sandboxTimer.updateTimingFull();
+
+	const bool seeded = sandboxTimer.commit();
+
+	UnitTest::assertCondition(seed.getLibraryCell() == target,
+			"The remap was not committed to the design.");
+	for (const std::pair<Rsyn::Pin, Rsyn::Net> &connection : connections) {
+		UnitTest::assertCondition(connection.first.getNet() == connection.second,
+				"The commit changed the connections of the remapped cell.");
+	} // end for
+
+	// When seeded, the design timer starts from the sandbox timing, which
+	// must then be kept by the incremental update.
+	timer->updateTimingIncremental();
+	if (seeded) {
+		for (Rsyn::SandboxPin pin : sandboxCell.allPins()) {
+			for (const Rsyn::TimingMode mode : {Rsyn::EARLY, Rsyn::LATE}) {
+				for (const Rsyn::TimingTransition edge : {Rsyn::FALL, Rsyn::RISE}) {
+					UnitTest::assertApproximatelyEqual<Number>(
+							timer->getPinArrivalTime(pin.getRelated(), mode, edge),
+							sandboxTimer.getPinArrivalTime(pin, mode, edge),
+							"The design timer differs from the sandbox timing it was seeded with.",
+							1e-3f);
+				} // end for
+			} // end for
+		} // end for
+	} // end if
+
+	// Either way, the incremental update must match a full update.
+	std::vector<Number> arrivals;
+	for (Rsyn::Instance instance : module.allInstances()) {
+		for (Rsyn::Pin pin : instance.allPins()) {
+			for (const Rsyn::TimingMode mode : {Rsyn::EARLY, Rsyn::LATE}) {
+				for (const Rsyn::TimingTransition edge : {Rsyn::FALL, Rsyn::RISE}) {
+					arrivals.push_back(timer->getPinArrivalTime(pin, mode, edge));
+				} // end for
+			} // end for
+		} // end for
+	} // end for
+
+	timer->updateTimingFull();
+
+	std::size_t index = 0;
+	for (Rsyn::Instance instance : module.allInstances()) {
+		for (Rsyn::Pin pin : instance.allPins()) {
+			for (const Rsyn::TimingMode mode : {Rsyn::EARLY, Rsyn::LATE}) {
+				for (const Rsyn::TimingTransition edge : {Rsyn::FALL, Rsyn::RISE}) {
+					UnitTest::assertApproximatelyEqual<Number>(arrivals[index++],
+							timer->getPinArrivalTime(pin, mode, edge),
+							"The timing after the commit differs from a full update at pin " +
+							pin.getFullName() + ".", 1e-3f);
+				} // end for
+			} // end for
+		} // end for
+	} // end for
+} // end method
+
+} // end namespace
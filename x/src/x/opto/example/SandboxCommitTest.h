@@ -0,0 +1,42 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SANDBOX_COMMIT_TEST_H
+#define SANDBOX_COMMIT_TEST_H
+
+#include "rsyn/engine/Engine.h"
+
+namespace Testing {
+
+//! @brief Remaps a cell in a sandbox and commits it with the sandbox timer.
+//!        Checks that the design gets the change and that the design timing
+//!        after the commit matches a full timing update.
+//! @note  Requires the timer. The design is changed.
+class SandboxCommitTest : public Rsyn::Process {
+private:
+	Rsyn::Engine engine;
+	Rsyn::Design design;
+	Rsyn::Module module;
+
+	void test();
+
+public:
+
+	virtual bool run(Rsyn::Engine engine, const Rsyn::Json &params);
+}; // end class
+
+} // end namespace
+
+#endif
@@ -0,0 +1,146 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#include <stdexcept>
+
+#include "rsyn/model/timing/SandboxTrials.h"
+#include "x/util/UnitTest.h"
+#include "SandboxTrialsTest.h"
+
+namespace Testing {
+
+bool SandboxTrialsTest::run(Rsyn::Engine engine, const Rsyn::Json &params) {
+	this->engine = engine;
+	this->design = engine.getDesign();
+	this->module = design.getTopModule();
+
+	try {
+		test();
+	} catch (const UnitTest::Exception &e) {
+		std::cout << "[ERROR] Sandbox trials test failed: " << e << "\n";
+		return false;
+	} // end catch
+
+	std::cout << "Sandbox trials test passed.\n";
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SandboxTrialsTest::test() {
+	// Uses a cell driving and driven by other cells, so the trials see some
+	// timing around the seed.
+	Rsyn::Cell seed;
+	for (Rsyn::Instance instance : module.allInstances()) {
+		if (instance.getType() == Rsyn::CELL && instance.getNumInputPins() > 0 &&
+				instance.getNumOutputPins() > 0) {
+			seed = instance.asCell();
+			break;
+		} // end if
+	} // end for
+	UnitTest::assertCondition(seed != nullptr, "The design has no suitable cell.");
+
+	// Incompatible candidates are expected to be rejected.
+	const Rsyn::LibraryCell original = seed.getLibraryCell();
+	std::vector<Rsyn::LibraryCell> candidates;
+	for (Rsyn::LibraryCell lcell : design.allLibraryCells()) {
+		candidates.push_back(lcell);
+	} // end for
+
+	// Reference: each remap evaluated alone in its own sandbox and timer.
+	std::vector<Rsyn::SandboxTrials::Result> expected(candidates.size());
+	int numCompatible = 0;
+	for (std::size_t i = 0; i < candidates.size(); i++) {
+		Rsyn::Sandbox sandbox;
+		sandbox.create(seed);
+		try {
+			sandbox.remap(sandbox.getRelated(seed).asCell(), candidates[i]);
+		} catch (const Rsyn::IncompatibleLibraryCellForRemapping &) {
+			continue;
+		} // end catch
+
+		Rsyn::SandboxTimer timer;
+		timer.setSkipBeforeTimingUpdate(true);
+		timer.init(engine, sandbox);
+		timer.updateTimingFull();
+
+		Rsyn::SandboxTrials::Result &result = expected[i];
+		result.valid = true;
+		for (const Rsyn::TimingMode mode : {Rsyn::EARLY, Rsyn::LATE}) {
+			result.wns[mode] = timer.getWns(mode);
+			result.tns[mode] = timer.getTns(mode);
+			result.maxArrivalTime[mode] = timer.getMaxArrivalTime(mode);
+		} // end for
+		numCompatible++;
+	} // end for
+	UnitTest::assertCondition(numCompatible > 0,
+			"No library cell is compatible with the seed.");
+
+	// The second round reuses the sandboxes and timers of the first one.
+	Rsyn::SandboxTrials trials(engine);
+	for (int round = 0; round < 2; round++) {
+		const std::vector<Rsyn::SandboxTrials::Result> results =
+				trials.runRemaps(seed, candidates);
+		UnitTest::assertCondition(results.size() == candidates.size(),
+				"Some remap trials were not run.");
+
+		for (std::size_t i = 0; i < candidates.size(); i++) {
+			UnitTest::assertCondition(results[i].valid == expected[i].valid,
+					"A parallel remap trial was not validated as a sequential one.");
+			if (!results[i].valid)
+				continue;
+			for (const Rsyn::TimingMode mode : {Rsyn::EARLY, Rsyn::LATE}) {
+				UnitTest::assertCondition(
+						results[i].wns[mode] == expected[i].wns[mode] &&
+						results[i].tns[mode] == expected[i].tns[mode] &&
+						results[i].maxArrivalTime[mode] == expected[i].maxArrivalTime[mode],
+						"A parallel remap trial differs from the sequential one.");
+			} // end for
+		} // end for
+	} // end for
+
+	// Trials that throw or return false are rejected. The others are timed as
+	// the unchanged neighborhood.
+	Rsyn::SandboxTrials::Result unchanged;
+	for (std::size_t i = 0; i < candidates.size(); i++) {
+		if (candidates[i] == original)
+			unchanged = expected[i];
+	} // end for
+
+	const int numTrials = 4 * ((int) getSharedThreadPool().getNumThreads() + 1);
+	const std::vector<Rsyn::SandboxTrials::Result> results =
+			trials.run(seed, numTrials, [](Rsyn::Sandbox sandbox, const int i) {
+		if (i % 3 == 1)
+			throw std::runtime_error("trial failed");
+		return i % 3 != 2;
+	});
+	for (int i = 0; i < numTrials; i++) {
+		UnitTest::assertCondition(results[i].valid == (i % 3 == 0),
+				"A failing trial was accepted or rejected other trials.");
+		if (!results[i].valid)
+			continue;
+		for (const Rsyn::TimingMode mode : {Rsyn::EARLY, Rsyn::LATE}) {
+			UnitTest::assertCondition(
+					results[i].wns[mode] == unchanged.wns[mode] &&
+					results[i].tns[mode] == unchanged.tns[mode],
+					"A trial was affected by a failing trial.");
+		} // end for
+	} // end for
+
+	UnitTest::assertCondition(seed.getLibraryCell() == original,
+			"Trials changed the design.");
+} // end method
+
+} // end namespace
@@ -0,0 +1,42 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SANDBOX_TRIALS_TEST_H
+#define SANDBOX_TRIALS_TEST_H
+
+#include "rsyn/engine/Engine.h"
+
+namespace Testing {
+
+//! @brief Checks that trials run in parallel give the same timing as the same
+//!        changes evaluated one at a time and that a failing trial only
+//!        rejects itself.
+//! @note  Requires the timer. The design is not changed.
+class SandboxTrialsTest : public Rsyn::Process {
+private:
+	Rsyn::Engine engine;
+	Rsyn::Design design;
+	Rsyn::Module module;
+
+	void test();
+
+public:
+
+	virtual bool run(Rsyn::Engine engine, const Rsyn::Json &params);
+}; // end class
+
+} // end namespace
+
+#endif
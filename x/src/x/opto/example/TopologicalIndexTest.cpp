@@ -0,0 +1,135 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#include <vector>
+#include <algorithm>
+
+#include "x/util/UnitTest.h"
+#include "TopologicalIndexTest.h"
+
+namespace Testing {
+
+bool TopologicalIndexTest::run(Rsyn::Engine engine, const Rsyn::Json &params) {
+	try {
+		test();
+	} catch (const UnitTest::Exception &e) {
+		std::cout << "[ERROR] Topological index test failed: " << e << "\n";
+		return false;
+	} // end catch
+
+	std::cout << "Topological index test passed.\n";
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void TopologicalIndexTest::test() {
+	Rsyn::Design design;
+	design.create("loops");
+
+	Rsyn::CellDescriptor inv;
+	inv.setName("INV");
+	inv.addPin("a", Rsyn::IN);
+	inv.addPin("o", Rsyn::OUT);
+	inv.addArc("a", "o");
+	design.createLibraryCell(inv);
+
+	Rsyn::CellDescriptor nand;
+	nand.setName("NAND2");
+	nand.addPin("a", Rsyn::IN);
+	nand.addPin("b", Rsyn::IN);
+	nand.addPin("o", Rsyn::OUT);
+	nand.addArc("a", "o");
+	nand.addArc("b", "o");
+	design.createLibraryCell(nand);
+
+	Rsyn::Module top = design.getTopModule();
+	design.beginBulkLoad();
+
+	// The cells of the second loop are created first, so its pins come first
+	// in the pin list and used to be the first ones forced to break a loop,
+	// before their predecessors after the first loop were visited.
+	Rsyn::Cell x = top.createCell("NAND2", "x");
+	Rsyn::Cell y = top.createCell("INV", "y");
+	Rsyn::Cell p = top.createCell("NAND2", "p");
+	Rsyn::Cell q = top.createCell("INV", "q");
+	Rsyn::Cell r = top.createCell("INV", "r");
+	Rsyn::Cell s = top.createCell("INV", "s");
+	Rsyn::Cell w = top.createCell("INV", "w");
+
+	auto connect = [&](const std::string &name, Rsyn::Pin driver,
+			const std::vector<Rsyn::Pin> &sinks) {
+		Rsyn::Net net = top.createNet(name);
+		driver.connect(net);
+		for (Rsyn::Pin sink : sinks) {
+			sink.connect(net);
+		} // end for
+	};
+
+	// s -> first loop (p, q) -> r -> second loop (x, y) -> w
+	connect("ns", s.getPinByName("o"), {p.getPinByName("b")});
+	connect("np", p.getPinByName("o"), {q.getPinByName("a")});
+	connect("nq", q.getPinByName("o"), {p.getPinByName("a"), r.getPinByName("a")});
+	connect("nr", r.getPinByName("o"), {x.getPinByName("b")});
+	connect("nx", x.getPinByName("o"), {y.getPinByName("a"), w.getPinByName("a")});
+	connect("ny", y.getPinByName("o"), {x.getPinByName("a")});
+
+	design.endBulkLoad();
+
+	std::vector<Rsyn::Pin> pins;
+	for (Rsyn::Instance instance : top.allInstances()) {
+		for (Rsyn::Pin pin : instance.allPins()) {
+			pins.push_back(pin);
+		} // end for
+	} // end for
+
+	// Pins reachable from each pin.
+	const int numPins = (int) pins.size();
+	std::vector<std::vector<char>> reachable(numPins, std::vector<char>(numPins, false));
+	for (int i = 0; i < numPins; i++) {
+		std::vector<Rsyn::Pin> open = {pins[i]};
+		while (!open.empty()) {
+			Rsyn::Pin pin = open.back();
+			open.pop_back();
+			for (Rsyn::Pin successor : pin.allSucessorPins(true)) {
+				const int k = (int) (std::find(pins.begin(), pins.end(), successor) - pins.begin());
+				if (!reachable[i][k]) {
+					reachable[i][k] = true;
+					open.push_back(successor);
+				} // end if
+			} // end for
+		} // end while
+	} // end for
+
+	int numLoopArcs = 0;
+	for (int i = 0; i < numPins; i++) {
+		for (Rsyn::Pin successor : pins[i].allSucessorPins(true)) {
+			const int k = (int) (std::find(pins.begin(), pins.end(), successor) - pins.begin());
+			if (reachable[k][i]) {
+				numLoopArcs++;
+				continue;
+			} // end if
+
+			UnitTest::assertCondition(successor.getTopologicalIndex() >
+					pins[i].getTopologicalIndex(), "Pin " + successor.getFullName() +
+					" has a topological index not larger than its predecessor " +
+					pins[i].getFullName() + ".");
+		} // end for
+	} // end for
+
+	UnitTest::assertCondition(numLoopArcs == 8, "The loops were not built as expected.");
+} // end method
+
+} // end namespace
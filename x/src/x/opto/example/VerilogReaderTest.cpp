@@ -0,0 +1,242 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <unistd.h>
+
+#include "rsyn/io/parser/verilog/SimplifiedVerilogReader.h"
+#include "rsyn/io/parser/verilog/MappedVerilogReader.h"
+#include "x/util/UnitTest.h"
+#include "VerilogReaderTest.h"
+
+namespace Testing {
+
+bool VerilogReaderTest::run(Rsyn::Engine engine, const Rsyn::Json &params) {
+	try {
+		test();
+	} catch (const UnitTest::Exception &e) {
+		std::cout << "[ERROR] Verilog reader test failed: " << e << "\n";
+		return false;
+	} // end catch
+
+	std::cout << "Verilog reader test passed.\n";
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void VerilogReaderTest::test() {
+	// Escaped identifiers end at a white space, unconnected ports are
+	// connected to a net named "" and comments may hold semicolons.
+	const std::string netlist =
+			"// Test netlist; not a statement\n"
+			"module top ( a, \\b[0] , z );\n"
+			"  input a, \\b[0] ; /* inputs; */\n"
+			"  output z;\n"
+			"  wire n1, \\n/2 , n3;\n"
+			"  wire n1; // defined twice\n"
+			"  NAND2_X1 \\u1/x ( .a(a), .b(\\b[0] ), .o(n1) );\n"
+			"  INV_X1 u2 ( .a(n1), .o(\\n/2 ) ); // u2; u3\n"
+			"  NAND3_X1 u3 ( .a(\\n/2 ), .b(), .c(undeclared), .o(n3) );\n"
+			"  BUF_X1 u4 ( );\n"
+			"  /* u5 ;\n"
+			"     drives z; */ INV_X1 u5 ( .a(n3), .o(z) );\n"
+			"endmodule\n";
+	testNetlist("small netlist", netlist);
+
+	// Large enough to be split in chunks, which line up with the statements.
+	testNetlist("chunked netlist", generateNetlist(40000, false));
+
+	// The chunks start after semicolons inside comments, so the body is parsed
+	// again as a single chunk.
+	testNetlist("chunked netlist with semicolons in comments",
+			generateNetlist(40000, true));
+
+	// Netlists outside the subset are rejected without changing the
+	// descriptor. They are not given to the flex/bison reader, which stops the
+	// program on them.
+	testUnsupported("ordered port mapping",
+			"module top ( a, z );\n input a;\n output z;\n INV_X1 u1 ( a, z );\nendmodule\n");
+	testUnsupported("constant",
+			"module top ( z );\n output z;\n INV_X1 u1 ( .a(1'b0), .o(z) );\nendmodule\n");
+	testUnsupported("unclosed comment", netlist + "/* trailing; comment");
+
+	// Files read into a non-empty descriptor are parsed by the flex/bison
+	// reader.
+	testFallback("netlist read into a non-empty descriptor", netlist);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void VerilogReaderTest::testNetlist(const std::string &name, const std::string &netlist) {
+	Legacy::Design mapped;
+	Parsing::MappedVerilogReader mappedReader(mapped);
+	UnitTest::assertCondition(
+			mappedReader.parse(netlist.data(), netlist.data() + netlist.size()),
+			"The mapped reader rejected the " + name + ".");
+
+	Legacy::Design flex;
+	Parsing::SimplifiedVerilogReader flexReader(flex);
+	flexReader.parseFromString(netlist);
+
+	assertEqual(name, mapped, flex);
+
+	// Reading from a file goes through the mapped reader.
+	Legacy::Design file;
+	parseFromFile(netlist, file);
+	assertEqual(name + " read from a file", file, flex);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void VerilogReaderTest::testUnsupported(const std::string &name, const std::string &netlist) {
+	Legacy::Design mapped;
+	Parsing::MappedVerilogReader mappedReader(mapped);
+	UnitTest::assertCondition(
+			!mappedReader.parse(netlist.data(), netlist.data() + netlist.size()),
+			"The mapped reader accepted the " + name + ".");
+	UnitTest::assertCondition(mapped.name.empty() && mapped.components.empty() &&
+			mapped.nets.empty() && mapped.ports.empty() &&
+			mapped.primaryInputs.empty() && mapped.primaryOutputs.empty(),
+			"The mapped reader changed the descriptor when rejecting the " + name + ".");
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void VerilogReaderTest::testFallback(const std::string &name, const std::string &netlist) {
+	Legacy::Design::Component component;
+	component.id = "INV_X1";
+	component.name = "existing";
+	component.fixed = true;
+	component.placed = false;
+	component.x = component.y = -1;
+
+	Legacy::Design flex;
+	flex.components.push_back(component);
+	Parsing::SimplifiedVerilogReader flexReader(flex);
+	flexReader.parseFromString(netlist);
+
+	Legacy::Design file;
+	file.components.push_back(component);
+	parseFromFile(netlist, file);
+
+	assertEqual(name, file, flex);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void VerilogReaderTest::parseFromFile(const std::string &netlist, Legacy::Design &design) {
+	std::string filename = "/tmp/rsyn-verilog-test-XXXXXX";
+	const int fd = mkstemp(&filename[0]);
+	UnitTest::assertCondition(fd != -1, "Failed to create a temporary file.");
+	const bool written =
+			::write(fd, netlist.data(), netlist.size()) == (ssize_t) netlist.size();
+	::close(fd);
+
+	if (written) {
+		Parsing::SimplifiedVerilogReader reader(design);
+		reader.parseFromFile(filename);
+	} // end if
+	std::remove(filename.c_str());
+	UnitTest::assertCondition(written, "Failed to write a temporary file.");
+} // end method
+
+// -----------------------------------------------------------------------------
+
+std::string VerilogReaderTest::generateNetlist(const int numCells,
+		const bool semicolonsInComments) {
+	std::ostringstream out;
+
+	out << "module top ( a, \\b[0] , z );\n";
+	out << "input a, \\b[0] ;\n";
+	out << "output z;\n";
+	for (int i = 0; i < numCells; i++) {
+		out << "wire n" << i << "; // net " << i << "\n";
+	} // end for
+
+	for (int i = 0; i < numCells; i++) {
+		// Comments filled with semicolons take the middle of the body, so
+		// there are chunk splits inside them.
+		if (semicolonsInComments && i == numCells / 2) {
+			const std::string semicolons(100, ';');
+			for (int k = 0; k < numCells / 2; k++) {
+				out << "// " << semicolons << "\n";
+			} // end for
+		} // end if
+
+		const std::string driver = i > 0? "n" + std::to_string(i - 1) : "a";
+		if (i % 11 == 0) {
+			out << "NAND2_X1 \\u" << i << "/x ( .a(" << driver << "), .b(\\b[0] ), "
+					<< ".o(n" << i << ") );\n";
+		} else if (i % 7 == 0) {
+			out << "NAND3_X1 u" << i << " ( .a(" << driver << "), .b(), "
+					<< ".c(\\b[0] ), .o(n" << i << ") );\n";
+		} else {
+			out << "INV_X1 u" << i << " ( .a(" << driver << "), "
+					<< ".o(n" << i << ") ); /* cell " << i << " */\n";
+		} // end else
+	} // end for
+
+	out << "BUF_X1 uz ( .a(n" << (numCells - 1) << "), .o(z) );\n";
+	out << "endmodule\n";
+	return out.str();
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void VerilogReaderTest::assertEqual(const std::string &name,
+		const Legacy::Design &mapped, const Legacy::Design &flex) {
+	const std::string error = "The readers differ for the " + name + ": ";
+
+	UnitTest::assertCondition(mapped.name == flex.name, error + "module name.");
+	UnitTest::assertCondition(mapped.primaryInputs == flex.primaryInputs &&
+			mapped.primaryOutputs == flex.primaryOutputs, error + "primary inputs/outputs.");
+
+	UnitTest::assertCondition(mapped.ports.size() == flex.ports.size(), error + "number of ports.");
+	for (std::size_t i = 0; i < mapped.ports.size(); i++) {
+		const Legacy::Design::Pin &a = mapped.ports[i];
+		const Legacy::Design::Pin &b = flex.ports[i];
+		UnitTest::assertCondition(a.name == b.name && a.net == b.net &&
+				a.direction == b.direction && a.x == b.x && a.y == b.y,
+				error + "port " + b.name + ".");
+	} // end for
+
+	UnitTest::assertCondition(mapped.components.size() == flex.components.size(),
+			error + "number of components.");
+	for (std::size_t i = 0; i < mapped.components.size(); i++) {
+		const Legacy::Design::Component &a = mapped.components[i];
+		const Legacy::Design::Component &b = flex.components[i];
+		UnitTest::assertCondition(a.id == b.id && a.name == b.name &&
+				a.fixed == b.fixed && a.placed == b.placed && a.x == b.x && a.y == b.y,
+				error + "component " + b.name + ".");
+	} // end for
+
+	UnitTest::assertCondition(mapped.nets.size() == flex.nets.size(), error + "number of nets.");
+	for (std::size_t i = 0; i < mapped.nets.size(); i++) {
+		const Legacy::Design::Net &a = mapped.nets[i];
+		const Legacy::Design::Net &b = flex.nets[i];
+		UnitTest::assertCondition(a.name == b.name &&
+				a.connections.size() == b.connections.size(), error + "net " + b.name + ".");
+		for (std::size_t k = 0; k < a.connections.size(); k++) {
+			UnitTest::assertCondition(a.connections[k].pin == b.connections[k].pin &&
+					a.connections[k].instance == b.connections[k].instance,
+					error + "connections of net " + b.name + ".");
+		} // end for
+	} // end for
+} // end method
+
+} // end namespace
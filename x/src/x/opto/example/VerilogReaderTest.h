@@ -0,0 +1,60 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VERILOG_READER_TEST_H
+#define VERILOG_READER_TEST_H
+
+#include <string>
+
+#include "rsyn/engine/Engine.h"
+#include "rsyn/io/legacy/PlacerInternals.h"
+
+namespace Testing {
+
+//! @brief Checks that the mapped Verilog reader builds the same descriptor as
+//!        the flex/bison reader, including when the body is split in chunks,
+//!        and that netlists it does not handle are left to the flex/bison
+//!        reader.
+//! @note  Does not use the design.
+class VerilogReaderTest : public Rsyn::Process {
+private:
+
+	void test();
+
+	//! @brief Parses the netlist with both readers and compares the results.
+	void testNetlist(const std::string &name, const std::string &netlist);
+
+	//! @brief Checks that the mapped reader rejects the netlist.
+	void testUnsupported(const std::string &name, const std::string &netlist);
+
+	//! @brief Reads the netlist from a file into a non-empty descriptor.
+	void testFallback(const std::string &name, const std::string &netlist);
+
+	static void parseFromFile(const std::string &netlist, Legacy::Design &design);
+
+	static std::string generateNetlist(const int numCells,
+			const bool semicolonsInComments);
+
+	static void assertEqual(const std::string &name,
+			const Legacy::Design &mapped, const Legacy::Design &flex);
+
+public:
+
+	virtual bool run(Rsyn::Engine engine, const Rsyn::Json &params);
+}; // end class
+
+} // end namespace
+
+#endif
@@ -35,6 +35,15 @@
 #include "x/opto/example/LemonLP.h"
 #include "x/opto/ufrgs/qpdp/OverlapRemover.h"
 #include "x/opto/example/SandboxTest.h"
+#include "x/opto/example/PlacementForkTest.h"
+#include "x/opto/example/ParallelTest.h"
+#include "x/opto/example/SandboxTrialsTest.h"
+#include "x/opto/example/VerilogReaderTest.h"
+#include "x/opto/example/TopologicalIndexTest.h"
+#include "x/opto/example/SandboxCommitTest.h"
+#include "x/opto/example/SPEFStreamReaderTest.h"
+#include "x/opto/example/DEFWriterTest.h"
+#include "x/opto/example/PlacementDeltaTest.h"
 
 // Registration
 namespace Rsyn {
@@ -62,6 +71,15 @@ void Engine::registerProcesses() {
 
 	// Testing
 	registerProcess<Testing::SandboxTest>("testing.sandbox");
+	registerProcess<Testing::PlacementForkTest>("testing.placementFork");
+	registerProcess<Testing::ParallelTest>("testing.parallel");
+	registerProcess<Testing::SandboxTrialsTest>("testing.sandboxTrials");
+	registerProcess<Testing::VerilogReaderTest>("testing.verilogReader");
+	registerProcess<Testing::TopologicalIndexTest>("testing.topologicalIndex");
+	registerProcess<Testing::SandboxCommitTest>("testing.sandboxCommit");
+	registerProcess<Testing::SPEFStreamReaderTest>("testing.spefStreamReader");
+	registerProcess<Testing::DEFWriterTest>("testing.defWriter");
+	registerProcess<Testing::PlacementDeltaTest>("testing.placementDelta");
 } // end method
 } // end namespace
 
@@ -29,6 +29,7 @@
 #include "rsyn/io/reader/ISPD2012Reader.h"
 #include "rsyn/io/reader/ISPD2014Reader.h"
 #include "rsyn/io/reader/GenericReader.h"
+#include "rsyn/io/reader/SnapshotReader.h"
 
 #include "x/io/reader/ICCAD15Reader.h"
 
@@ -45,6 +46,7 @@ void Engine::registerReaders() {
 	registerReader<Rsyn::DesignPositionReader>("loadDesignPosition");
 
 	registerReader<Rsyn::GenericReader>("generic");
+	registerReader<Rsyn::SnapshotReader>("rsyn.snapshot");
 	registerReader<ICCAD15::ICCAD15Reader>("iccad2015");
 } // end method 
 } // end namespace 
\ No newline at end of file
@@ -20,6 +20,7 @@
 
 // Services
 #include "rsyn/phy/PhysicalService.h"
+#include "rsyn/phy/SpatialIndexService.h"
 #include "rsyn/model/scenario/Scenario.h"
 #include "rsyn/model/timing/Timer.h"
 #include "rsyn/model/timing/DefaultTimingModel.h"
@@ -41,6 +42,7 @@
 namespace Rsyn {
 void Engine::registerServices() {
 	registerService<Rsyn::PhysicalService>("rsyn.physical");
+	registerService<Rsyn::SpatialIndexService>("rsyn.spatialIndex");
 	registerService<Rsyn::Scenario>("rsyn.scenario");
 	registerService<Rsyn::Timer>("rsyn.timer");
 	registerService<Rsyn::DefaultTimingModel>("rsyn.defaultTimingModel");